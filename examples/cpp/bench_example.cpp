@@ -0,0 +1,144 @@
+#include "replicant.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// End-to-end benchmark of the C++ SDK: drives create/update/get/search
+// through replicant.hpp and prints one JSON line per operation so the
+// timings can be collected by scripts or CI.
+//
+// Usage: bench_example [iterations]
+//
+// Server URL, credentials and database path come from the environment
+// (REPLICANT_DB, REPLICANT_SERVER, REPLICANT_EMAIL, REPLICANT_API_KEY,
+// REPLICANT_API_SECRET) and fall back to the local test defaults. The
+// client is offline-first, so the benchmark still runs without a server;
+// in that case the numbers cover the local SQLite path only.
+
+namespace
+{
+
+std::string env_or(const char* name, const char* fallback)
+{
+    const char* value = std::getenv(name);
+    return value ? value : fallback;
+}
+
+// Runs `op` `iterations` times and prints a JSON line with total, mean,
+// p50 and p99 wall-clock nanoseconds
+template <typename Op>
+void bench(const std::string& name, int iterations, Op&& op)
+{
+    std::vector<long long> samples;
+    samples.reserve(iterations);
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        op(i);
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    long long total = 0;
+    for (long long sample : samples)
+    {
+        total += sample;
+    }
+    std::sort(samples.begin(), samples.end());
+    long long p50 = samples[samples.size() / 2];
+    long long p99 = samples[(samples.size() * 99) / 100];
+
+    std::cout << R"({"op":")" << name << R"(","iterations":)" << iterations
+              << R"(,"total_ns":)" << total
+              << R"(,"mean_ns":)" << total / iterations
+              << R"(,"p50_ns":)" << p50
+              << R"(,"p99_ns":)" << p99 << "}" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int iterations = 100;
+    if (argc > 1)
+    {
+        iterations = std::atoi(argv[1]);
+        if (iterations <= 0)
+        {
+            std::cerr << "Usage: " << argv[0] << " [iterations]" << std::endl;
+            return 1;
+        }
+    }
+
+    try
+    {
+        replicant::Client client(
+            env_or("REPLICANT_DB", "sqlite:bench_client.db?mode=rwc"),
+            env_or("REPLICANT_SERVER", "ws://localhost:8080/ws"),
+            env_or("REPLICANT_EMAIL", "test-user@example.com"),
+            env_or("REPLICANT_API_KEY", "rpa_test_api_key_example_12345"),
+            env_or("REPLICANT_API_SECRET", "rps_test_api_secret_example_67890")
+        );
+
+        std::cerr << "Replicant client version: " << replicant::Client::get_version()
+                  << ", connected: " << (client.is_connected() ? "yes" : "no") << std::endl;
+
+        // Index the fields the search benchmark will query
+        client.configure_search(R"(["/title","/content"])");
+
+        std::vector<std::string> doc_ids;
+        doc_ids.reserve(iterations);
+
+        bench("create_document", iterations, [&](int i)
+        {
+            doc_ids.push_back(client.create_document(
+                R"({"title":"Bench document )" + std::to_string(i) +
+                R"(","content":"searchable payload number )" + std::to_string(i) +
+                R"(","type":"note"})"
+            ));
+        });
+
+        bench("update_document", iterations, [&](int i)
+        {
+            client.update_document(
+                doc_ids[i],
+                R"({"title":"Bench document )" + std::to_string(i) +
+                R"(","content":"updated payload number )" + std::to_string(i) +
+                R"(","type":"note"})"
+            );
+        });
+
+        bench("get_document", iterations, [&](int i)
+        {
+            client.get_document(doc_ids[i]);
+        });
+
+        bench("search_documents", iterations, [&](int i)
+        {
+            client.search_documents("payload number " + std::to_string(i), 10);
+        });
+
+        // Leave the database as we found it
+        for (const std::string& id : doc_ids)
+        {
+            client.delete_document(id);
+        }
+    }
+    catch (const replicant::SyncException& e)
+    {
+        std::cerr << "Sync error: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -76,11 +76,86 @@ typedef enum ReplicantSyncResult {
   ErrorUnknown = -99,
 } ReplicantSyncResult;
 
+/**
+ * SQLite journal mode selector for `ClientOptions`
+ */
+typedef enum ReplicantJournalMode {
+  /**
+   * Keep the library default (WAL)
+   */
+  JournalModeDefault = 0,
+  JournalModeWal = 1,
+  JournalModeDelete = 2,
+  JournalModeTruncate = 3,
+  JournalModePersist = 4,
+  JournalModeMemory = 5,
+} ReplicantJournalMode;
+
+/**
+ * SQLite synchronous level selector for `ClientOptions`
+ */
+typedef enum ReplicantSynchronousMode {
+  /**
+   * Keep the library default (FULL)
+   */
+  SynchronousDefault = 0,
+  SynchronousOff = 1,
+  SynchronousNormal = 2,
+  SynchronousFull = 3,
+  SynchronousExtra = 4,
+} ReplicantSynchronousMode;
+
+/**
+ * Opaque handle to an incremental document cursor
+ *
+ * Pages documents out of SQLite in fixed-size batches so callers can
+ * iterate large document sets without materializing them in one string.
+ */
+typedef struct DocumentCursor DocumentCursor;
+
 /**
  * Opaque handle to a Replicant client instance
  */
 typedef struct Replicant Replicant;
 
+/**
+ * SQLite performance profile for `replicant_create_with_options`
+ *
+ * Zero values keep the library default for that field, so a
+ * zero-initialized struct behaves exactly like `replicant_create`.
+ * Hosts on slow storage typically set `SynchronousNormal` together
+ * with a larger cache and mmap window.
+ */
+typedef struct ReplicantClientOptions {
+  enum ReplicantJournalMode journal_mode;
+  enum ReplicantSynchronousMode synchronous;
+  /**
+   * Database page size in bytes (power of two, 512..65536); only
+   * takes effect on a fresh database file
+   */
+  uint32_t page_size_bytes;
+  /**
+   * Page-cache budget in KiB
+   */
+  int64_t cache_size_kib;
+  /**
+   * Memory-mapped I/O window in bytes
+   */
+  int64_t mmap_size_bytes;
+  /**
+   * Busy handler timeout in milliseconds
+   */
+  uint32_t busy_timeout_ms;
+  /**
+   * SQLite connection pool size
+   */
+  uint32_t pool_size;
+  /**
+   * Per-connection prepared-statement cache entries
+   */
+  uint32_t statement_cache_capacity;
+} ReplicantClientOptions;
+
 /**
  * Document event callback for DocumentCreated, DocumentUpdated, DocumentDeleted
  *
@@ -151,6 +226,89 @@ typedef void (*ConflictEventCallback)(enum ReplicantEventType event_type,
                                       const char *losing_content,
                                       void *context);
 
+/**
+ * Completion callback for asynchronous operations (replicant_*_async)
+ *
+ * Invoked from `process_events()` on the callback thread once a queued
+ * operation has finished, so the calling thread never waits on I/O.
+ *
+ * # Parameters
+ * * `operation_id` - Identifier returned when the operation was enqueued
+ * * `result_code` - ReplicantSyncResult value (0 on success, negative on failure)
+ * * `document_id` - UUID of the affected document (may be null)
+ * * `error` - Error message (null on success)
+ * * `context` - User-defined context pointer
+ */
+typedef void (*OperationCompleteCallback)(uint64_t operation_id,
+                                          int32_t result_code,
+                                          const char *document_id,
+                                          const char *error,
+                                          void *context);
+
+/**
+ * A single event record within a batched drain
+ *
+ * String fields point into an arena owned by the dispatcher for the
+ * duration of the callback; they are null when not applicable to the
+ * event type and must be copied if they need to outlive the callback.
+ */
+typedef struct BatchedEvent {
+  /**
+   * The event type (determines which fields below are meaningful)
+   */
+  enum ReplicantEventType event_type;
+  /**
+   * Document UUID (document and conflict events, null otherwise)
+   */
+  const char *document_id;
+  /**
+   * Document title or server URL (connection events), null otherwise
+   */
+  const char *title;
+  /**
+   * Document JSON content / winning conflict content, null otherwise
+   */
+  const char *content;
+  /**
+   * Error message / losing conflict content, null otherwise
+   */
+  const char *error;
+  /**
+   * Document count (sync events) or attempt number (connection events)
+   */
+  uint64_t numeric_data;
+  /**
+   * Connected flag for connection events
+   */
+  bool boolean_data;
+} BatchedEvent;
+
+/**
+ * Batch event callback receiving all drained events in one call
+ *
+ * # Parameters
+ * * `events` - Array of event records (valid only for the duration of the call)
+ * * `count` - Number of records in the array
+ * * `context` - User-defined context pointer
+ */
+typedef void (*EventBatchCallback)(const struct BatchedEvent *events,
+                                   uintptr_t count,
+                                   void *context);
+
+/**
+ * Notifier fired when the event queue transitions from empty to non-empty
+ *
+ * Unlike every other callback, this is invoked from whichever thread
+ * queued the event (typically a sync task), NOT the callback thread. It
+ * must only schedule a wake-up of the drain thread - e.g. trigger a
+ * message-loop update that calls `process_events()` - never drain events
+ * or touch the engine itself.
+ *
+ * # Parameters
+ * * `context` - User-defined context pointer
+ */
+typedef void (*EventNotifierCallback)(void *context);
+
 /**
  * Document structure for C API
  */
@@ -161,6 +319,45 @@ typedef struct Document {
   int64_t sync_revision;
 } Document;
 
+/**
+ * Summary of one operation's wall-clock timings, in microseconds
+ * (see `replicant_get_metrics_struct`)
+ */
+typedef struct ReplicantMetricsTiming {
+  uint64_t count;
+  uint64_t total_us;
+  uint64_t mean_us;
+  /**
+   * 0 until the first sample is recorded
+   */
+  uint64_t min_us;
+  uint64_t max_us;
+  uint64_t last_us;
+} ReplicantMetricsTiming;
+
+/**
+ * Point-in-time metrics snapshot for C callers
+ * (see `replicant_get_metrics_struct`)
+ */
+typedef struct ReplicantClientMetrics {
+  /**
+   * Upload send to server confirmation, per document
+   */
+  struct ReplicantMetricsTiming sync_upload_latency;
+  /**
+   * Heartbeat ping to matching pong
+   */
+  struct ReplicantMetricsTiming ws_rtt;
+  /**
+   * SQLite statement timings
+   */
+  struct ReplicantMetricsTiming db_query;
+  uint64_t uploads_confirmed;
+  uint64_t upload_failures;
+  uint64_t upload_retries;
+  uint64_t event_queue_depth;
+} ReplicantClientMetrics;
+
 #ifdef __cplusplus
 extern "C" {
 #endif // __cplusplus
@@ -187,6 +384,26 @@ struct Replicant *replicant_create(const char *database_url,
                                    const char *api_key,
                                    const char *api_secret);
 
+/**
+ * Create a new sync engine instance with an explicit SQLite profile
+ *
+ * Like `replicant_create` but takes a `ClientOptions` struct selecting
+ * journal mode, synchronous level, page/cache/mmap sizes, busy timeout,
+ * pool size and prepared-statement cache capacity. Zeroed fields keep
+ * the library defaults; a null `options` pointer behaves exactly like
+ * `replicant_create`.
+ *
+ * # Safety
+ * Caller must ensure all string pointers are valid, non-null C strings
+ * and `options` is either null or a valid `ClientOptions` pointer
+ */
+struct Replicant *replicant_create_with_options(const char *database_url,
+                                                const char *server_url,
+                                                const char *email,
+                                                const char *api_key,
+                                                const char *api_secret,
+                                                const struct ReplicantClientOptions *options);
+
 /**
  * Destroy a sync engine instance and free memory
  *
@@ -239,6 +456,62 @@ enum ReplicantSyncResult replicant_create_document_with_id(struct Replicant *eng
                                                            const char *document_id,
                                                            const char *content_json);
 
+/**
+ * Bulk-import documents from an NDJSON file
+ *
+ * Each line is one document: either a bare content object (an id is
+ * generated) or `{"id": "...", "content": {...}}` to preserve ids from
+ * an export. Documents are written in large multi-row transactions,
+ * the FTS index is rebuilt once at the end instead of per document,
+ * and a single SyncCompleted event carries the imported count instead
+ * of one DocumentCreated event per row. Pass `mark_synced = true` for
+ * server-seeded imports that must not upload; otherwise the imported
+ * rows are picked up as creates by the next sync pass.
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `ndjson_path` - Path to an NDJSON file, one document per line
+ * * `mark_synced` - Mark imported rows as already synced
+ * * `out_imported` - Optional output pointer for the imported row count (may be null)
+ *
+ * # Returns
+ * * SyncResult indicating success or failure; unparseable lines are
+ *   skipped, not fatal
+ *
+ * # Safety
+ * Caller must ensure engine is valid and ndjson_path is a valid C string
+ */
+enum ReplicantSyncResult replicant_import_documents(struct Replicant *engine,
+                                                    const char *ndjson_path,
+                                                    bool mark_synced,
+                                                    uint64_t *out_imported);
+
+/**
+ * Bulk-import documents from an NDJSON buffer in memory
+ *
+ * Identical to `replicant_import_documents` but reads from a caller
+ * owned buffer (e.g. a memory-mapped export) instead of a file path.
+ * The buffer only needs to stay alive for the duration of the call.
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `data` - NDJSON bytes, one document per line
+ * * `len` - Length of `data` in bytes
+ * * `mark_synced` - Mark imported rows as already synced
+ * * `out_imported` - Optional output pointer for the imported row count (may be null)
+ *
+ * # Returns
+ * * SyncResult indicating success or failure
+ *
+ * # Safety
+ * Caller must ensure engine is valid and data points to at least len bytes
+ */
+enum ReplicantSyncResult replicant_import_documents_buffer(struct Replicant *engine,
+                                                           const uint8_t *data,
+                                                           uintptr_t len,
+                                                           bool mark_synced,
+                                                           uint64_t *out_imported);
+
 /**
  * Update an existing document
  *
@@ -257,6 +530,59 @@ enum ReplicantSyncResult replicant_update_document(struct Replicant *engine,
                                                    const char *document_id,
                                                    const char *content_json);
 
+/**
+ * Update a document by applying an RFC-6902 patch directly
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `document_id` - Document ID to update
+ * * `patch_json` - RFC-6902 JSON Patch array (e.g. `[{"op":"replace","path":"/title","value":"New"}]`)
+ *
+ * # Returns
+ * * CSyncResult indicating success or failure
+ *
+ * # Note
+ * Prefer this over replicant_update_document when the caller already knows
+ * which fields changed: the patch is applied and queued for sync as-is,
+ * skipping the full-document diff that the content-based update performs.
+ *
+ * # Safety
+ * Caller must ensure engine is valid and both document_id and patch_json are valid C strings
+ */
+enum ReplicantSyncResult replicant_update_document_patch(struct Replicant *engine,
+                                                         const char *document_id,
+                                                         const char *patch_json);
+
+/**
+ * Write a batch of documents in one transaction and one runtime entry
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `operations_json` - JSON array of operations: `[{"id": "<uuid>", "content": {...}}, ...]`
+ *   The `id` field is optional; a new UUID is generated when omitted.
+ * * `out_results` - Output array for per-item result codes (optional, may be null)
+ * * `results_len` - Capacity of `out_results` in elements
+ *
+ * # Returns
+ * * `SyncResult::Success` - Batch transaction committed (individual items may
+ *   still report input errors in `out_results`)
+ * * `SyncResult::ErrorInvalidInput` - Null pointers or `operations_json` is not a JSON array
+ * * `SyncResult::ErrorDatabase` - Batch transaction failed; no documents were written
+ *
+ * # Note
+ * Existing documents are updated (with a patch queued for sync), new ids are
+ * created. All valid items are applied in a single SQLite transaction, which
+ * is significantly faster than per-document calls for bulk imports and edits.
+ *
+ * # Safety
+ * Caller must ensure engine is valid, operations_json is a valid C string, and
+ * out_results (if not null) has space for results_len elements
+ */
+enum ReplicantSyncResult replicant_write_documents_batch(struct Replicant *engine,
+                                                         const char *operations_json,
+                                                         enum ReplicantSyncResult *out_results,
+                                                         uintptr_t results_len);
+
 /**
  * Delete a document
  *
@@ -273,6 +599,111 @@ enum ReplicantSyncResult replicant_update_document(struct Replicant *engine,
 enum ReplicantSyncResult replicant_delete_document(struct Replicant *engine,
                                                    const char *document_id);
 
+/**
+ * Register a callback for async operation completions
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `callback` - C callback invoked when a replicant_*_async operation completes
+ * * `context` - User-defined context pointer passed to callback
+ *
+ * # Returns
+ * * SyncResult indicating success or failure
+ *
+ * # Safety
+ * Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+ */
+enum ReplicantSyncResult replicant_register_operation_callback(struct Replicant *engine,
+                                                               OperationCompleteCallback callback,
+                                                               void *context);
+
+/**
+ * Create a new document without blocking the calling thread
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `content_json` - Document content as JSON string
+ * * `out_document_id` - Output buffer for the (pre-generated) document ID (must be at least 37 chars)
+ * * `out_operation_id` - Output pointer for the operation id passed to the completion callback (optional)
+ *
+ * # Returns
+ * * SyncResult::Success if the operation was enqueued; the final outcome is
+ *   reported through the operation callback
+ *
+ * # Note
+ * The document ID is generated up front and written to out_document_id
+ * before this function returns, so callers can track the document
+ * immediately without waiting for the completion callback.
+ *
+ * # Safety
+ * Caller must ensure engine is valid, content_json is a valid C string, and out_document_id has space for 37 bytes
+ */
+enum ReplicantSyncResult replicant_create_document_async(struct Replicant *engine,
+                                                         const char *content_json,
+                                                         char *out_document_id,
+                                                         uint64_t *out_operation_id);
+
+/**
+ * Update an existing document without blocking the calling thread
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `document_id` - Document ID to update
+ * * `content_json` - New document content as JSON string
+ * * `out_operation_id` - Output pointer for the operation id passed to the completion callback (optional)
+ *
+ * # Returns
+ * * SyncResult::Success if the operation was enqueued; the final outcome is
+ *   reported through the operation callback
+ *
+ * # Safety
+ * Caller must ensure engine is valid and both document_id and content_json are valid C strings
+ */
+enum ReplicantSyncResult replicant_update_document_async(struct Replicant *engine,
+                                                         const char *document_id,
+                                                         const char *content_json,
+                                                         uint64_t *out_operation_id);
+
+/**
+ * Update a document by applying an RFC-6902 patch without blocking the calling thread
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `document_id` - Document ID to update
+ * * `patch_json` - RFC-6902 JSON Patch array
+ * * `out_operation_id` - Output pointer for the operation id passed to the completion callback (optional)
+ *
+ * # Returns
+ * * SyncResult::Success if the operation was enqueued; the final outcome is
+ *   reported through the operation callback
+ *
+ * # Safety
+ * Caller must ensure engine is valid and both document_id and patch_json are valid C strings
+ */
+enum ReplicantSyncResult replicant_update_document_patch_async(struct Replicant *engine,
+                                                               const char *document_id,
+                                                               const char *patch_json,
+                                                               uint64_t *out_operation_id);
+
+/**
+ * Delete a document without blocking the calling thread
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `document_id` - Document ID to delete
+ * * `out_operation_id` - Output pointer for the operation id passed to the completion callback (optional)
+ *
+ * # Returns
+ * * SyncResult::Success if the operation was enqueued; the final outcome is
+ *   reported through the operation callback
+ *
+ * # Safety
+ * Caller must ensure engine is valid and document_id is a valid C string
+ */
+enum ReplicantSyncResult replicant_delete_document_async(struct Replicant *engine,
+                                                         const char *document_id,
+                                                         uint64_t *out_operation_id);
+
 /**
  * Free a C string allocated by this library
  *
@@ -306,6 +737,59 @@ enum ReplicantSyncResult replicant_register_document_callback(struct Replicant *
                                                               void *context,
                                                               int32_t event_filter);
 
+/**
+ * Register a document callback limited to a set of document ids
+ *
+ * Like replicant_register_document_callback, but the callback only
+ * receives events whose document id is in the given set. Intended for
+ * per-view listeners that watch one document (or a handful) and should
+ * not be woken by every other document during a sync burst.
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `callback` - C callback function to invoke for matching document events
+ * * `context` - User-defined context pointer passed to callback
+ * * `event_filter` - Event type to filter (0=Created, 1=Updated, 2=Deleted) or -1 for all document events
+ * * `document_ids` - Array of document ID strings (UUIDs) to subscribe to
+ * * `document_count` - Number of entries in document_ids (must be > 0)
+ *
+ * # Returns
+ * * SyncResult indicating success or failure
+ *
+ * # Safety
+ * Caller must ensure engine is valid, callback is a valid function pointer, document_ids
+ * points to document_count valid C strings, and context pointer outlives the registration
+ */
+enum ReplicantSyncResult replicant_register_document_callback_for_documents(struct Replicant *engine,
+                                                                            DocumentEventCallback callback,
+                                                                            void *context,
+                                                                            int32_t event_filter,
+                                                                            const char *const *document_ids,
+                                                                            uintptr_t document_count);
+
+/**
+ * Enable or disable document update coalescing (off by default)
+ *
+ * When enabled, a burst of consecutive DocumentUpdated events for the
+ * same document is collapsed into the latest one before delivery, so 50
+ * rapid patches during a sync cost one callback invocation (and one UI
+ * refresh) instead of 50. Non-update events and updates to other
+ * documents are never reordered or dropped.
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `enabled` - true to coalesce consecutive updates, false to deliver every event
+ *
+ * # Returns
+ * * SyncResult::Success on success
+ * * SyncResult::ErrorInvalidInput if engine is null
+ *
+ * # Safety
+ * Caller must ensure engine is a valid pointer
+ */
+enum ReplicantSyncResult replicant_set_event_coalescing(struct Replicant *engine,
+                                                        bool enabled);
+
 /**
  * Register a callback for sync events (Started, Completed)
  *
@@ -398,6 +882,73 @@ enum ReplicantSyncResult replicant_register_conflict_callback(struct Replicant *
 enum ReplicantSyncResult replicant_process_events(struct Replicant *engine,
                                                   uint32_t *out_processed_count);
 
+/**
+ * Install (or clear) a notifier fired when events become available
+ *
+ * The notifier fires whenever the event queue goes from empty to
+ * non-empty, so applications can wake their callback thread and call
+ * replicant_process_events immediately instead of polling on a timer.
+ * Pass a null callback to clear the notifier.
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `callback` - Notifier function, or null to clear
+ * * `context` - User-defined context pointer passed to the notifier
+ *
+ * # Returns
+ * * SyncResult indicating success or failure
+ *
+ * # Important
+ * The notifier is invoked from whichever thread queued the event - NOT
+ * the callback thread. It must only schedule a wake-up (e.g. post a
+ * message-loop update that calls replicant_process_events); it must
+ * never drain events or call back into the engine itself.
+ *
+ * # Safety
+ * Caller must ensure engine is valid and context outlives the notifier registration
+ */
+enum ReplicantSyncResult replicant_set_event_notifier(struct Replicant *engine,
+                                                      EventNotifierCallback callback,
+                                                      void *context);
+
+/**
+ * Process all queued events in a single batched callback invocation
+ *
+ * Drains up to `max_events` queued events (0 = no limit) and invokes
+ * `callback` once with an array of event records. All string fields are
+ * backed by one arena allocation per drain, so large syncs cost one
+ * allocation and one FFI crossing instead of one per event.
+ *
+ * Events consumed here are NOT delivered to callbacks registered with
+ * replicant_register_*_callback - use one drain API or the other. Async
+ * operation completions are still delivered to a registered operation
+ * callback as part of this call.
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `callback` - Function receiving the batch of event records
+ * * `context` - User-defined context pointer passed to the callback
+ * * `max_events` - Maximum events to drain in this call (0 = no limit)
+ * * `out_processed_count` - Output pointer for number of events processed (optional)
+ *
+ * # Returns
+ * * CSyncResult indicating success or failure
+ *
+ * # Important
+ * This function MUST be called on the callback thread (established by the
+ * first callback registration or the first call to this function). The
+ * event records and their strings are only valid for the duration of the
+ * callback.
+ *
+ * # Safety
+ * Caller must ensure engine is valid and out_processed_count points to valid memory (if not null)
+ */
+enum ReplicantSyncResult replicant_process_events_batch(struct Replicant *engine,
+                                                        EventBatchCallback callback,
+                                                        void *context,
+                                                        uint32_t max_events,
+                                                        uint32_t *out_processed_count);
+
 /**
  * Get a document by ID
  *
@@ -417,6 +968,95 @@ enum ReplicantSyncResult replicant_get_document(struct Replicant *engine,
                                                 const char *document_id,
                                                 char **out_content);
 
+/**
+ * Get a document by ID as a filled `Document` struct
+ *
+ * Unlike `replicant_get_document`, which returns one JSON blob the
+ * caller must re-parse, this fills the caller's `Document` with
+ * pointers into a single engine-owned arena: one lookup, no JSON
+ * re-parsing on the caller's side. `title` is null for untitled
+ * documents. Free the arena with `replicant_document_free`.
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `document_id` - Document ID as UUID string
+ * * `out_document` - Caller-allocated struct to fill
+ *
+ * # Returns
+ * * SyncResult::Success if document found and struct filled
+ * * SyncResult::ErrorInvalidInput if document not found or invalid ID
+ *
+ * # Safety
+ * Caller must ensure engine is valid, document_id is a valid C string,
+ * and out_document points to a valid `Document`
+ */
+enum ReplicantSyncResult replicant_get_document_struct(struct Replicant *engine,
+                                                       const char *document_id,
+                                                       struct Document *out_document);
+
+/**
+ * Free the arena behind a `Document` filled by replicant_get_document_struct
+ *
+ * # Safety
+ * Caller must pass a struct previously filled by
+ * replicant_get_document_struct that hasn't been freed
+ */
+void replicant_document_free(struct Document *document);
+
+/**
+ * Get all documents as an array of `Document` structs
+ *
+ * Batch form of `replicant_get_document_struct`: every record's strings
+ * point into one shared arena, so a full listing costs two allocations
+ * (records + arena) and zero JSON re-parsing on the caller's side. Free
+ * with `replicant_documents_free`.
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `out_documents` - Output pointer for the record array (null when empty)
+ * * `out_count` - Output pointer for the number of records
+ *
+ * # Returns
+ * * SyncResult::Success with the filled array (count 0 if no documents)
+ *
+ * # Safety
+ * Caller must ensure engine is valid and both output pointers are valid
+ */
+enum ReplicantSyncResult replicant_get_all_documents_struct(struct Replicant *engine,
+                                                            struct Document **out_documents,
+                                                            uint32_t *out_count);
+
+/**
+ * Free an array returned by replicant_get_all_documents_struct
+ *
+ * # Safety
+ * Caller must pass the pointer and count exactly as returned by
+ * replicant_get_all_documents_struct, at most once
+ */
+void replicant_documents_free(struct Document *documents, uint32_t count);
+
+/**
+ * Set the byte budget of the in-process document read cache
+ *
+ * Repeat replicant_get_document calls for the same document are served
+ * from memory until the document changes. The cache holds at most
+ * `max_bytes` of document content (least-recently-used documents are
+ * evicted first). Pass 0 to disable caching entirely.
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `max_bytes` - Maximum cache size in bytes (0 disables the cache)
+ *
+ * # Returns
+ * * SyncResult::Success on success
+ * * SyncResult::ErrorInvalidInput if engine is null
+ *
+ * # Safety
+ * Caller must ensure engine is a valid pointer
+ */
+enum ReplicantSyncResult replicant_set_document_cache_budget(struct Replicant *engine,
+                                                             uintptr_t max_bytes);
+
 /**
  * Get all documents as a JSON array
  *
@@ -433,6 +1073,167 @@ enum ReplicantSyncResult replicant_get_document(struct Replicant *engine,
 enum ReplicantSyncResult replicant_get_all_documents(struct Replicant *engine,
                                                      char **out_documents);
 
+/**
+ * Get metadata for all documents as a JSON array (no content bodies)
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `out_metadata` - Output pointer for JSON array of metadata objects
+ *   `{"id", "title", "sync_revision", "updated_at"}` (caller must free with replicant_string_free)
+ *
+ * # Returns
+ * * SyncResult::Success with JSON array (empty array [] if no documents)
+ *
+ * # Note
+ * Use this instead of replicant_get_all_documents for list views: content
+ * bodies are never read or deserialized, so listing tens of thousands of
+ * documents costs kilobytes rather than the size of every body.
+ *
+ * # Safety
+ * Caller must ensure engine is valid and out_metadata is a valid pointer
+ */
+enum ReplicantSyncResult replicant_get_documents_metadata(struct Replicant *engine,
+                                                          char **out_metadata);
+
+/**
+ * Read the cold-start snapshot for a database without opening an engine
+ *
+ * # Arguments
+ * * `database_path` - Same database path/URL that would be passed to
+ *   replicant_create; the snapshot file lives next to the database
+ * * `out_documents` - Output pointer for a JSON array of
+ *   `{"id", "title", "sync_revision", "updated_at", "content"}` objects
+ *   (caller must free with replicant_string_free)
+ *
+ * # Returns
+ * * SyncResult::Success with the snapshot contents
+ * * SyncResult::ErrorDatabase if no snapshot exists yet or it is corrupt
+ *
+ * # Note
+ * This opens nothing but a memory-mapped file - no SQLite, no migrations,
+ * no network - so an app can render its document list within milliseconds
+ * of launch while replicant_create initializes in the background. The
+ * snapshot is written periodically by a running engine and may be up to
+ * one write interval stale; replace the snapshot view with live data once
+ * the engine is up.
+ *
+ * # Safety
+ * Caller must ensure database_path is a valid C string and out_documents
+ * is a valid pointer
+ */
+enum ReplicantSyncResult replicant_open_snapshot(const char *database_path, char **out_documents);
+
+/**
+ * Search documents using FTS5, returning one bm25-ordered page
+ *
+ * # Arguments
+ * * `engine` - Replicant client instance
+ * * `query` - FTS5 query string (same syntax as replicant_search_documents)
+ * * `limit` - Maximum number of results (0 for default of 100)
+ * * `offset` - Number of ranked results to skip (for pagination)
+ * * `out_documents` - Output pointer for JSON array of matching documents
+ *
+ * # Returns
+ * * SyncResult::Success with JSON array in out_documents
+ * * SyncResult::ErrorInvalidInput if query is invalid
+ * * SyncResult::ErrorDatabase if search fails
+ *
+ * # Safety
+ * Caller must ensure engine is valid, query is a valid C string, and
+ * out_documents is a valid pointer. Free result with replicant_string_free
+ */
+enum ReplicantSyncResult replicant_search_documents_page(struct Replicant *engine,
+                                                         const char *query,
+                                                         uint32_t limit,
+                                                         uint32_t offset,
+                                                         char **out_documents);
+
+/**
+ * Search documents using FTS5, returning ranked snippets only
+ *
+ * The cheap projection for search-as-you-type: each hit is
+ * `{"id", "title", "rank", "snippet"}` — no content bodies are read or
+ * serialized. `rank` is the bm25 score (lower is more relevant) and
+ * `snippet` comes from FTS5's snippet() with matches wrapped in
+ * `<b>`/`</b>`. Fetch the full body with replicant_get_document for
+ * the hit the user opens.
+ *
+ * # Arguments
+ * * `engine` - Replicant client instance
+ * * `query` - FTS5 query string (same syntax as replicant_search_documents)
+ * * `limit` - Maximum number of results (0 for default of 100)
+ * * `offset` - Number of ranked results to skip (for pagination)
+ * * `out_hits` - Output pointer for JSON array of hit objects
+ *
+ * # Returns
+ * * SyncResult::Success with JSON array in out_hits
+ * * SyncResult::ErrorInvalidInput if query is invalid
+ * * SyncResult::ErrorDatabase if search fails
+ *
+ * # Safety
+ * Caller must ensure engine is valid, query is a valid C string, and
+ * out_hits is a valid pointer. Free result with replicant_string_free
+ */
+enum ReplicantSyncResult replicant_search_documents_snippets(struct Replicant *engine,
+                                                             const char *query,
+                                                             uint32_t limit,
+                                                             uint32_t offset,
+                                                             char **out_hits);
+
+/**
+ * Open a cursor over all (non-deleted) local documents
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ *
+ * # Returns
+ * * Pointer to a DocumentCursor on success, null on failure
+ *
+ * # Note
+ * Unlike replicant_get_all_documents, the cursor pages rows out of SQLite
+ * incrementally (ordered by document id), so memory stays flat no matter
+ * how many documents exist. Documents created while iterating may or may
+ * not be observed by the cursor.
+ *
+ * # Safety
+ * Caller must ensure engine is valid, must free the cursor with
+ * replicant_cursor_destroy, and must not use the cursor after the engine
+ * has been destroyed
+ */
+struct DocumentCursor *replicant_open_document_cursor(struct Replicant *engine);
+
+/**
+ * Fetch the next batch of documents from a cursor
+ *
+ * # Arguments
+ * * `cursor` - Cursor created by replicant_open_document_cursor
+ * * `batch_size` - Maximum number of documents to return (0 for default of 100)
+ * * `out_documents` - Output pointer for JSON array of documents (caller must free with replicant_string_free)
+ * * `out_count` - Output pointer for the number of documents in the batch (optional)
+ *
+ * # Returns
+ * * SyncResult::Success with a JSON array in out_documents; an empty array
+ *   (and out_count of 0) means the cursor is exhausted
+ * * SyncResult::ErrorDatabase if the page query fails
+ *
+ * # Safety
+ * Caller must ensure cursor and out_documents are valid pointers and
+ * out_count (if not null) points to valid memory
+ */
+enum ReplicantSyncResult replicant_cursor_next_batch(struct DocumentCursor *cursor,
+                                                     uint32_t batch_size,
+                                                     char **out_documents,
+                                                     uint32_t *out_count);
+
+/**
+ * Destroy a document cursor and free its memory
+ *
+ * # Safety
+ * Caller must ensure the cursor was created by replicant_open_document_cursor
+ * and hasn't been freed
+ */
+void replicant_cursor_destroy(struct DocumentCursor *cursor);
+
 /**
  * Get the count of local documents
  *
@@ -478,6 +1279,44 @@ bool replicant_is_connected(struct Replicant *engine);
 enum ReplicantSyncResult replicant_count_pending_sync(struct Replicant *engine,
                                                       uint64_t *out_count);
 
+/**
+ * Get a metrics snapshot as a JSON string
+ *
+ * The snapshot covers upload latency, heartbeat round-trip time, SQLite
+ * query timings, upload retry counts and the event queue depth. All
+ * counters are always on; reading them is cheap and side-effect free.
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `out_json` - Output pointer for the JSON string (caller must free with replicant_string_free)
+ *
+ * # Returns
+ * * SyncResult::Success with JSON written to out_json
+ *
+ * # Safety
+ * Caller must ensure engine is valid and out_json is a valid pointer
+ */
+enum ReplicantSyncResult replicant_get_metrics(struct Replicant *engine, char **out_json);
+
+/**
+ * Get a metrics snapshot as a plain struct, without any allocation
+ *
+ * Same numbers as `replicant_get_metrics`, for callers that want typed
+ * fields instead of JSON.
+ *
+ * # Arguments
+ * * `engine` - Sync engine instance
+ * * `out_metrics` - Output pointer the snapshot is written to
+ *
+ * # Returns
+ * * SyncResult::Success with the snapshot written to out_metrics
+ *
+ * # Safety
+ * Caller must ensure engine is valid and out_metrics is a valid pointer
+ */
+enum ReplicantSyncResult replicant_get_metrics_struct(struct Replicant *engine,
+                                                      struct ReplicantClientMetrics *out_metrics);
+
 /**
  * Configure which JSON paths to index for full-text search
  *
@@ -529,6 +1368,35 @@ enum ReplicantSyncResult replicant_search_documents(struct Replicant *engine,
                                                     uint32_t limit,
                                                     char **out_documents);
 
+/**
+ * Search documents using FTS5, returning metadata only (no content bodies)
+ *
+ * # Arguments
+ * * `engine` - Replicant client instance
+ * * `query` - FTS5 query string (same syntax as replicant_search_documents)
+ * * `limit` - Maximum number of results (0 for default of 100)
+ * * `out_metadata` - Output pointer for JSON array of metadata objects
+ *   `{"id", "title", "sync_revision", "updated_at"}`
+ *
+ * # Returns
+ * * SyncResult::Success with JSON array in out_metadata
+ * * SyncResult::ErrorInvalidInput if query is invalid
+ * * SyncResult::ErrorDatabase if search fails
+ *
+ * # Note
+ * Same matching and ranking as replicant_search_documents, but result rows
+ * skip the content column entirely - use this to populate search result
+ * lists, then fetch individual bodies with replicant_get_document.
+ *
+ * # Safety
+ * Caller must ensure engine is valid, query is a valid C string,
+ * and out_metadata is a valid pointer. Caller must free result with replicant_string_free.
+ */
+enum ReplicantSyncResult replicant_search_documents_metadata(struct Replicant *engine,
+                                                             const char *query,
+                                                             uint32_t limit,
+                                                             char **out_metadata);
+
 /**
  * Rebuild the full-text search index
  *
@@ -3,14 +3,18 @@
 #include "replicant.h"
 #include <memory>
 #include <string>
+#include <string_view>
 #include <stdexcept>
 #include <functional>
+#include <vector>
 
 namespace replicant
 {
 
 using EventType = ReplicantEventType;
 using SyncResult = ReplicantSyncResult;
+using ClientMetrics = ReplicantClientMetrics;
+using MetricsTiming = ReplicantMetricsTiming;
 
 /**
  * Exception thrown by replicant operations
@@ -37,6 +41,322 @@ private:
     }
 };
 
+/**
+ * RAII wrapper for an incremental document cursor
+ *
+ * Pages documents out of the local database in fixed-size batches so large
+ * document sets can be iterated without a single giant allocation. Obtain
+ * one from Client::open_document_cursor().
+ *
+ * Example usage:
+ * ```cpp
+ * auto cursor = client.open_document_cursor();
+ * while (!cursor.at_end())
+ * {
+ *     std::string batch = cursor.next_batch(500); // JSON array of <= 500 docs
+ *     render(batch);
+ * }
+ * ```
+ */
+class Cursor
+{
+private:
+    std::unique_ptr<DocumentCursor, std::function<void(DocumentCursor*)>> handle;
+    bool exhausted = false;
+
+    friend class Client;
+
+    explicit Cursor(DocumentCursor* raw_handle)
+        : handle(raw_handle,
+                 [](DocumentCursor* c)
+                 {
+                     if (c)
+                     {
+                         replicant_cursor_destroy(c);
+                     }
+                 })
+    {
+    }
+
+public:
+    /**
+     * Fetch the next batch of documents
+     *
+     * @param batch_size Maximum documents per batch (0 for default of 100)
+     * @return JSON array of documents (empty array "[]" once exhausted)
+     * @throws SyncException if the page query fails
+     */
+    std::string next_batch(uint32_t batch_size = 0)
+    {
+        char* docs = nullptr;
+        uint32_t count = 0;
+        SyncResult result = replicant_cursor_next_batch(handle.get(), batch_size, &docs, &count);
+
+        if (result != Success)
+        {
+            throw SyncException(result);
+        }
+
+        if (count == 0)
+        {
+            exhausted = true;
+        }
+
+        std::string batch(docs);
+        replicant_string_free(docs);
+        return batch;
+    }
+
+    /**
+     * Check whether the cursor has returned its last batch
+     *
+     * @return true once next_batch() has returned an empty batch
+     */
+    bool at_end() const
+    {
+        return exhausted;
+    }
+
+    // Move-only, like Client
+    Cursor(const Cursor&) = delete;
+    Cursor& operator=(const Cursor&) = delete;
+    Cursor(Cursor&&) = default;
+    Cursor& operator=(Cursor&&) = default;
+};
+
+/**
+ * Builder for the SQLite performance profile applied at client creation
+ *
+ * Unset fields keep the library defaults, so an empty builder behaves
+ * exactly like the plain Client constructor. Hosts on slow storage
+ * typically relax durability and grow the cache:
+ *
+ * ```cpp
+ * auto options = replicant::ClientOptions()
+ *                    .journal_mode(replicant::JournalModeWal)
+ *                    .synchronous(replicant::SynchronousNormal)
+ *                    .cache_size_kib(64 * 1024)
+ *                    .mmap_size_bytes(256 * 1024 * 1024);
+ * replicant::Client client(db_url, server_url, email, key, secret, options);
+ * ```
+ */
+class ClientOptions
+{
+private:
+    ReplicantClientOptions options = {};
+
+    friend class Client;
+
+public:
+    ClientOptions()
+    {
+        options.journal_mode = JournalModeDefault;
+        options.synchronous = SynchronousDefault;
+    }
+
+    /** SQLite journal mode (default: WAL) */
+    ClientOptions& journal_mode(ReplicantJournalMode mode)
+    {
+        options.journal_mode = mode;
+        return *this;
+    }
+
+    /** SQLite synchronous level (default: FULL) */
+    ClientOptions& synchronous(ReplicantSynchronousMode mode)
+    {
+        options.synchronous = mode;
+        return *this;
+    }
+
+    /** Database page size in bytes; only affects fresh database files */
+    ClientOptions& page_size_bytes(uint32_t bytes)
+    {
+        options.page_size_bytes = bytes;
+        return *this;
+    }
+
+    /** Page-cache budget in KiB */
+    ClientOptions& cache_size_kib(int64_t kib)
+    {
+        options.cache_size_kib = kib;
+        return *this;
+    }
+
+    /** Memory-mapped I/O window in bytes */
+    ClientOptions& mmap_size_bytes(int64_t bytes)
+    {
+        options.mmap_size_bytes = bytes;
+        return *this;
+    }
+
+    /** Busy handler timeout in milliseconds */
+    ClientOptions& busy_timeout_ms(uint32_t ms)
+    {
+        options.busy_timeout_ms = ms;
+        return *this;
+    }
+
+    /** SQLite connection pool size */
+    ClientOptions& pool_size(uint32_t connections)
+    {
+        options.pool_size = connections;
+        return *this;
+    }
+
+    /** Per-connection prepared-statement cache entries */
+    ClientOptions& statement_cache_capacity(uint32_t entries)
+    {
+        options.statement_cache_capacity = entries;
+        return *this;
+    }
+};
+
+/**
+ * RAII view of one document read through the struct-based API
+ *
+ * Wraps a `Document` whose strings point into a single engine-owned
+ * arena, so a read is one lookup with no JSON re-parsing and no copies:
+ * the accessors hand back string_views into the arena. The views are
+ * only valid for the lifetime of this object.
+ */
+class DocumentView
+{
+private:
+    Document doc = {};
+
+    friend class Client;
+
+    DocumentView() = default;
+
+public:
+    ~DocumentView()
+    {
+        replicant_document_free(&doc);
+    }
+
+    /** Document ID (UUID string) */
+    std::string_view id() const
+    {
+        return doc.id ? std::string_view(doc.id) : std::string_view();
+    }
+
+    /** Document title (empty view for untitled documents) */
+    std::string_view title() const
+    {
+        return doc.title ? std::string_view(doc.title) : std::string_view();
+    }
+
+    /** Document content JSON */
+    std::string_view content() const
+    {
+        return doc.content ? std::string_view(doc.content) : std::string_view();
+    }
+
+    int64_t sync_revision() const
+    {
+        return doc.sync_revision;
+    }
+
+    // Move-only: the destructor frees the arena exactly once
+    DocumentView(const DocumentView&) = delete;
+    DocumentView& operator=(const DocumentView&) = delete;
+    DocumentView(DocumentView&& other) noexcept : doc(other.doc)
+    {
+        other.doc = {};
+    }
+    DocumentView& operator=(DocumentView&& other) noexcept
+    {
+        if (this != &other)
+        {
+            replicant_document_free(&doc);
+            doc = other.doc;
+            other.doc = {};
+        }
+        return *this;
+    }
+};
+
+/**
+ * RAII view of a full document listing read through the struct-based API
+ *
+ * All records share one arena; accessors return string_views valid for
+ * the lifetime of this object.
+ */
+class DocumentSetView
+{
+private:
+    Document* docs = nullptr;
+    uint32_t count = 0;
+
+    friend class Client;
+
+    DocumentSetView(Document* raw_docs, uint32_t raw_count)
+        : docs(raw_docs), count(raw_count)
+    {
+    }
+
+public:
+    /** Field views of one record; valid while the set view is alive */
+    struct Ref
+    {
+        std::string_view id;
+        std::string_view title;
+        std::string_view content;
+        int64_t sync_revision;
+    };
+
+    ~DocumentSetView()
+    {
+        replicant_documents_free(docs, count);
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    Ref at(size_t index) const
+    {
+        if (index >= count)
+        {
+            throw SyncException("Document index out of range");
+        }
+        const Document& d = docs[index];
+        return Ref{
+            d.id ? std::string_view(d.id) : std::string_view(),
+            d.title ? std::string_view(d.title) : std::string_view(),
+            d.content ? std::string_view(d.content) : std::string_view(),
+            d.sync_revision,
+        };
+    }
+
+    // Move-only, like DocumentView
+    DocumentSetView(const DocumentSetView&) = delete;
+    DocumentSetView& operator=(const DocumentSetView&) = delete;
+    DocumentSetView(DocumentSetView&& other) noexcept : docs(other.docs), count(other.count)
+    {
+        other.docs = nullptr;
+        other.count = 0;
+    }
+    DocumentSetView& operator=(DocumentSetView&& other) noexcept
+    {
+        if (this != &other)
+        {
+            replicant_documents_free(docs, count);
+            docs = other.docs;
+            count = other.count;
+            other.docs = nullptr;
+            other.count = 0;
+        }
+        return *this;
+    }
+};
+
 /**
  * RAII wrapper for the Replicant client with modern C++ interface
  *
@@ -105,6 +425,50 @@ public:
         );
     }
 
+    /**
+     * Create a new Replicant client instance with a SQLite performance profile
+     *
+     * @param database_url SQLite database URL (e.g., "sqlite:client.db?mode=rwc")
+     * @param server_url WebSocket server URL (e.g., "ws://localhost:8080/ws")
+     * @param email User email address for identification
+     * @param api_key Application API key (rpa_ prefix)
+     * @param api_secret Application API secret (rps_ prefix)
+     * @param options SQLite profile built with ClientOptions
+     * @throws SyncException if creation fails
+     */
+    Client(const std::string& database_url,
+           const std::string& server_url,
+           const std::string& email,
+           const std::string& api_key,
+           const std::string& api_secret,
+           const ClientOptions& options)
+    {
+        Replicant* raw_handle = replicant_create_with_options(
+            database_url.c_str(),
+            server_url.c_str(),
+            email.c_str(),
+            api_key.c_str(),
+            api_secret.c_str(),
+            &options.options
+        );
+
+        if (!raw_handle)
+        {
+            throw SyncException("Failed to create Replicant client");
+        }
+
+        handle = std::unique_ptr<Replicant, std::function<void(Replicant*)>>(
+            raw_handle,
+            [](Replicant* r)
+            {
+                if (r)
+                {
+                    replicant_destroy(r);
+                }
+            }
+        );
+    }
+
     /**
      * Create a new document
      *
@@ -143,6 +507,60 @@ public:
         check_result(result);
     }
 
+    /**
+     * Bulk-import documents from an NDJSON file
+     *
+     * Each line is one document: either a bare content object, or
+     * {"id": ..., "content": ...} to preserve ids from an export.
+     * Documents are written in large multi-row transactions with one
+     * FTS rebuild at the end, so this is the right path for migrations
+     * instead of looping create_document_with_id().
+     *
+     * @param ndjson_path Path to an NDJSON file, one document per line
+     * @param mark_synced Mark rows pre-synced (server-seeded imports)
+     * @return Number of documents imported (unparseable lines are skipped)
+     * @throws SyncException if the import fails
+     */
+    uint64_t import_documents(const std::string& ndjson_path, bool mark_synced = false)
+    {
+        uint64_t imported = 0;
+        SyncResult result = replicant_import_documents(
+            handle.get(),
+            ndjson_path.c_str(),
+            mark_synced,
+            &imported
+        );
+
+        check_result(result);
+        return imported;
+    }
+
+    /**
+     * Bulk-import documents from an NDJSON buffer in memory
+     *
+     * Same semantics as import_documents(), reading from a caller-owned
+     * buffer (e.g. a memory-mapped export) instead of a file path.
+     *
+     * @param ndjson NDJSON bytes, one document per line
+     * @param mark_synced Mark rows pre-synced (server-seeded imports)
+     * @return Number of documents imported (unparseable lines are skipped)
+     * @throws SyncException if the import fails
+     */
+    uint64_t import_documents_buffer(std::string_view ndjson, bool mark_synced = false)
+    {
+        uint64_t imported = 0;
+        SyncResult result = replicant_import_documents_buffer(
+            handle.get(),
+            reinterpret_cast<const uint8_t*>(ndjson.data()),
+            ndjson.size(),
+            mark_synced,
+            &imported
+        );
+
+        check_result(result);
+        return imported;
+    }
+
     /**
      * Update an existing document
      *
@@ -161,6 +579,56 @@ public:
         check_result(result);
     }
 
+    /**
+     * Update a document by applying an RFC-6902 patch directly
+     *
+     * Prefer this over update_document() when the caller already knows which
+     * fields changed: the patch is applied and queued for sync as-is, with
+     * no full-document diff.
+     *
+     * @param document_id Document ID to update
+     * @param patch_json RFC-6902 JSON Patch array
+     *        (e.g. R"([{"op":"replace","path":"/title","value":"New"}])")
+     * @throws SyncException if the patch is invalid or the update fails
+     */
+    void apply_patch(const std::string& document_id, const std::string& patch_json)
+    {
+        SyncResult result = replicant_update_document_patch(
+            handle.get(),
+            document_id.c_str(),
+            patch_json.c_str()
+        );
+
+        check_result(result);
+    }
+
+    /**
+     * Write a batch of documents in one transaction
+     *
+     * Existing documents are updated, new ids are created. All operations are
+     * applied in a single database transaction, which is significantly faster
+     * than per-document calls for bulk imports and edits.
+     *
+     * @param operations_json JSON array of operations:
+     *        '[{"id": "<uuid>", "content": {...}}, ...]' ("id" is optional)
+     * @param operation_count Number of operations in the array
+     * @return Per-item result codes, one per operation
+     * @throws SyncException if the batch transaction fails as a whole
+     */
+    std::vector<SyncResult> write_batch(const std::string& operations_json, size_t operation_count)
+    {
+        std::vector<SyncResult> results(operation_count, Success);
+        SyncResult result = replicant_write_documents_batch(
+            handle.get(),
+            operations_json.c_str(),
+            results.empty() ? nullptr : results.data(),
+            results.size()
+        );
+
+        check_result(result);
+        return results;
+    }
+
     /**
      * Delete a document
      *
@@ -177,6 +645,98 @@ public:
         check_result(result);
     }
 
+    /**
+     * Create a new document without blocking the calling thread
+     *
+     * The operation is enqueued on the client runtime; completion is
+     * reported through the callback registered with
+     * register_operation_callback() during process_events().
+     *
+     * @param content_json Document content as JSON string
+     * @param out_document_id Receives the pre-generated document ID immediately
+     * @return Operation id passed to the completion callback
+     * @throws SyncException if the operation could not be enqueued
+     */
+    uint64_t create_document_async(const std::string& content_json, std::string& out_document_id)
+    {
+        char doc_id[37] = {0}; // UUID string + null terminator
+        uint64_t operation_id = 0;
+        SyncResult result = replicant_create_document_async(
+            handle.get(),
+            content_json.c_str(),
+            doc_id,
+            &operation_id
+        );
+
+        check_result(result);
+        out_document_id = doc_id;
+        return operation_id;
+    }
+
+    /**
+     * Update an existing document without blocking the calling thread
+     *
+     * @param document_id Document ID to update
+     * @param content_json New document content as JSON string
+     * @return Operation id passed to the completion callback
+     * @throws SyncException if the operation could not be enqueued
+     */
+    uint64_t update_document_async(const std::string& document_id, const std::string& content_json)
+    {
+        uint64_t operation_id = 0;
+        SyncResult result = replicant_update_document_async(
+            handle.get(),
+            document_id.c_str(),
+            content_json.c_str(),
+            &operation_id
+        );
+
+        check_result(result);
+        return operation_id;
+    }
+
+    /**
+     * Apply an RFC-6902 patch without blocking the calling thread
+     *
+     * @param document_id Document ID to update
+     * @param patch_json RFC-6902 JSON Patch array
+     * @return Operation id passed to the completion callback
+     * @throws SyncException if the operation could not be enqueued
+     */
+    uint64_t apply_patch_async(const std::string& document_id, const std::string& patch_json)
+    {
+        uint64_t operation_id = 0;
+        SyncResult result = replicant_update_document_patch_async(
+            handle.get(),
+            document_id.c_str(),
+            patch_json.c_str(),
+            &operation_id
+        );
+
+        check_result(result);
+        return operation_id;
+    }
+
+    /**
+     * Delete a document without blocking the calling thread
+     *
+     * @param document_id Document ID to delete
+     * @return Operation id passed to the completion callback
+     * @throws SyncException if the operation could not be enqueued
+     */
+    uint64_t delete_document_async(const std::string& document_id)
+    {
+        uint64_t operation_id = 0;
+        SyncResult result = replicant_delete_document_async(
+            handle.get(),
+            document_id.c_str(),
+            &operation_id
+        );
+
+        check_result(result);
+        return operation_id;
+    }
+
     /**
      * Get the library version
      *
@@ -218,6 +778,68 @@ public:
         return doc;
     }
 
+    /**
+     * Get a document by ID as a zero-copy view
+     *
+     * Unlike get_document(), which returns a JSON blob to re-parse, the
+     * returned view exposes id/title/content as string_views into one
+     * engine-owned arena: one lookup, no JSON re-parsing, no copies.
+     *
+     * @param document_id Document ID (UUID string)
+     * @return DocumentView over the document's fields
+     * @throws SyncException if document not found or retrieval fails
+     */
+    DocumentView get_document_view(const std::string& document_id)
+    {
+        DocumentView view;
+        SyncResult result = replicant_get_document_struct(
+            handle.get(),
+            document_id.c_str(),
+            &view.doc
+        );
+
+        check_result(result);
+        return view;
+    }
+
+    /**
+     * Get all documents as a zero-copy view set
+     *
+     * Batch form of get_document_view(): every record's strings share
+     * one arena, freed when the returned set goes out of scope.
+     *
+     * @return DocumentSetView over all documents (empty if none)
+     * @throws SyncException if the query fails
+     */
+    DocumentSetView get_all_document_views()
+    {
+        Document* docs = nullptr;
+        uint32_t count = 0;
+        SyncResult result = replicant_get_all_documents_struct(handle.get(), &docs, &count);
+
+        check_result(result);
+        return DocumentSetView(docs, count);
+    }
+
+    /**
+     * Set the byte budget of the in-process document read cache
+     *
+     * Repeat get_document() calls for the same document are served from
+     * memory until the document changes.
+     *
+     * @param max_bytes Maximum cache size in bytes (0 disables the cache)
+     * @throws SyncException if the call fails
+     */
+    void set_document_cache_budget(size_t max_bytes)
+    {
+        SyncResult result = replicant_set_document_cache_budget(
+            handle.get(),
+            max_bytes
+        );
+
+        check_result(result);
+    }
+
     /**
      * Get all documents as a JSON array
      *
@@ -239,6 +861,77 @@ public:
         return all_docs;
     }
 
+    /**
+     * Get metadata for all documents (no content bodies)
+     *
+     * Prefer this over get_all_documents() for list views: only id, title,
+     * sync_revision and updated_at are read per row.
+     *
+     * @return JSON array of metadata objects, most recently updated first
+     * @throws SyncException if retrieval fails
+     */
+    std::string get_documents_metadata()
+    {
+        char* metadata = nullptr;
+        SyncResult result = replicant_get_documents_metadata(handle.get(), &metadata);
+
+        check_result(result);
+
+        std::string all_metadata(metadata);
+        replicant_string_free(metadata);
+        return all_metadata;
+    }
+
+    /**
+     * Read the cold-start snapshot for a database without opening an engine
+     *
+     * Static: needs no Client instance. Serves the document list from a
+     * memory-mapped snapshot file within milliseconds of launch, so the UI
+     * can render while the full Client constructor (database, migrations,
+     * network) runs in the background. The snapshot may be up to one write
+     * interval stale; replace it with live data once the engine is up.
+     *
+     * @param database_path Same database path/URL the Client is created with
+     * @return JSON array of {"id", "title", "sync_revision", "updated_at",
+     *         "content"} objects
+     * @throws SyncException if no snapshot exists yet or it is corrupt
+     */
+    static std::string open_snapshot(const std::string& database_path)
+    {
+        char* docs = nullptr;
+        SyncResult result = replicant_open_snapshot(database_path.c_str(), &docs);
+
+        if (result != SyncResult::Success)
+        {
+            throw SyncException(result);
+        }
+
+        std::string snapshot_docs(docs);
+        replicant_string_free(docs);
+        return snapshot_docs;
+    }
+
+    /**
+     * Open a cursor over all local documents
+     *
+     * Prefer this over get_all_documents() for large document sets: batches
+     * are paged out of the database incrementally, so memory stays flat and
+     * the first page is available immediately.
+     *
+     * @return Cursor over all non-deleted documents, ordered by id
+     * @throws SyncException if the cursor cannot be opened
+     */
+    Cursor open_document_cursor()
+    {
+        DocumentCursor* raw_cursor = replicant_open_document_cursor(handle.get());
+        if (!raw_cursor)
+        {
+            throw SyncException("Failed to open document cursor");
+        }
+
+        return Cursor(raw_cursor);
+    }
+
     /**
      * Get the count of local documents
      *
@@ -277,6 +970,42 @@ public:
         return count;
     }
 
+    /**
+     * Get a typed snapshot of the always-on client metrics
+     *
+     * Covers upload latency, heartbeat round-trip time, SQLite query
+     * timings, upload retry counts and the event queue depth. Timings
+     * are microsecond summaries (count/total/mean/min/max/last).
+     *
+     * @return Metrics snapshot struct
+     * @throws SyncException if the snapshot cannot be read
+     */
+    ClientMetrics metrics()
+    {
+        ClientMetrics snapshot;
+        SyncResult result = replicant_get_metrics_struct(handle.get(), &snapshot);
+        check_result(result);
+        return snapshot;
+    }
+
+    /**
+     * Get the same metrics snapshot as a JSON string, ready to forward
+     * to a telemetry pipeline
+     *
+     * @return Metrics snapshot as JSON
+     * @throws SyncException if the snapshot cannot be serialized
+     */
+    std::string metrics_json()
+    {
+        char* json = nullptr;
+        SyncResult result = replicant_get_metrics(handle.get(), &json);
+        check_result(result);
+
+        std::string out(json);
+        replicant_string_free(json);
+        return out;
+    }
+
     /**
      * Configure which JSON paths to index for full-text search
      *
@@ -307,6 +1036,76 @@ public:
         return results;
     }
 
+    /**
+     * Search documents using FTS5, returning one bm25-ordered page
+     *
+     * Same matching as search_documents() plus an offset, so result
+     * lists can page instead of refetching a growing prefix.
+     *
+     * @param query FTS5 query string
+     * @param limit Maximum results (0 for default of 100)
+     * @param offset Number of ranked results to skip
+     * @return JSON array of matching documents
+     * @throws SyncException if search fails
+     */
+    std::string search_documents(const std::string& query, uint32_t limit, uint32_t offset)
+    {
+        char* docs = nullptr;
+        SyncResult result = replicant_search_documents_page(handle.get(), query.c_str(), limit, offset, &docs);
+        check_result(result);
+        std::string results(docs);
+        replicant_string_free(docs);
+        return results;
+    }
+
+    /**
+     * Search documents using FTS5, returning ranked snippets only
+     *
+     * The cheap projection for search-as-you-type: each hit is
+     * {"id", "title", "rank", "snippet"} — no content bodies are read
+     * or serialized. rank is the bm25 score (lower is more relevant)
+     * and snippet comes from FTS5's snippet() with matches wrapped in
+     * <b>/</b>. Fetch the full body with get_document() for the hit
+     * the user opens.
+     *
+     * @param query FTS5 query string
+     * @param limit Maximum results (0 for default of 100)
+     * @param offset Number of ranked results to skip
+     * @return JSON array of hit objects
+     * @throws SyncException if search fails
+     */
+    std::string search_documents_snippets(const std::string& query, uint32_t limit = 0, uint32_t offset = 0)
+    {
+        char* hits = nullptr;
+        SyncResult result = replicant_search_documents_snippets(handle.get(), query.c_str(), limit, offset, &hits);
+        check_result(result);
+        std::string results(hits);
+        replicant_string_free(hits);
+        return results;
+    }
+
+    /**
+     * Search documents using FTS5, returning metadata only
+     *
+     * Same matching and ranking as search_documents(), but result rows skip
+     * the content column - use for search result lists, then fetch bodies
+     * with get_document() as needed.
+     *
+     * @param query FTS5 query string
+     * @param limit Maximum results (0 for default of 100)
+     * @return JSON array of metadata objects
+     * @throws SyncException if search fails
+     */
+    std::string search_documents_metadata(const std::string& query, uint32_t limit = 0)
+    {
+        char* metadata = nullptr;
+        SyncResult result = replicant_search_documents_metadata(handle.get(), query.c_str(), limit, &metadata);
+        check_result(result);
+        std::string results(metadata);
+        replicant_string_free(metadata);
+        return results;
+    }
+
     /**
      * Register a callback for document events (Created, Updated, Deleted)
      *
@@ -321,6 +1120,58 @@ public:
         check_result(result);
     }
 
+    /**
+     * Register a document callback limited to a set of document ids
+     *
+     * The callback only receives events whose document id is in
+     * document_ids - useful for per-view listeners watching one document.
+     *
+     * @param callback Function to call for matching document events
+     * @param context User-defined context pointer passed to callback
+     * @param document_ids Document IDs (UUID strings) to subscribe to (must be non-empty)
+     * @param event_filter Optional filter: 0=Created, 1=Updated, 2=Deleted, -1=all
+     * @throws SyncException if registration fails
+     */
+    void register_document_callback_for_documents(DocumentEventCallback callback,
+                                                  void* context,
+                                                  const std::vector<std::string>& document_ids,
+                                                  int32_t event_filter = -1)
+    {
+        std::vector<const char*> id_ptrs;
+        id_ptrs.reserve(document_ids.size());
+        for (const auto& id : document_ids)
+        {
+            id_ptrs.push_back(id.c_str());
+        }
+
+        SyncResult result = replicant_register_document_callback_for_documents(
+            handle.get(),
+            callback,
+            context,
+            event_filter,
+            id_ptrs.data(),
+            id_ptrs.size()
+        );
+
+        check_result(result);
+    }
+
+    /**
+     * Enable or disable document update coalescing (off by default)
+     *
+     * When enabled, a burst of consecutive updates to the same document is
+     * collapsed into the latest one before delivery, so rapid sync patches
+     * cost one UI refresh instead of one per patch.
+     *
+     * @param enabled true to coalesce consecutive updates
+     * @throws SyncException if the call fails
+     */
+    void set_event_coalescing(bool enabled)
+    {
+        SyncResult result = replicant_set_event_coalescing(handle.get(), enabled);
+        check_result(result);
+    }
+
     /**
      * Register a callback for sync events (Started, Completed)
      *
@@ -373,6 +1224,22 @@ public:
         check_result(result);
     }
 
+    /**
+     * Register a callback for async operation completions
+     *
+     * Invoked during process_events() when an operation started by one of
+     * the *_async methods finishes.
+     *
+     * @param callback Function to call when an async operation completes
+     * @param context User-defined context pointer passed to callback
+     * @throws SyncException if registration fails
+     */
+    void register_operation_callback(OperationCompleteCallback callback, void* context)
+    {
+        SyncResult result = replicant_register_operation_callback(handle.get(), callback, context);
+        check_result(result);
+    }
+
     /**
      * Process all queued events on the current thread
      *
@@ -387,6 +1254,50 @@ public:
         return count;
     }
 
+    /**
+     * Install (or clear) a notifier fired when events become available
+     *
+     * The notifier fires from the producing thread when the event queue
+     * goes empty to non-empty; it must only schedule a wake-up of the
+     * thread that calls process_events(), never drain events itself.
+     *
+     * @param callback Notifier function, or nullptr to clear
+     * @param context User-defined context pointer passed to the notifier
+     * @throws SyncException if registration fails
+     */
+    void set_event_notifier(EventNotifierCallback callback, void* context)
+    {
+        SyncResult result = replicant_set_event_notifier(handle.get(), callback, context);
+        check_result(result);
+    }
+
+    /**
+     * Process all queued events through a single batched callback
+     *
+     * The callback receives an array of BatchedEvent records backed by one
+     * allocation per drain; records are only valid during the call. Events
+     * drained here are not delivered to individually registered callbacks.
+     *
+     * @param callback Function receiving the batch of event records
+     * @param context User-defined context pointer passed to the callback
+     * @param max_events Maximum events to drain (0 = no limit)
+     * @return Number of events processed
+     * @throws SyncException if processing fails
+     */
+    uint32_t process_events_batch(EventBatchCallback callback, void* context, uint32_t max_events = 0)
+    {
+        uint32_t count = 0;
+        SyncResult result = replicant_process_events_batch(
+            handle.get(),
+            callback,
+            context,
+            max_events,
+            &count
+        );
+        check_result(result);
+        return count;
+    }
+
     // Disable copy operations (move-only type)
     Client(const Client&) = delete;
     Client& operator=(const Client&) = delete;
@@ -0,0 +1,3 @@
+-- Index to support metadata listing queries ordered by recency
+-- (document browser list views select id/title/sync_revision only)
+CREATE INDEX idx_documents_updated_at ON documents(updated_at);
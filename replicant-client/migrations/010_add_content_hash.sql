@@ -0,0 +1,6 @@
+-- Store the content hash alongside the document so the incremental
+-- checksum path survives across saves: without it every update has to
+-- rehash the full old content, and the incrementally updated hash
+-- computed on save was being discarded.
+-- NULL means "not known yet" and falls back to full recalculation.
+ALTER TABLE documents ADD COLUMN content_hash TEXT;
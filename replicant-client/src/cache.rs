@@ -0,0 +1,401 @@
+//! In-process read cache for documents
+//!
+//! `ClientDatabase::get_document` is called on every selection change and
+//! re-render in typical UIs, usually for the same handful of hot documents.
+//! This module provides a small LRU cache keyed by document id and
+//! `sync_revision` so repeat reads are served from memory instead of
+//! round-tripping to SQLite.
+//!
+//! # Invalidation
+//!
+//! Entries are invalidated by the same write paths that emit
+//! `DocumentUpdated`/`DocumentDeleted` events: every local save, batch
+//! write, delete, and server-applied update goes through `ClientDatabase`,
+//! which evicts the affected id before and after the database write. The
+//! stored `sync_revision` is double-checked on hit as a safety net.
+//!
+//! Eviction alone cannot close the read/write race: a read that started
+//! before a concurrent write could re-insert the old row after the write
+//! committed and evicted. Each invalidation therefore bumps a per-id
+//! generation counter; readers snapshot it with [`read_generation`]
+//! before querying SQLite and insert through [`insert_if_current`], which
+//! drops the result if any invalidation happened in between.
+//!
+//! [`read_generation`]: DocumentCache::read_generation
+//! [`insert_if_current`]: DocumentCache::insert_if_current
+//!
+//! # Byte budget
+//!
+//! The cache tracks an approximate per-entry byte size (serialized content
+//! length plus fixed overhead) and evicts least-recently-used entries once
+//! the configured budget is exceeded. A budget of 0 disables caching.
+
+use replicant_core::models::Document;
+use std::collections::HashMap;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::Mutex;
+use uuid::Uuid;
+
+/// Default cache budget: 8 MiB of (approximate) document bytes
+pub const DEFAULT_CACHE_BUDGET_BYTES: usize = 8 * 1024 * 1024;
+
+/// Fixed per-entry overhead added to the serialized content size
+const ENTRY_OVERHEAD_BYTES: usize = 256;
+
+struct CacheEntry {
+    document: Document,
+    size_bytes: usize,
+    last_used: u64,
+}
+
+struct CacheInner {
+    entries: HashMap<Uuid, CacheEntry>,
+    // Per-id invalidation counters; small next to the content they guard
+    generations: HashMap<Uuid, u64>,
+    // Bumped by clear(), which can't enumerate ids it has never seen
+    epoch: u64,
+    total_bytes: usize,
+    max_bytes: usize,
+}
+
+/// Snapshot of a document's invalidation state, taken with
+/// [`DocumentCache::read_generation`] before a database read and checked
+/// again by [`DocumentCache::insert_if_current`]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct ReadGeneration {
+    epoch: u64,
+    id_generation: u64,
+}
+
+/// LRU document cache with revision-based invalidation
+pub struct DocumentCache {
+    inner: Mutex<CacheInner>,
+    // Monotonic clock for LRU ordering
+    use_counter: AtomicU64,
+    hits: AtomicU64,
+    misses: AtomicU64,
+}
+
+impl DocumentCache {
+    pub fn new(max_bytes: usize) -> Self {
+        Self {
+            inner: Mutex::new(CacheInner {
+                entries: HashMap::new(),
+                generations: HashMap::new(),
+                epoch: 0,
+                total_bytes: 0,
+                max_bytes,
+            }),
+            use_counter: AtomicU64::new(0),
+            hits: AtomicU64::new(0),
+            misses: AtomicU64::new(0),
+        }
+    }
+
+    /// Change the byte budget. Shrinking evicts LRU entries immediately;
+    /// a budget of 0 disables caching and clears all entries.
+    pub fn set_budget(&self, max_bytes: usize) {
+        if let Ok(mut inner) = self.inner.lock() {
+            inner.max_bytes = max_bytes;
+            Self::evict_to_budget(&mut inner);
+        }
+    }
+
+    /// Look up a document by id, refreshing its LRU position on hit
+    pub fn get(&self, id: &Uuid) -> Option<Document> {
+        let mut inner = self.inner.lock().ok()?;
+
+        if let Some(entry) = inner.entries.get_mut(id) {
+            entry.last_used = self.use_counter.fetch_add(1, Ordering::Relaxed);
+            self.hits.fetch_add(1, Ordering::Relaxed);
+            return Some(entry.document.clone());
+        }
+
+        self.misses.fetch_add(1, Ordering::Relaxed);
+        None
+    }
+
+    /// Snapshot a document's invalidation state before reading it from the
+    /// database, for a later [`insert_if_current`](Self::insert_if_current)
+    pub fn read_generation(&self, id: &Uuid) -> ReadGeneration {
+        match self.inner.lock() {
+            Ok(inner) => ReadGeneration {
+                epoch: inner.epoch,
+                id_generation: inner.generations.get(id).copied().unwrap_or(0),
+            },
+            // A poisoned lock can never match a live generation
+            Err(_) => ReadGeneration {
+                epoch: u64::MAX,
+                id_generation: u64::MAX,
+            },
+        }
+    }
+
+    /// Insert a document read at `generation`, unless the id was
+    /// invalidated since: a write that committed between the snapshot and
+    /// this insert means the read may predate the write, and caching it
+    /// would serve the old content indefinitely
+    pub fn insert_if_current(&self, document: &Document, generation: ReadGeneration) {
+        let mut inner = match self.inner.lock() {
+            Ok(inner) => inner,
+            Err(_) => return,
+        };
+
+        let current = ReadGeneration {
+            epoch: inner.epoch,
+            id_generation: inner.generations.get(&document.id).copied().unwrap_or(0),
+        };
+        if current != generation {
+            return;
+        }
+
+        Self::insert_locked(&mut inner, document, &self.use_counter);
+    }
+
+    /// Insert (or refresh) a document, evicting LRU entries over budget.
+    /// An existing entry is only replaced if the revision is not older.
+    pub fn insert(&self, document: &Document) {
+        let mut inner = match self.inner.lock() {
+            Ok(inner) => inner,
+            Err(_) => return,
+        };
+        Self::insert_locked(&mut inner, document, &self.use_counter);
+    }
+
+    fn insert_locked(inner: &mut CacheInner, document: &Document, use_counter: &AtomicU64) {
+        if inner.max_bytes == 0 {
+            return;
+        }
+
+        if let Some(existing) = inner.entries.get(&document.id) {
+            if existing.document.sync_revision > document.sync_revision {
+                return;
+            }
+        }
+
+        let size_bytes = Self::entry_size(document);
+        if size_bytes > inner.max_bytes {
+            return; // Larger than the whole budget - never cacheable
+        }
+
+        let entry = CacheEntry {
+            document: document.clone(),
+            size_bytes,
+            last_used: use_counter.fetch_add(1, Ordering::Relaxed),
+        };
+
+        if let Some(old) = inner.entries.insert(document.id, entry) {
+            inner.total_bytes -= old.size_bytes;
+        }
+        inner.total_bytes += size_bytes;
+
+        Self::evict_to_budget(inner);
+    }
+
+    /// Remove a single document (called before and after any write or delete)
+    ///
+    /// Also bumps the id's generation counter so that an
+    /// [`insert_if_current`](Self::insert_if_current) holding an older
+    /// [`ReadGeneration`] is rejected.
+    pub fn invalidate(&self, id: &Uuid) {
+        if let Ok(mut inner) = self.inner.lock() {
+            if let Some(entry) = inner.entries.remove(id) {
+                inner.total_bytes -= entry.size_bytes;
+            }
+            *inner.generations.entry(*id).or_insert(0) += 1;
+        }
+    }
+
+    /// Remove all entries (e.g. after a full sync rewrites many documents)
+    ///
+    /// Bumps the epoch rather than every per-id counter: the ids of
+    /// documents the cache has never seen can't be enumerated here, but
+    /// their in-flight reads must be rejected all the same.
+    pub fn clear(&self) {
+        if let Ok(mut inner) = self.inner.lock() {
+            inner.entries.clear();
+            inner.total_bytes = 0;
+            inner.epoch += 1;
+        }
+    }
+
+    /// Number of cache hits since creation
+    pub fn hit_count(&self) -> u64 {
+        self.hits.load(Ordering::Relaxed)
+    }
+
+    /// Number of cache misses since creation
+    pub fn miss_count(&self) -> u64 {
+        self.misses.load(Ordering::Relaxed)
+    }
+
+    /// Current approximate size of all cached entries in bytes
+    pub fn size_bytes(&self) -> usize {
+        self.inner.lock().map(|inner| inner.total_bytes).unwrap_or(0)
+    }
+
+    fn entry_size(document: &Document) -> usize {
+        let content_len = serde_json::to_string(&document.content)
+            .map(|s| s.len())
+            .unwrap_or(0);
+        content_len + ENTRY_OVERHEAD_BYTES
+    }
+
+    fn evict_to_budget(inner: &mut CacheInner) {
+        if inner.max_bytes == 0 {
+            inner.entries.clear();
+            inner.total_bytes = 0;
+            return;
+        }
+
+        while inner.total_bytes > inner.max_bytes {
+            let lru_id = inner
+                .entries
+                .iter()
+                .min_by_key(|(_, entry)| entry.last_used)
+                .map(|(id, _)| *id);
+
+            match lru_id {
+                Some(id) => {
+                    if let Some(entry) = inner.entries.remove(&id) {
+                        inner.total_bytes -= entry.size_bytes;
+                    }
+                }
+                None => break,
+            }
+        }
+    }
+}
+
+impl Default for DocumentCache {
+    fn default() -> Self {
+        Self::new(DEFAULT_CACHE_BUDGET_BYTES)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use serde_json::json;
+
+    fn test_document(content: serde_json::Value, sync_revision: i64) -> Document {
+        Document {
+            id: Uuid::new_v4(),
+            user_id: Uuid::new_v4(),
+            content,
+            sync_revision,
+            content_hash: None,
+            title: None,
+            created_at: chrono::Utc::now(),
+            updated_at: chrono::Utc::now(),
+            deleted_at: None,
+        }
+    }
+
+    #[test]
+    fn test_cache_hit_and_miss() {
+        let cache = DocumentCache::default();
+        let doc = test_document(json!({"title": "Hot"}), 1);
+
+        assert!(cache.get(&doc.id).is_none());
+        assert_eq!(cache.miss_count(), 1);
+
+        cache.insert(&doc);
+        let hit = cache.get(&doc.id).unwrap();
+        assert_eq!(hit.id, doc.id);
+        assert_eq!(cache.hit_count(), 1);
+    }
+
+    #[test]
+    fn test_invalidation_removes_entry() {
+        let cache = DocumentCache::default();
+        let doc = test_document(json!({"title": "Stale"}), 1);
+
+        cache.insert(&doc);
+        cache.invalidate(&doc.id);
+        assert!(cache.get(&doc.id).is_none());
+        assert_eq!(cache.size_bytes(), 0);
+    }
+
+    #[test]
+    fn test_older_revision_does_not_replace_newer() {
+        let cache = DocumentCache::default();
+        let mut doc = test_document(json!({"title": "v2"}), 2);
+
+        cache.insert(&doc);
+
+        doc.sync_revision = 1;
+        doc.content = json!({"title": "v1"});
+        cache.insert(&doc);
+
+        let hit = cache.get(&doc.id).unwrap();
+        assert_eq!(hit.sync_revision, 2);
+    }
+
+    #[test]
+    fn test_byte_budget_evicts_lru() {
+        // Budget fits roughly two entries (content + overhead)
+        let cache = DocumentCache::new(2 * (ENTRY_OVERHEAD_BYTES + 64));
+
+        let doc1 = test_document(json!({"n": 1}), 1);
+        let doc2 = test_document(json!({"n": 2}), 1);
+        let doc3 = test_document(json!({"n": 3}), 1);
+
+        cache.insert(&doc1);
+        cache.insert(&doc2);
+
+        // Touch doc1 so doc2 becomes LRU
+        cache.get(&doc1.id);
+
+        cache.insert(&doc3);
+
+        assert!(cache.get(&doc1.id).is_some());
+        assert!(cache.get(&doc2.id).is_none());
+        assert!(cache.get(&doc3.id).is_some());
+    }
+
+    #[test]
+    fn test_insert_if_current_rejects_stale_read() {
+        let cache = DocumentCache::default();
+        let doc = test_document(json!({"title": "Racing"}), 1);
+
+        // A read that raced a write: invalidated after the generation
+        // snapshot but before the insert must not be cached
+        let generation = cache.read_generation(&doc.id);
+        cache.invalidate(&doc.id);
+        cache.insert_if_current(&doc, generation);
+        assert!(cache.get(&doc.id).is_none());
+
+        // An undisturbed read caches normally
+        let generation = cache.read_generation(&doc.id);
+        cache.insert_if_current(&doc, generation);
+        assert!(cache.get(&doc.id).is_some());
+    }
+
+    #[test]
+    fn test_clear_invalidates_in_flight_reads() {
+        let cache = DocumentCache::default();
+        let doc = test_document(json!({"title": "Swept"}), 1);
+
+        // clear() can't know this id, so the epoch must reject it
+        let generation = cache.read_generation(&doc.id);
+        cache.clear();
+        cache.insert_if_current(&doc, generation);
+        assert!(cache.get(&doc.id).is_none());
+    }
+
+    #[test]
+    fn test_zero_budget_disables_caching() {
+        let cache = DocumentCache::new(0);
+        let doc = test_document(json!({"title": "Uncached"}), 1);
+
+        cache.insert(&doc);
+        assert!(cache.get(&doc.id).is_none());
+
+        // Shrinking to zero clears existing entries too
+        let cache = DocumentCache::default();
+        cache.insert(&doc);
+        cache.set_budget(0);
+        assert!(cache.get(&doc.id).is_none());
+    }
+}
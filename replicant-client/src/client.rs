@@ -1,9 +1,16 @@
-use crate::{database::ClientDatabase, events::EventDispatcher, websocket::WebSocketClient};
+use crate::{
+    database::{BatchDocumentWrite, ClientDatabase, DatabaseOptions},
+    events::EventDispatcher,
+    metrics::MetricsSnapshot,
+    upload_scheduler::{self, UploadJob, MAX_INFLIGHT_UPLOADS},
+    websocket::WebSocketClient,
+};
 use replicant_core::{
+    checksums::{calculate_checksum_with, update_checksum, ChecksumAlgorithm},
     errors::ClientError,
     models::{Document, SyncStatus},
     patches::{apply_patch, create_patch},
-    protocol::{ClientMessage, ServerMessage},
+    protocol::{ChangeEvent, ChangeEventType, ClientMessage, ServerMessage},
     SyncResult,
 };
 use sqlx::Row;
@@ -13,12 +20,16 @@ use std::sync::{
     Arc,
 };
 use std::time::{Duration, Instant};
-use tokio::sync::{mpsc, Mutex, Notify};
+use tokio::sync::{mpsc, Mutex, Notify, Semaphore};
 use uuid::Uuid;
 
 // Ping intervals for heartbeat detection
 const PING_INTERVAL: Duration = Duration::from_secs(10); // Send ping every 10 seconds
 
+// Full-sync batches are written by a bounded pool of apply workers so
+// network receive overlaps the local multi-row transactions
+const SYNC_APPLY_WORKERS: u32 = 4;
+
 #[derive(Debug, Clone)]
 struct PendingUpload {
     operation_type: UploadType,
@@ -32,6 +43,16 @@ enum UploadType {
     Delete,
 }
 
+/// State needed to resume a server session without re-authenticating:
+/// the token from `AuthSuccess` plus the change-stream high-water mark
+#[derive(Debug, Clone, Copy)]
+struct SessionState {
+    session_id: Uuid,
+    last_sequence: u64,
+}
+
+type SharedSessionState = Arc<Mutex<Option<SessionState>>>;
+
 pub struct Client {
     db: Arc<ClientDatabase>,
     ws_client: Arc<Mutex<Option<WebSocketClient>>>,
@@ -40,7 +61,12 @@ pub struct Client {
     message_rx: Option<mpsc::Receiver<ServerMessage>>,
     event_dispatcher: Arc<EventDispatcher>,
     pending_uploads: Arc<Mutex<HashMap<Uuid, PendingUpload>>>,
+    // Fires once when the pending-upload set drains to empty; waiters that
+    // need the all-clear (protection-mode exit, retry pass) wait on this
     upload_complete_notifier: Arc<Notify>,
+    // Fires on every confirmation; the bounded-window dispatcher waits on
+    // this for a slot to open without implying the set is empty
+    upload_window_notifier: Arc<Notify>,
     sync_protection_mode: Arc<AtomicBool>,
     is_connected: Arc<AtomicBool>,
     last_ping_time: Arc<Mutex<Option<Instant>>>,
@@ -53,6 +79,18 @@ pub struct Client {
     reconnect_sync_rx: Option<mpsc::Receiver<()>>,
     // Queue for deferred sync messages during upload protection
     deferred_messages: Arc<Mutex<Vec<ServerMessage>>>,
+    // Resume token + last applied sequence for one-round-trip reconnects
+    session_state: SharedSessionState,
+    // Set once the server confirms xxHash3 checksums in AuthSuccess; until
+    // then outgoing hashes stay SHA-256 so pre-negotiation servers keep
+    // working
+    use_xxh3_checksum: Arc<AtomicBool>,
+    // Where the cold-start snapshot lives (None for in-memory databases);
+    // see crate::snapshot
+    snapshot_path: Option<std::path::PathBuf>,
+    // Bounded pool of full-sync apply workers. Per client, so concurrent
+    // clients in one process don't share (or drain) each other's pool
+    sync_apply_permits: Arc<Semaphore>,
 }
 
 impl Client {
@@ -63,7 +101,27 @@ impl Client {
         api_key: &str,
         api_secret: &str,
     ) -> SyncResult<Self> {
-        let db = Arc::new(ClientDatabase::new(database_url).await?);
+        Self::new_with_options(
+            database_url,
+            server_url,
+            email,
+            api_key,
+            api_secret,
+            &DatabaseOptions::default(),
+        )
+        .await
+    }
+
+    /// Like [`Client::new`] but with an explicit SQLite performance profile
+    pub async fn new_with_options(
+        database_url: &str,
+        server_url: &str,
+        email: &str,
+        api_key: &str,
+        api_secret: &str,
+        db_options: &DatabaseOptions,
+    ) -> SyncResult<Self> {
+        let db = Arc::new(ClientDatabase::new_with_options(database_url, db_options).await?);
         db.run_migrations().await?;
 
         // Ensure user_config exists with deterministic user ID based on email
@@ -117,6 +175,7 @@ impl Client {
             event_dispatcher: event_dispatcher.clone(),
             pending_uploads: Arc::new(Mutex::new(HashMap::new())),
             upload_complete_notifier: Arc::new(Notify::new()),
+            upload_window_notifier: Arc::new(Notify::new()),
             sync_protection_mode: Arc::new(AtomicBool::new(false)),
             is_connected: is_connected,
             last_ping_time: Arc::new(Mutex::new(initial_ping_time)),
@@ -127,6 +186,10 @@ impl Client {
             reconnect_sync_tx,
             reconnect_sync_rx: Some(reconnect_sync_rx),
             deferred_messages: Arc::new(Mutex::new(Vec::new())),
+            session_state: Arc::new(Mutex::new(None)),
+            use_xxh3_checksum: Arc::new(AtomicBool::new(false)),
+            snapshot_path: crate::snapshot::snapshot_path(database_url),
+            sync_apply_permits: Arc::new(Semaphore::new(SYNC_APPLY_WORKERS as usize)),
         };
 
         // Automatically start background tasks
@@ -139,6 +202,16 @@ impl Client {
         self.event_dispatcher.clone()
     }
 
+    /// Checksum algorithm negotiated with the server (SHA-256 until the
+    /// server confirms xxHash3 in `AuthSuccess`)
+    fn checksum_algorithm(&self) -> ChecksumAlgorithm {
+        if self.use_xxh3_checksum.load(Ordering::Relaxed) {
+            ChecksumAlgorithm::Xxh3
+        } else {
+            ChecksumAlgorithm::Sha256
+        }
+    }
+
     async fn spawn_background_tasks(&mut self) -> SyncResult<()> {
         // Take the receiver - can only start once
         let rx = self
@@ -156,9 +229,13 @@ impl Client {
         let event_dispatcher = self.event_dispatcher.clone();
         let pending_uploads = self.pending_uploads.clone();
         let upload_complete_notifier = self.upload_complete_notifier.clone();
+        let upload_window_notifier = self.upload_window_notifier.clone();
         let sync_protection_mode = self.sync_protection_mode.clone();
         let ws_client = self.ws_client.clone();
         let deferred_messages = self.deferred_messages.clone();
+        let session_state = self.session_state.clone();
+        let use_xxh3_checksum = self.use_xxh3_checksum.clone();
+        let sync_apply_permits = self.sync_apply_permits.clone();
 
         // Clone variables for the reconnection sync handler
         let db_for_reconnect_sync = db.clone();
@@ -166,6 +243,7 @@ impl Client {
         let ws_client_for_reconnect_sync = ws_client.clone();
 
         self.start_reconnection_loop();
+        self.start_snapshot_writer();
 
         // Spawn message handler with upload tracking
         tokio::spawn(async move {
@@ -184,8 +262,12 @@ impl Client {
                     &event_dispatcher,
                     &pending_uploads,
                     &upload_complete_notifier,
+                    &upload_window_notifier,
                     &sync_protection_mode,
                     &deferred_messages,
+                    &session_state,
+                    &use_xxh3_checksum,
+                    &sync_apply_permits,
                 )
                 .await
                 {
@@ -283,7 +365,17 @@ impl Client {
                 );
 
                 tokio::select! {
-                    _ = self.upload_complete_notifier.notified() => {
+                    _ = async {
+                        // A permit stored from an earlier drain can wake us
+                        // early; only trust the all-clear once the set is
+                        // actually empty
+                        loop {
+                            self.upload_complete_notifier.notified().await;
+                            if self.pending_uploads.lock().await.is_empty() {
+                                break;
+                            }
+                        }
+                    } => {
                         tracing::info!("CLIENT {}: All uploads confirmed successfully", self.client_id);
                     }
                     _ = tokio::time::sleep(tokio::time::Duration::from_secs(10)) => {
@@ -410,11 +502,20 @@ impl Client {
         // Create patch for sync
         let patch = create_patch(&old_content, &new_content)?;
 
+        // Calculate hash of old content for optimistic locking, reusing the
+        // stored hash when we have one
+        let old_content_hash = doc
+            .content_hash
+            .take()
+            .unwrap_or_else(|| calculate_checksum_with(&old_content, self.checksum_algorithm()));
+
         // Update document
         doc.content = new_content.clone();
         // DON'T increment version locally - server is authoritative for versions
         // Server will increment atomically and broadcast back to all clients
-        doc.content_hash = None; // Will be recalculated
+        // Carry the hash forward incrementally when the algorithm allows it;
+        // None falls back to full recalculation on demand
+        doc.content_hash = update_checksum(&old_content_hash, &old_content, &doc.content, &patch);
         doc.updated_at = chrono::Utc::now();
 
         tracing::info!(
@@ -425,12 +526,8 @@ impl Client {
 
         // CRITICAL: Atomically save document and queue patch
         // This prevents data loss if app crashes between operations
-        use replicant_core::patches::calculate_checksum;
         use replicant_core::protocol::ChangeEventType;
 
-        // Calculate hash of old content for optimistic locking
-        let old_content_hash = calculate_checksum(&old_content);
-
         tracing::info!(
             "CLIENT {}: 📋 Atomically saving document and queueing patch for doc {}",
             self.client_id,
@@ -537,6 +634,170 @@ impl Client {
         Ok(())
     }
 
+    /// Update a document by applying an RFC-6902 patch directly
+    ///
+    /// Callers that already know which fields changed (e.g. editors) can
+    /// hand us the patch instead of the full new content, skipping the
+    /// full-document diff that `update_document` performs on every call.
+    pub async fn update_document_with_patch(
+        &self,
+        id: Uuid,
+        patch: json_patch::Patch,
+    ) -> SyncResult<()> {
+        use replicant_core::protocol::ChangeEventType;
+
+        let mut doc = self.db.get_document(&id).await?;
+        let old_content = doc.content.clone();
+
+        tracing::info!(
+            "CLIENT {}: 📝 Applying patch with {} operations to document {}",
+            self.client_id,
+            patch.0.len(),
+            id
+        );
+
+        // Hash of old content for optimistic locking, reusing the stored hash
+        let old_content_hash = doc
+            .content_hash
+            .take()
+            .unwrap_or_else(|| calculate_checksum_with(&old_content, self.checksum_algorithm()));
+
+        // Apply the caller-supplied patch - no diffing required
+        apply_patch(&mut doc.content, &patch)?;
+
+        // DON'T increment version locally - server is authoritative for versions
+        doc.content_hash = update_checksum(&old_content_hash, &old_content, &doc.content, &patch);
+        doc.updated_at = chrono::Utc::now();
+
+        // CRITICAL: Atomically save document and queue patch, same as update_document
+        self.db
+            .save_document_and_queue_patch(
+                &doc,
+                &patch,
+                ChangeEventType::Update,
+                Some(old_content_hash),
+            )
+            .await?;
+
+        // Emit event
+        self.event_dispatcher
+            .emit_document_updated(&doc.id, &doc.content);
+
+        // Attempt immediate sync if connected
+        if let Err(e) = self.try_immediate_sync(&doc).await {
+            tracing::warn!(
+                "CLIENT {}: ⚠️  OFFLINE EDIT - Failed to immediately sync patched document {}: {}. Changes saved locally for later sync.",
+                self.client_id,
+                doc.id,
+                e
+            );
+        }
+
+        Ok(())
+    }
+
+    /// Apply a batch of (id, content) writes in a single database transaction
+    ///
+    /// Each operation is an upsert: documents that already exist locally are
+    /// updated (with a patch queued for sync), new ids are created. All writes
+    /// commit atomically, avoiding the per-call transaction overhead of
+    /// creating or updating documents one at a time.
+    pub async fn write_batch(
+        &self,
+        operations: Vec<(Uuid, serde_json::Value)>,
+    ) -> SyncResult<Vec<Document>> {
+        use crate::database::BatchDocumentWrite;
+        use replicant_core::protocol::ChangeEventType;
+
+        tracing::info!(
+            "CLIENT {}: 📦 Writing batch of {} documents",
+            self.client_id,
+            operations.len()
+        );
+
+        let mut writes = Vec::with_capacity(operations.len());
+        let mut created = Vec::new();
+
+        for (id, new_content) in operations {
+            match self.db.get_document(&id).await {
+                Ok(mut doc) => {
+                    // Existing document - update semantics
+                    let old_content = doc.content.clone();
+                    let patch = create_patch(&old_content, &new_content)?;
+                    let old_content_hash = doc.content_hash.take().unwrap_or_else(|| {
+                        calculate_checksum_with(&old_content, self.checksum_algorithm())
+                    });
+
+                    doc.content = new_content;
+                    doc.content_hash =
+                        update_checksum(&old_content_hash, &old_content, &doc.content, &patch);
+                    doc.updated_at = chrono::Utc::now();
+
+                    writes.push(BatchDocumentWrite {
+                        document: doc,
+                        sync_status: Some(SyncStatus::Pending),
+                        queue: Some((patch, ChangeEventType::Update, Some(old_content_hash))),
+                    });
+                }
+                Err(_) => {
+                    // New document - create semantics
+                    let doc = Document {
+                        id,
+                        user_id: self.user_id,
+                        content: new_content,
+                        sync_revision: 1,
+                        content_hash: None,
+                        title: None,
+                        created_at: chrono::Utc::now(),
+                        updated_at: chrono::Utc::now(),
+                        deleted_at: None,
+                    };
+
+                    created.push(doc.id);
+                    writes.push(BatchDocumentWrite {
+                        document: doc,
+                        sync_status: Some(SyncStatus::Pending),
+                        queue: None,
+                    });
+                }
+            }
+        }
+
+        self.db.write_documents_batch(&writes).await?;
+
+        let documents: Vec<Document> = writes.into_iter().map(|w| w.document).collect();
+
+        // Emit events and attempt immediate sync per document (the expensive
+        // part - the local transaction - is already done in one shot above)
+        for doc in &documents {
+            if created.contains(&doc.id) {
+                self.event_dispatcher
+                    .emit_document_created(&doc.id, &doc.content);
+            } else {
+                self.event_dispatcher
+                    .emit_document_updated(&doc.id, &doc.content);
+            }
+
+            if let Err(e) = self.try_immediate_sync(doc).await {
+                tracing::warn!(
+                    "CLIENT {}: Failed to immediately sync batched document {}: {}. Will retry later.",
+                    self.client_id,
+                    doc.id,
+                    e
+                );
+            }
+        }
+
+        tracing::info!(
+            "CLIENT {}: ✅ Batch write complete ({} created, {} updated)",
+            self.client_id,
+            created.len(),
+            documents.len() - created.len()
+        );
+
+        Ok(documents)
+    }
+
     pub async fn delete_document(&self, id: Uuid) -> SyncResult<()> {
         // Mark as deleted locally first
         self.db.delete_document(&id).await?;
@@ -597,6 +858,14 @@ impl Client {
         Ok(pending_docs.len())
     }
 
+    /// Point-in-time snapshot of the always-on metrics registry
+    /// (see `crate::metrics`)
+    pub fn metrics(&self) -> MetricsSnapshot {
+        self.db
+            .metrics
+            .snapshot(self.event_dispatcher.pending_event_count())
+    }
+
     async fn sync_pending_documents(&self) -> SyncResult<()> {
         let pending_docs = self.db.get_pending_documents().await?;
         // Also check sync_queue for debugging
@@ -667,28 +936,117 @@ impl Client {
             pending_docs.len()
         );
 
-        // Show details of each pending document
-        for (i, pending_info) in pending_docs.iter().enumerate() {
-            if let Ok(doc) = self.db.get_document(&pending_info.id).await {
+        // Load each pending document and rank the batch: recently-touched
+        // documents first, small documents interleaved between large ones
+        let total_pending = pending_docs.len();
+        let mut jobs = Vec::with_capacity(total_pending);
+        for (i, pending_info) in pending_docs.into_iter().enumerate() {
+            match self.db.get_document(&pending_info.id).await {
+                Ok(doc) => {
+                    tracing::info!(
+                        "CLIENT {}: PENDING {}/{}: doc_id={}, content={:?}, version={}",
+                        self.client_id,
+                        i + 1,
+                        total_pending,
+                        pending_info.id,
+                        doc.content,
+                        doc.sync_revision
+                    );
+                    let size_bytes = doc.content.to_string().len();
+                    jobs.push(UploadJob {
+                        info: pending_info,
+                        document: doc,
+                        size_bytes,
+                    });
+                }
+                Err(e) => {
+                    tracing::error!(
+                        "CLIENT {}: Failed to get pending document {}: {}",
+                        self.client_id,
+                        pending_info.id,
+                        e
+                    );
+                }
+            }
+        }
+
+        for job in upload_scheduler::schedule(jobs) {
+            let pending_info = job.info;
+            let doc = job.document;
+
+            // Ordering is preserved per document id: never race a second
+            // upload for a document that's already awaiting confirmation
+            if Self::has_pending_upload(&self.pending_uploads, &pending_info.id).await {
+                tracing::debug!(
+                    "CLIENT {}: Upload already in flight for doc {}, skipping",
+                    self.client_id,
+                    pending_info.id
+                );
+                continue;
+            }
+
+            // Bounded in-flight window: independent documents travel
+            // concurrently, but wait for acknowledgements once the window
+            // is full so a large backlog doesn't flood the socket
+            loop {
+                if self.pending_uploads.lock().await.len() < MAX_INFLIGHT_UPLOADS {
+                    break;
+                }
+                if tokio::time::timeout(
+                    Duration::from_secs(5),
+                    self.upload_window_notifier.notified(),
+                )
+                .await
+                .is_err()
+                {
+                    tracing::warn!(
+                        "CLIENT {}: Upload window full and no acknowledgements for 5s, proceeding",
+                        self.client_id
+                    );
+                    break;
+                }
+            }
+
+            // A send for a document that was never confirmed counts as a retry
+            self.db.metrics.note_upload_sent(&pending_info.id);
+
+            let upload_type = if pending_info.is_deleted {
+                // Handle pending delete
                 tracing::info!(
-                    "CLIENT {}: PENDING {}/{}: doc_id={}, content={:?}, version={}",
+                    "CLIENT {}: Uploading pending delete for doc {}",
                     self.client_id,
-                    i + 1,
-                    pending_docs.len(),
+                    pending_info.id
+                );
+
+                // Track this upload
+                self.pending_uploads.lock().await.insert(
                     pending_info.id,
-                    doc.content,
-                    doc.sync_revision
+                    PendingUpload {
+                        operation_type: UploadType::Delete,
+                        sent_at: Instant::now(),
+                    },
                 );
-            }
-        }
 
-        for pending_info in pending_docs {
-            match self.db.get_document(&pending_info.id).await {
-                Ok(doc) => {
-                    let upload_type = if pending_info.is_deleted {
-                        // Handle pending delete
+                let ws_client = self.ws_client.lock().await;
+                if let Some(client) = ws_client.as_ref() {
+                    client
+                        .send(ClientMessage::DeleteDocument {
+                            document_id: pending_info.id,
+                        })
+                        .await?;
+                } else {
+                    return Err(ClientError::WebSocket("Not connected".to_string()))?;
+                }
+
+                UploadType::Delete
+            } else {
+                // Check if we have a patch stored in sync_queue to determine if this is create or update
+                // With server-authoritative versioning, we can't rely on version number anymore
+                match self.db.get_queued_patch(&pending_info.id).await? {
+                    Some((stored_patch, old_hash_opt)) => {
+                        // Have a queued patch = this is an UPDATE
                         tracing::info!(
-                            "CLIENT {}: Uploading pending delete for doc {}",
+                            "CLIENT {}: 📋 Found stored patch in sync_queue for doc {} - treating as UPDATE",
                             self.client_id,
                             pending_info.id
                         );
@@ -697,127 +1055,80 @@ impl Client {
                         self.pending_uploads.lock().await.insert(
                             pending_info.id,
                             PendingUpload {
-                                operation_type: UploadType::Delete,
+                                operation_type: UploadType::Update,
                                 sent_at: Instant::now(),
                             },
                         );
 
+                        // Use the stored patch for UpdateDocument
+                        use replicant_core::models::DocumentPatch;
+                        use replicant_core::patches::calculate_checksum;
+
+                        let content_hash =
+                            old_hash_opt.unwrap_or_else(|| calculate_checksum(&doc.content));
+
+                        let document_patch = DocumentPatch {
+                            document_id: pending_info.id,
+                            patch: stored_patch,
+                            content_hash,
+                        };
+
                         let ws_client = self.ws_client.lock().await;
                         if let Some(client) = ws_client.as_ref() {
+                            tracing::info!(
+                                "CLIENT {}: ✅ Sending UpdateDocument with stored patch",
+                                self.client_id
+                            );
                             client
-                                .send(ClientMessage::DeleteDocument {
-                                    document_id: pending_info.id,
+                                .send(ClientMessage::UpdateDocument {
+                                    patch: document_patch,
                                 })
                                 .await?;
                         } else {
                             return Err(ClientError::WebSocket("Not connected".to_string()))?;
                         }
 
-                        UploadType::Delete
-                    } else {
-                        // Check if we have a patch stored in sync_queue to determine if this is create or update
-                        // With server-authoritative versioning, we can't rely on version number anymore
-                        match self.db.get_queued_patch(&pending_info.id).await? {
-                            Some((stored_patch, old_hash_opt)) => {
-                                // Have a queued patch = this is an UPDATE
-                                tracing::info!(
-                                    "CLIENT {}: 📋 Found stored patch in sync_queue for doc {} - treating as UPDATE",
-                                    self.client_id,
-                                    pending_info.id
-                                );
-
-                                // Track this upload
-                                self.pending_uploads.lock().await.insert(
-                                    pending_info.id,
-                                    PendingUpload {
-                                        operation_type: UploadType::Update,
-                                        sent_at: Instant::now(),
-                                    },
-                                );
-
-                                // Use the stored patch for UpdateDocument
-                                use replicant_core::models::DocumentPatch;
-                                use replicant_core::patches::calculate_checksum;
-
-                                let content_hash = old_hash_opt
-                                    .unwrap_or_else(|| calculate_checksum(&doc.content));
-
-                                let document_patch = DocumentPatch {
-                                    document_id: pending_info.id,
-                                    patch: stored_patch,
-                                    content_hash,
-                                };
-
-                                let ws_client = self.ws_client.lock().await;
-                                if let Some(client) = ws_client.as_ref() {
-                                    tracing::info!(
-                                        "CLIENT {}: ✅ Sending UpdateDocument with stored patch",
-                                        self.client_id
-                                    );
-                                    client
-                                        .send(ClientMessage::UpdateDocument {
-                                            patch: document_patch,
-                                        })
-                                        .await?;
-                                } else {
-                                    return Err(ClientError::WebSocket(
-                                        "Not connected".to_string(),
-                                    ))?;
-                                }
-
-                                UploadType::Update
-                            }
-                            None => {
-                                // No queued patch = this is a CREATE
-                                tracing::info!(
-                                    "CLIENT {}: No queued patch found for doc {} - treating as CREATE",
-                                    self.client_id,
-                                    pending_info.id
-                                );
-
-                                // Track this upload
-                                self.pending_uploads.lock().await.insert(
-                                    pending_info.id,
-                                    PendingUpload {
-                                        operation_type: UploadType::Create,
-                                        sent_at: Instant::now(),
-                                    },
-                                );
+                        UploadType::Update
+                    }
+                    None => {
+                        // No queued patch = this is a CREATE
+                        tracing::info!(
+                            "CLIENT {}: No queued patch found for doc {} - treating as CREATE",
+                            self.client_id,
+                            pending_info.id
+                        );
 
-                                let ws_client = self.ws_client.lock().await;
-                                if let Some(client) = ws_client.as_ref() {
-                                    client
-                                        .send(ClientMessage::CreateDocument {
-                                            document: doc.clone(),
-                                        })
-                                        .await?;
-                                } else {
-                                    return Err(ClientError::WebSocket(
-                                        "Not connected".to_string(),
-                                    ))?;
-                                }
+                        // Track this upload
+                        self.pending_uploads.lock().await.insert(
+                            pending_info.id,
+                            PendingUpload {
+                                operation_type: UploadType::Create,
+                                sent_at: Instant::now(),
+                            },
+                        );
 
-                                UploadType::Create
-                            }
+                        let ws_client = self.ws_client.lock().await;
+                        if let Some(client) = ws_client.as_ref() {
+                            client
+                                .send(ClientMessage::CreateDocument {
+                                    document: doc.clone(),
+                                })
+                                .await?;
+                        } else {
+                            return Err(ClientError::WebSocket("Not connected".to_string()))?;
                         }
-                    };
 
-                    tracing::debug!(
-                        "CLIENT {}: Tracked upload for document {} ({:?})",
-                        self.client_id,
-                        pending_info.id,
-                        upload_type
-                    );
-                }
-                Err(e) => {
-                    tracing::error!(
-                        "CLIENT {}: Failed to get pending document {}: {}",
-                        self.client_id,
-                        pending_info.id,
-                        e
-                    );
+                        UploadType::Create
+                    }
                 }
-            }
+            };
+
+            tracing::debug!(
+                "CLIENT {}: Tracked upload for document {} ({:?})",
+                self.client_id,
+                pending_info.id,
+                upload_type
+            );
         }
 
         tracing::info!(
@@ -836,10 +1147,175 @@ impl Client {
         event_dispatcher: &Arc<EventDispatcher>,
         pending_uploads: &Arc<Mutex<HashMap<Uuid, PendingUpload>>>,
         upload_complete_notifier: &Arc<Notify>,
+        upload_window_notifier: &Arc<Notify>,
         sync_protection_mode: &Arc<AtomicBool>,
         deferred_messages: &Arc<Mutex<Vec<ServerMessage>>>,
+        session_state: &SharedSessionState,
+        use_xxh3_checksum: &Arc<AtomicBool>,
+        sync_apply_permits: &Arc<Semaphore>,
     ) -> SyncResult<()> {
         match &msg {
+            // Capture the resume token so reconnects can skip the handshake
+            ServerMessage::AuthSuccess {
+                session_id,
+                checksum,
+                ..
+            } => {
+                // Adopt the negotiated checksum algorithm (and drop back to
+                // SHA-256 if a reconnect lands on a server without it)
+                use replicant_core::checksums::ChecksumAlgorithm;
+                use_xxh3_checksum.store(
+                    *checksum == Some(ChecksumAlgorithm::Xxh3),
+                    Ordering::Relaxed,
+                );
+
+                let mut state = session_state.lock().await;
+                let last_sequence = state.map(|s| s.last_sequence).unwrap_or(0);
+                *state = Some(SessionState {
+                    session_id: *session_id,
+                    last_sequence,
+                });
+                tracing::info!(
+                    "CLIENT {}: Stored resumable session token {}",
+                    client_id,
+                    session_id
+                );
+                return Ok(());
+            }
+
+            // An expired or rejected token: drop it so the next reconnect
+            // goes through the full handshake
+            ServerMessage::AuthError { reason } => {
+                if session_state.lock().await.take().is_some() {
+                    tracing::warn!(
+                        "CLIENT {}: Session resume rejected ({}), will re-authenticate",
+                        client_id,
+                        reason
+                    );
+                }
+                event_dispatcher.emit_sync_error(&format!("Authentication failed: {}", reason));
+                return Ok(());
+            }
+
+            // Replayed change stream after a session resume
+            ServerMessage::Changes { events, .. } => {
+                for event in events {
+                    // The replay includes edits this client uploaded before
+                    // disconnecting; our own content already contains them,
+                    // so applying the patch again would double-apply it
+                    if event.origin_client_id == Some(client_id) {
+                        tracing::debug!(
+                            "CLIENT {}: Skipping own change event {} during replay",
+                            client_id,
+                            event.sequence
+                        );
+                        continue;
+                    }
+                    if let Err(e) =
+                        Self::apply_change_event(event, db, client_id, event_dispatcher).await
+                    {
+                        tracing::error!(
+                            "CLIENT {}: Failed to apply change event {}: {}",
+                            client_id,
+                            event.sequence,
+                            e
+                        );
+                    }
+                }
+
+                // Advance the resume cursor to the last delivered event
+                if let Some(last) = events.last() {
+                    let mut state = session_state.lock().await;
+                    if let Some(s) = state.as_mut() {
+                        s.last_sequence = s.last_sequence.max(last.sequence);
+                    }
+                }
+                return Ok(());
+            }
+
+            // Our cursor predates the server's compaction horizon: the
+            // per-edit events are gone, so current documents stand in for
+            // the replay and we fast-forward the cursor
+            ServerMessage::Snapshot {
+                documents,
+                latest_sequence,
+            } => {
+                tracing::info!(
+                    "CLIENT {}: Received snapshot of {} documents (fast-forward to seq {})",
+                    client_id,
+                    documents.len(),
+                    latest_sequence
+                );
+
+                for document in documents {
+                    let existed = db.get_document(&document.id).await.is_ok();
+                    if let Err(e) = db
+                        .save_document_with_status(document, Some(SyncStatus::Synced))
+                        .await
+                    {
+                        tracing::error!(
+                            "CLIENT {}: Failed to apply snapshot document {}: {}",
+                            client_id,
+                            document.id,
+                            e
+                        );
+                        continue;
+                    }
+                    if existed {
+                        event_dispatcher.emit_document_updated(&document.id, &document.content);
+                    } else {
+                        event_dispatcher.emit_document_created(&document.id, &document.content);
+                    }
+                }
+
+                // The snapshot is the complete set of live documents, so a
+                // synced local document missing from it was deleted on the
+                // server while we were past the compaction horizon (the
+                // per-edit delete events are gone). Drop those here; pending
+                // local documents are kept - the server never saw them
+                let snapshot_ids: std::collections::HashSet<Uuid> =
+                    documents.iter().map(|d| d.id).collect();
+                match db.get_synced_document_ids().await {
+                    Ok(local_ids) => {
+                        for id in local_ids {
+                            if snapshot_ids.contains(&id) {
+                                continue;
+                            }
+                            tracing::info!(
+                                "CLIENT {}: Snapshot omits synced doc {} - deleting locally",
+                                client_id,
+                                id
+                            );
+                            if let Err(e) = db.delete_document(&id).await {
+                                tracing::error!(
+                                    "CLIENT {}: Failed to delete doc {} absent from snapshot: {}",
+                                    client_id,
+                                    id,
+                                    e
+                                );
+                                continue;
+                            }
+                            // Mark synced so the deletion isn't re-uploaded
+                            db.mark_synced(&id).await?;
+                            event_dispatcher.emit_document_deleted(&id);
+                        }
+                    }
+                    Err(e) => {
+                        tracing::error!(
+                            "CLIENT {}: Failed to reconcile snapshot deletions: {}",
+                            client_id,
+                            e
+                        );
+                    }
+                }
+
+                let mut state = session_state.lock().await;
+                if let Some(s) = state.as_mut() {
+                    s.last_sequence = s.last_sequence.max(*latest_sequence);
+                }
+                return Ok(());
+            }
+
             // Handle upload confirmations first
             ServerMessage::DocumentCreatedResponse {
                 document_id,
@@ -861,6 +1337,7 @@ impl Client {
                     let mut uploads = pending_uploads.lock().await;
                     if let Some(upload) = uploads.remove(document_id) {
                         let elapsed = upload.sent_at.elapsed();
+                        db.metrics.note_upload_confirmed(document_id, elapsed);
                         tracing::info!(
                             "CLIENT {}: Upload confirmed for {} ({:?}) in {:?}",
                             client_id,
@@ -869,7 +1346,11 @@ impl Client {
                             elapsed
                         );
 
-                        // If this was the last pending upload, notify
+                        // A single slot opening is enough for the bounded-
+                        // window dispatcher, but the all-clear waiters must
+                        // only wake once the whole set has drained - they
+                        // drop sync protection when they do
+                        upload_window_notifier.notify_one();
                         if uploads.is_empty() {
                             tracing::info!(
                                 "CLIENT {}: All uploads confirmed - notifying completion",
@@ -898,6 +1379,7 @@ impl Client {
                         );
                     }
                 } else {
+                    db.metrics.note_upload_failed();
                     tracing::error!(
                         "CLIENT {}: Upload failed for document {}",
                         client_id,
@@ -909,6 +1391,61 @@ impl Client {
                 return Self::handle_server_message(msg, db, client_id, event_dispatcher).await;
             }
 
+            // Full-sync batches: hand off to a bounded apply worker so the
+            // receive loop keeps draining the socket while earlier batches
+            // are still being written. Batches from one full sync never
+            // share documents, so they can land in any order; revision
+            // checks inside the apply keep newer local copies intact.
+            ServerMessage::SyncBatch {
+                documents,
+                batch_index,
+                total_batches,
+            } => {
+                let documents = documents.clone();
+                let batch_index = *batch_index;
+                let total_batches = *total_batches;
+                let db = db.clone();
+                let event_dispatcher = event_dispatcher.clone();
+
+                // Acquire the permit here, before spawning, so a
+                // SyncComplete that follows this batch can never collect
+                // all permits while the batch task is still unscheduled
+                let permit = sync_apply_permits
+                    .clone()
+                    .acquire_owned()
+                    .await
+                    .expect("sync apply semaphore is never closed");
+
+                tokio::spawn(async move {
+                    let _permit = permit;
+                    tracing::info!(
+                        "CLIENT {}: Applying sync batch {}/{} ({} documents)",
+                        client_id,
+                        batch_index + 1,
+                        total_batches,
+                        documents.len()
+                    );
+                    if let Err(e) =
+                        Self::apply_sync_batch(documents, &db, client_id, &event_dispatcher).await
+                    {
+                        tracing::error!(
+                            "CLIENT {}: Failed to apply sync batch {}: {}",
+                            client_id,
+                            batch_index,
+                            e
+                        );
+                    }
+                });
+                return Ok(());
+            }
+
+            // Let every in-flight batch write finish before reporting the
+            // sync as complete
+            ServerMessage::SyncComplete { .. } => {
+                let _all = sync_apply_permits.acquire_many(SYNC_APPLY_WORKERS).await;
+                return Self::handle_server_message(msg, db, client_id, event_dispatcher).await;
+            }
+
             // Apply protection for sync messages during upload phase
             ServerMessage::SyncDocument { document } => {
                 // Check if we're in protection mode
@@ -1026,6 +1563,127 @@ impl Client {
         uploads.contains_key(document_id)
     }
 
+    /// Apply one full-sync batch in a single multi-row transaction
+    ///
+    /// Per-document ordering only matters where revisions say so: anything
+    /// older than the local copy is skipped, everything else is upserted as
+    /// synced in one write.
+    async fn apply_sync_batch(
+        documents: Vec<Document>,
+        db: &Arc<ClientDatabase>,
+        client_id: Uuid,
+        event_dispatcher: &Arc<EventDispatcher>,
+    ) -> SyncResult<()> {
+        let mut writes = Vec::with_capacity(documents.len());
+        let mut applied_events = Vec::with_capacity(documents.len());
+
+        for document in documents {
+            let existed = match db.get_document(&document.id).await {
+                Ok(local) => {
+                    if document.sync_revision < local.sync_revision {
+                        tracing::debug!(
+                            "CLIENT {}: Skipping batch doc {} (local v{} > server v{})",
+                            client_id,
+                            document.id,
+                            local.sync_revision,
+                            document.sync_revision
+                        );
+                        continue;
+                    }
+                    true
+                }
+                Err(_) => false,
+            };
+
+            applied_events.push((document.id, document.content.clone(), existed));
+            writes.push(BatchDocumentWrite {
+                document,
+                sync_status: Some(SyncStatus::Synced),
+                queue: None,
+            });
+        }
+
+        db.write_documents_batch(&writes).await?;
+
+        for (document_id, content, existed) in applied_events {
+            if existed {
+                event_dispatcher.emit_document_updated(&document_id, &content);
+            } else {
+                event_dispatcher.emit_document_created(&document_id, &content);
+            }
+        }
+
+        tracing::info!(
+            "CLIENT {}: Applied {} documents from sync batch",
+            client_id,
+            writes.len()
+        );
+
+        Ok(())
+    }
+
+    /// Apply a single replayed event from the server's change stream
+    ///
+    /// Create events carry the full document, update events a JSON patch,
+    /// delete events only the document id.
+    async fn apply_change_event(
+        event: &ChangeEvent,
+        db: &Arc<ClientDatabase>,
+        client_id: Uuid,
+        event_dispatcher: &Arc<EventDispatcher>,
+    ) -> SyncResult<()> {
+        match event.event_type {
+            ChangeEventType::Create => {
+                let Some(doc_json) = &event.forward_patch else {
+                    return Ok(());
+                };
+                let document: Document = serde_json::from_value(doc_json.clone())?;
+                tracing::info!(
+                    "CLIENT {}: Replaying create for doc {} (seq {})",
+                    client_id,
+                    document.id,
+                    event.sequence
+                );
+                db.save_document_with_status(&document, Some(SyncStatus::Synced))
+                    .await?;
+                event_dispatcher.emit_document_created(&document.id, &document.content);
+            }
+            ChangeEventType::Update => {
+                let Some(patch_json) = &event.forward_patch else {
+                    return Ok(());
+                };
+                let patch: json_patch::Patch = serde_json::from_value(patch_json.clone())?;
+                let mut doc = db.get_document(&event.document_id).await?;
+                apply_patch(&mut doc.content, &patch)?;
+                // Each update event corresponds to one server-side revision bump
+                doc.sync_revision += 1;
+                doc.updated_at = event.created_at;
+                tracing::info!(
+                    "CLIENT {}: Replaying update for doc {} (seq {})",
+                    client_id,
+                    event.document_id,
+                    event.sequence
+                );
+                db.save_document_with_status(&doc, Some(SyncStatus::Synced))
+                    .await?;
+                event_dispatcher.emit_document_updated(&doc.id, &doc.content);
+            }
+            ChangeEventType::Delete => {
+                tracing::info!(
+                    "CLIENT {}: Replaying delete for doc {} (seq {})",
+                    client_id,
+                    event.document_id,
+                    event.sequence
+                );
+                db.delete_document(&event.document_id).await?;
+                db.mark_synced(&event.document_id).await?;
+                event_dispatcher.emit_document_deleted(&event.document_id);
+            }
+        }
+
+        Ok(())
+    }
+
     async fn handle_server_message(
         msg: ServerMessage,
         db: &Arc<ClientDatabase>,
@@ -1323,6 +1981,11 @@ impl Client {
                 }
             }
 
+            ServerMessage::Pong => {
+                // One heartbeat round trip completed; feed the RTT summary
+                db.metrics.record_pong();
+            }
+
             _ => {}
         }
 
@@ -1371,7 +2034,15 @@ impl Client {
             );
 
             tokio::select! {
-                _ = self.upload_complete_notifier.notified() => {
+                _ = async {
+                    // Same stale-permit guard as the initial upload wait
+                    loop {
+                        self.upload_complete_notifier.notified().await;
+                        if self.pending_uploads.lock().await.is_empty() {
+                            break;
+                        }
+                    }
+                } => {
                     tracing::info!("CLIENT {}: All retry uploads confirmed", self.client_id);
                 }
                 _ = tokio::time::sleep(tokio::time::Duration::from_secs(5)) => {
@@ -1553,6 +2224,56 @@ impl Client {
         }
     }
 
+    /// Keep the cold-start snapshot fresh in the background
+    ///
+    /// Every interval the library fingerprint (count + latest update) is
+    /// compared against the last written one; only when it changed are the
+    /// documents read and the snapshot rewritten. `replicant_open_snapshot`
+    /// serves app launches from the resulting file before the engine is up.
+    fn start_snapshot_writer(&self) {
+        let Some(path) = self.snapshot_path.clone() else {
+            return;
+        };
+        let db = self.db.clone();
+        let client_id = self.client_id;
+
+        tokio::spawn(async move {
+            const SNAPSHOT_INTERVAL: Duration = Duration::from_secs(30);
+            let mut last_fingerprint = None;
+
+            loop {
+                match db.library_fingerprint().await {
+                    Ok(fingerprint) => {
+                        if last_fingerprint.as_ref() != Some(&fingerprint) {
+                            let result = match db.get_all_documents().await {
+                                Ok(docs) => crate::snapshot::write_snapshot(&path, &docs),
+                                Err(e) => Err(e),
+                            };
+                            match result {
+                                Ok(()) => last_fingerprint = Some(fingerprint),
+                                Err(e) => tracing::warn!(
+                                    "CLIENT {}: Failed to write snapshot {}: {}",
+                                    client_id,
+                                    path.display(),
+                                    e
+                                ),
+                            }
+                        }
+                    }
+                    Err(e) => {
+                        tracing::warn!(
+                            "CLIENT {}: Failed to fingerprint library for snapshot: {}",
+                            client_id,
+                            e
+                        );
+                    }
+                }
+
+                tokio::time::sleep(SNAPSHOT_INTERVAL).await;
+            }
+        });
+    }
+
     /// Start the reconnection loop if not already running
     fn start_reconnection_loop(&self) {
         let is_connected = self.is_connected.clone();
@@ -1566,10 +2287,14 @@ impl Client {
         let db = self.db.clone();
         let pending_uploads = self.pending_uploads.clone();
         let upload_complete_notifier = self.upload_complete_notifier.clone();
+        let upload_window_notifier = self.upload_window_notifier.clone();
         let reconnect_sync_tx = self.reconnect_sync_tx.clone();
         let sync_protection_mode = self.sync_protection_mode.clone();
         let last_ping_time = self.last_ping_time.clone();
         let deferred_messages = self.deferred_messages.clone();
+        let session_state = self.session_state.clone();
+        let use_xxh3_checksum = self.use_xxh3_checksum.clone();
+        let sync_apply_permits = self.sync_apply_permits.clone();
 
         tracing::info!(
             "🔄 CLIENT {}: Starting continuous reconnection monitor (5-second intervals)",
@@ -1592,18 +2317,44 @@ impl Client {
                         server_url
                     );
 
-                    // Try to connect
-                    match WebSocketClient::connect(
-                        &server_url,
-                        &email,
-                        client_id,
-                        &api_key,
-                        &api_secret,
-                        Some(event_dispatcher.clone()),
-                        is_connected.clone(),
-                    )
-                    .await
-                    {
+                    // Resume the previous session in one round trip when we
+                    // hold a token; otherwise run the full handshake. A
+                    // rejected token comes back as AuthError, which clears
+                    // the stored state so the next attempt re-authenticates.
+                    let resume_attempt = { *session_state.lock().await };
+                    let connection_result = match resume_attempt {
+                        Some(session) => {
+                            tracing::info!(
+                                "CLIENT {}: Attempting session resume (token {}, last seq {})",
+                                client_id,
+                                session.session_id,
+                                session.last_sequence
+                            );
+                            WebSocketClient::resume(
+                                &server_url,
+                                client_id,
+                                session.session_id,
+                                session.last_sequence,
+                                Some(event_dispatcher.clone()),
+                                is_connected.clone(),
+                            )
+                            .await
+                        }
+                        None => {
+                            WebSocketClient::connect(
+                                &server_url,
+                                &email,
+                                client_id,
+                                &api_key,
+                                &api_secret,
+                                Some(event_dispatcher.clone()),
+                                is_connected.clone(),
+                            )
+                            .await
+                        }
+                    };
+
+                    match connection_result {
                         Ok((new_client, receiver)) => {
                             tracing::info!(
                                 "✅ CLIENT {}: Reconnection successful after {} attempts!",
@@ -1650,8 +2401,12 @@ impl Client {
                             let event_dispatcher_clone = event_dispatcher.clone();
                             let pending_uploads_clone = pending_uploads.clone();
                             let upload_complete_notifier_clone = upload_complete_notifier.clone();
+                            let upload_window_notifier_clone = upload_window_notifier.clone();
                             let sync_protection_mode_clone = sync_protection_mode.clone();
                             let deferred_messages_clone = deferred_messages.clone();
+                            let session_state_clone = session_state.clone();
+                            let use_xxh3_checksum_clone = use_xxh3_checksum.clone();
+                            let sync_apply_permits_clone = sync_apply_permits.clone();
                             let handler_is_connected = is_connected.clone();
                             let handler_client_id = client_id;
                             let handler_server_url = server_url.clone();
@@ -1664,8 +2419,12 @@ impl Client {
                                         &event_dispatcher_clone,
                                         &pending_uploads_clone,
                                         &upload_complete_notifier_clone,
+                                        &upload_window_notifier_clone,
                                         &sync_protection_mode_clone,
                                         &deferred_messages_clone,
+                                        &session_state_clone,
+                                        &use_xxh3_checksum_clone,
+                                        &sync_apply_permits_clone,
                                     )
                                     .await
                                     {
@@ -1692,24 +2451,42 @@ impl Client {
                                 }
                             }
 
-                            // Trigger pending sync on the real sync engine via channel
-                            // This will upload any pending documents and THEN request full sync
-                            tracing::info!(
-                                "📤 CLIENT {}: Triggering post-reconnection sync on real engine",
-                                client_id
-                            );
+                            // When we resumed a session the server already
+                            // replayed the change stream, so the upload +
+                            // full-sync pass is only needed if offline edits
+                            // are actually waiting
+                            let skip_full_sync = resume_attempt.is_some()
+                                && db
+                                    .get_pending_documents()
+                                    .await
+                                    .map(|pending| pending.is_empty())
+                                    .unwrap_or(false);
 
-                            if let Err(e) = reconnect_sync_tx.try_send(()) {
-                                tracing::error!(
-                                    "CLIENT {}: Failed to trigger reconnection sync: {}",
-                                    client_id,
-                                    e
+                            if skip_full_sync {
+                                tracing::info!(
+                                    "✅ CLIENT {}: Session resumed with no pending uploads - skipping full sync pass",
+                                    client_id
                                 );
                             } else {
+                                // Trigger pending sync on the real sync engine via channel
+                                // This will upload any pending documents and THEN request full sync
                                 tracing::info!(
-                                    "✅ CLIENT {}: Reconnection sync trigger sent to real engine",
+                                    "📤 CLIENT {}: Triggering post-reconnection sync on real engine",
                                     client_id
                                 );
+
+                                if let Err(e) = reconnect_sync_tx.try_send(()) {
+                                    tracing::error!(
+                                        "CLIENT {}: Failed to trigger reconnection sync: {}",
+                                        client_id,
+                                        e
+                                    );
+                                } else {
+                                    tracing::info!(
+                                        "✅ CLIENT {}: Reconnection sync trigger sent to real engine",
+                                        client_id
+                                    );
+                                }
                             }
                             // The pending sync handler will request full sync after uploads complete
                         }
@@ -1748,6 +2525,8 @@ impl Client {
                                 match client.send(ClientMessage::Ping).await {
                                     Ok(_) => {
                                         // Ping successful, update last ping time
+                                        // and start the RTT clock for the pong
+                                        db.metrics.mark_ping_sent();
                                         *last_ping_time.lock().await = Some(Instant::now());
                                         tracing::info!("✅ CLIENT {}: Heartbeat ping successful - connection alive", client_id);
                                     }
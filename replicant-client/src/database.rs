@@ -1,3 +1,5 @@
+use crate::cache::DocumentCache;
+use crate::metrics::Metrics;
 use crate::queries::{DbHelpers, Queries};
 use json_patch;
 use replicant_core::protocol::ChangeEventType;
@@ -5,7 +7,15 @@ use replicant_core::{
     models::{Document, SyncStatus},
     SyncResult,
 };
-use sqlx::{sqlite::SqlitePoolOptions, Row, SqlitePool};
+use sqlx::{
+    sqlite::{SqliteConnectOptions, SqliteJournalMode, SqlitePoolOptions, SqliteSynchronous},
+    Row, SqlitePool,
+};
+use std::collections::HashSet;
+use std::str::FromStr;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::Arc;
+use std::time::{Duration, Instant};
 use uuid::Uuid;
 
 #[derive(Debug, Clone, PartialEq)]
@@ -14,18 +24,216 @@ pub struct PendingDocumentInfo {
     pub is_deleted: bool,
 }
 
+/// Lightweight document projection for list views
+///
+/// Carries only the columns a document browser needs (id, title,
+/// sync_revision, updated_at), so listing documents never deserializes
+/// or copies content bodies.
+#[derive(Debug, Clone, PartialEq, serde::Serialize)]
+pub struct DocumentMetadata {
+    pub id: Uuid,
+    pub title: Option<String>,
+    pub sync_revision: i64,
+    pub updated_at: chrono::DateTime<chrono::Utc>,
+}
+
+/// One ranked search hit projected to id/title/rank/snippet
+///
+/// Built for search-as-you-type result lists: no content bodies cross
+/// the boundary, the snippet comes from FTS5's built-in snippet()
+/// (matches wrapped in `<b>`/`</b>`), and `rank` is the bm25 score —
+/// lower means more relevant.
+#[derive(Debug, Clone, PartialEq, serde::Serialize)]
+pub struct SearchHit {
+    pub id: Uuid,
+    pub title: Option<String>,
+    pub rank: f64,
+    pub snippet: String,
+}
+
+/// A single write within a batched document transaction
+///
+/// Bundles the document to upsert with the sync-queue entry (patch,
+/// operation type, optional old content hash) that should be recorded
+/// alongside it. `queue` is `None` for writes that should not be synced
+/// back to the server (e.g. documents applied from the server).
+pub struct BatchDocumentWrite {
+    pub document: Document,
+    pub sync_status: Option<SyncStatus>,
+    pub queue: Option<(json_patch::Patch, ChangeEventType, Option<String>)>,
+}
+
+/// Outcome of a bulk NDJSON import (see `import_documents`)
+#[derive(Debug, Clone, Copy, Default, PartialEq)]
+pub struct ImportReport {
+    pub imported: u64,
+    /// Lines that could not be parsed as a document and were skipped
+    pub failed: u64,
+}
+
+/// Documents written per transaction during bulk import
+const IMPORT_BATCH_SIZE: usize = 500;
+
+/// Debounce window before queued FTS updates are flushed to the index
+const FTS_DEBOUNCE: Duration = Duration::from_millis(200);
+
+/// Deferred FTS maintenance state (see `ClientDatabase::queue_fts_update`)
+///
+/// Saves mark documents dirty here instead of rewriting their FTS5 rows
+/// inline; a debounced flush folds any number of saves of one document
+/// into a single index write, and searches flush first so queries never
+/// observe a stale index.
+#[derive(Debug, Default)]
+struct FtsQueue {
+    dirty: std::sync::Mutex<HashSet<Uuid>>,
+    flush_scheduled: AtomicBool,
+}
+
+impl FtsQueue {
+    /// Drain the dirty set and rewrite each document's index row in one
+    /// transaction. Failed flushes put the ids back so a later flush
+    /// retries them.
+    async fn flush(queue: &Arc<FtsQueue>, pool: &SqlitePool) -> SyncResult<()> {
+        let ids: Vec<Uuid> = {
+            let mut dirty = queue.dirty.lock().unwrap();
+            dirty.drain().collect()
+        };
+        if ids.is_empty() {
+            return Ok(());
+        }
+
+        if let Err(e) = Self::write_rows(&ids, pool).await {
+            queue.dirty.lock().unwrap().extend(ids);
+            return Err(e);
+        }
+        Ok(())
+    }
+
+    async fn write_rows(ids: &[Uuid], pool: &SqlitePool) -> SyncResult<()> {
+        // Skip entirely when no search paths are configured
+        let has_config: (i32,) = sqlx::query_as(Queries::HAS_SEARCH_CONFIG)
+            .fetch_one(pool)
+            .await?;
+        if has_config.0 == 0 {
+            return Ok(());
+        }
+
+        let mut tx = pool.begin().await?;
+        for id in ids {
+            let doc_id_str = id.to_string();
+
+            sqlx::query(Queries::DELETE_FTS_ENTRY)
+                .bind(&doc_id_str)
+                .execute(&mut *tx)
+                .await?;
+
+            // Insert new entry (query handles deleted_at check internally)
+            sqlx::query(Queries::UPDATE_FTS_ENTRY)
+                .bind(&doc_id_str)
+                .execute(&mut *tx)
+                .await?;
+        }
+        tx.commit().await?;
+
+        tracing::debug!("FTS: Flushed {} queued index updates", ids.len());
+        Ok(())
+    }
+}
+
+/// Tunable SQLite performance profile applied when the pool is created
+///
+/// The defaults mirror what `ClientDatabase::new` has always done, so
+/// existing callers see no behavior change; hosts on slow storage
+/// (spinning-disk Windows machines in particular) can relax durability
+/// and grow the page cache / mmap window to cut save latency. A zero
+/// value leaves the corresponding SQLite default untouched.
+#[derive(Debug, Clone)]
+pub struct DatabaseOptions {
+    pub journal_mode: SqliteJournalMode,
+    pub synchronous: SqliteSynchronous,
+    /// Database page size in bytes; only takes effect before the first
+    /// write to a fresh database file
+    pub page_size_bytes: u32,
+    /// Page-cache budget in KiB (applied as a negative `cache_size`)
+    pub cache_size_kib: i64,
+    /// Memory-mapped I/O window in bytes
+    pub mmap_size_bytes: i64,
+    pub busy_timeout: Duration,
+    /// Connections in the pool
+    pub max_connections: u32,
+    /// Per-connection prepared-statement cache, which keeps the hot
+    /// queries in `queries.rs` from being re-prepared on every call
+    pub statement_cache_capacity: usize,
+}
+
+impl Default for DatabaseOptions {
+    fn default() -> Self {
+        Self {
+            journal_mode: SqliteJournalMode::Wal,
+            synchronous: SqliteSynchronous::Full,
+            page_size_bytes: 0,
+            cache_size_kib: 0,
+            mmap_size_bytes: 0,
+            busy_timeout: Duration::from_secs(5),
+            max_connections: 5,
+            statement_cache_capacity: 100,
+        }
+    }
+}
+
 pub struct ClientDatabase {
     pub pool: SqlitePool,
+    /// In-process read cache for `get_document` (see `crate::cache`)
+    pub(crate) cache: DocumentCache,
+    /// Shared metrics registry; the sync engine records its upload and
+    /// transport counters into the same instance (see `crate::metrics`)
+    pub(crate) metrics: Arc<Metrics>,
+    /// Dirty-id queue for debounced FTS maintenance (see `queue_fts_update`)
+    fts_queue: Arc<FtsQueue>,
 }
 
 impl ClientDatabase {
     pub async fn new(database_url: &str) -> SyncResult<Self> {
+        Self::new_with_options(database_url, &DatabaseOptions::default()).await
+    }
+
+    /// Open the database with an explicit performance profile
+    pub async fn new_with_options(
+        database_url: &str,
+        options: &DatabaseOptions,
+    ) -> SyncResult<Self> {
+        let mut connect = SqliteConnectOptions::from_str(database_url)?
+            .journal_mode(options.journal_mode)
+            .synchronous(options.synchronous)
+            .busy_timeout(options.busy_timeout)
+            .statement_cache_capacity(options.statement_cache_capacity);
+        if options.page_size_bytes > 0 {
+            connect = connect.page_size(options.page_size_bytes);
+        }
+        if options.cache_size_kib > 0 {
+            connect = connect.pragma("cache_size", format!("-{}", options.cache_size_kib));
+        }
+        if options.mmap_size_bytes > 0 {
+            connect = connect.pragma("mmap_size", options.mmap_size_bytes.to_string());
+        }
+
         let pool = SqlitePoolOptions::new()
-            .max_connections(5)
-            .connect(database_url)
+            .max_connections(options.max_connections)
+            .connect_with(connect)
             .await?;
 
-        Ok(Self { pool })
+        Ok(Self {
+            pool,
+            cache: DocumentCache::default(),
+            metrics: Arc::new(Metrics::new()),
+            fts_queue: Arc::new(FtsQueue::default()),
+        })
+    }
+
+    /// Set the byte budget of the in-process document read cache.
+    /// A budget of 0 disables caching entirely.
+    pub fn set_document_cache_budget(&self, max_bytes: usize) {
+        self.cache.set_budget(max_bytes);
     }
 
     pub async fn run_migrations(&self) -> SyncResult<()> {
@@ -130,12 +338,26 @@ impl ClientDatabase {
     }
 
     pub async fn get_document(&self, id: &Uuid) -> SyncResult<Document> {
+        // Serve repeat reads from the in-process cache when possible
+        if let Some(doc) = self.cache.get(id) {
+            return Ok(doc);
+        }
+
+        // Snapshot the invalidation state first: if a write to this id
+        // lands while the SELECT is in flight, the insert below is
+        // rejected rather than caching a potentially stale row
+        let generation = self.cache.read_generation(id);
+
+        let started = Instant::now();
         let row = sqlx::query(Queries::GET_DOCUMENT)
             .bind(id.to_string())
             .fetch_one(&self.pool)
             .await?;
+        self.metrics.db_query.record(started.elapsed());
 
-        DbHelpers::parse_document(&row)
+        let doc = DbHelpers::parse_document(&row)?;
+        self.cache.insert_if_current(&doc, generation);
+        Ok(doc)
     }
 
     pub async fn save_document(&self, doc: &Document) -> SyncResult<()> {
@@ -158,8 +380,11 @@ impl ClientDatabase {
             doc.sync_revision
         );
 
+        self.cache.invalidate(&doc.id);
+
         let params = DbHelpers::document_to_params(doc, sync_status)?;
 
+        let started = Instant::now();
         sqlx::query(Queries::UPSERT_DOCUMENT)
             .bind(params.0) // id
             .bind(params.1) // user_id
@@ -170,15 +395,19 @@ impl ClientDatabase {
             .bind(params.6) // deleted_at
             .bind(params.7) // sync_status
             .bind(params.8) // title
+            .bind(params.9) // content_hash
             .execute(&self.pool)
             .await?;
+        self.metrics.db_query.record(started.elapsed());
+
+        // Invalidate again now that the write is committed: a read that
+        // raced the write may otherwise have re-inserted the old row
+        self.cache.invalidate(&doc.id);
 
         tracing::info!("DATABASE: ✅ Document {} saved successfully", doc.id);
 
-        // Update FTS index for this document
-        if let Err(e) = self.update_fts_for_document(&doc.id).await {
-            tracing::warn!("FTS: Failed to update index for {}: {:?}", doc.id, e);
-        }
+        // Defer the FTS index write off the save path
+        self.queue_fts_update(&doc.id);
 
         Ok(())
     }
@@ -214,6 +443,25 @@ impl ClientDatabase {
         Ok(pending_docs)
     }
 
+    /// Ids of all non-deleted documents the server has confirmed (synced)
+    ///
+    /// Used to reconcile a checkpoint snapshot against local state:
+    /// a synced document missing from the snapshot was deleted server-side.
+    pub async fn get_synced_document_ids(&self) -> SyncResult<Vec<Uuid>> {
+        let rows =
+            sqlx::query("SELECT id FROM documents WHERE deleted_at IS NULL AND sync_status = ?")
+                .bind(SyncStatus::Synced.to_string())
+                .fetch_all(&self.pool)
+                .await?;
+
+        let mut ids = Vec::with_capacity(rows.len());
+        for row in rows {
+            let id: String = row.try_get("id")?;
+            ids.push(Uuid::parse_str(&id)?);
+        }
+        Ok(ids)
+    }
+
     pub async fn mark_synced(&self, document_id: &Uuid) -> SyncResult<()> {
         tracing::info!("DATABASE: 🔄 Marking document {} as synced", document_id);
 
@@ -243,12 +491,16 @@ impl ClientDatabase {
             sync_revision
         );
 
+        self.cache.invalidate(document_id);
+
         let result = sqlx::query("UPDATE documents SET sync_revision = ? WHERE id = ?")
             .bind(sync_revision)
             .bind(document_id.to_string())
             .execute(&self.pool)
             .await?;
 
+        self.cache.invalidate(document_id);
+
         tracing::info!(
             "DATABASE: ✅ Updated {} sync_revision, rows affected: {}",
             document_id,
@@ -259,6 +511,8 @@ impl ClientDatabase {
     }
 
     pub async fn delete_document(&self, document_id: &Uuid) -> SyncResult<()> {
+        self.cache.invalidate(document_id);
+
         sqlx::query("UPDATE documents SET deleted_at = ?, sync_status = ? WHERE id = ?")
             .bind(chrono::Utc::now())
             .bind(SyncStatus::Pending.to_string())
@@ -266,23 +520,91 @@ impl ClientDatabase {
             .execute(&self.pool)
             .await?;
 
-        // Remove from FTS index
-        if let Err(e) = self.update_fts_for_document(document_id).await {
-            tracing::warn!("FTS: Failed to remove {} from index: {:?}", document_id, e);
-        }
+        self.cache.invalidate(document_id);
+
+        // Queue the FTS row removal (the flush drops deleted documents)
+        self.queue_fts_update(document_id);
 
         Ok(())
     }
 
     pub async fn get_all_documents(&self) -> SyncResult<Vec<Document>> {
+        let started = Instant::now();
         let rows = sqlx::query("SELECT * FROM documents WHERE deleted_at IS NULL")
             .fetch_all(&self.pool)
             .await?;
+        self.metrics.db_query.record(started.elapsed());
 
         rows.into_iter()
             .map(|row| DbHelpers::parse_document(&row))
             .collect()
     }
+    /// Fetch one page of documents using keyset pagination on id
+    ///
+    /// Pass `None` for the first page, then the id of the last document of
+    /// the previous page. Returns at most `limit` documents; an empty Vec
+    /// means the cursor is exhausted. Unlike `get_all_documents` this keeps
+    /// memory flat regardless of how many documents exist.
+    pub async fn get_documents_page(
+        &self,
+        after_id: Option<&Uuid>,
+        limit: i64,
+    ) -> SyncResult<Vec<Document>> {
+        let after = after_id.map(|id| id.to_string()).unwrap_or_default();
+
+        let rows = sqlx::query(Queries::GET_DOCUMENTS_PAGE)
+            .bind(after)
+            .bind(limit)
+            .fetch_all(&self.pool)
+            .await?;
+
+        rows.into_iter()
+            .map(|row| DbHelpers::parse_document(&row))
+            .collect()
+    }
+
+    /// List metadata for all (non-deleted) documents, most recent first
+    ///
+    /// Only projects id, title, sync_revision and updated_at - content
+    /// bodies are never read, so this stays cheap on large databases.
+    pub async fn get_documents_metadata(&self) -> SyncResult<Vec<DocumentMetadata>> {
+        let rows = sqlx::query(Queries::GET_DOCUMENTS_METADATA)
+            .fetch_all(&self.pool)
+            .await?;
+
+        rows.iter().map(Self::parse_document_metadata).collect()
+    }
+
+    fn parse_document_metadata(row: &sqlx::sqlite::SqliteRow) -> SyncResult<DocumentMetadata> {
+        let id: String = row.try_get("id")?;
+        let title: Option<String> = row.try_get("title").ok();
+        let sync_revision: i64 = row
+            .try_get::<i64, _>("sync_revision")
+            .or_else(|_| row.try_get::<i32, _>("sync_revision").map(|v| v as i64))?;
+        let updated_at: String = row.try_get("updated_at")?;
+
+        Ok(DocumentMetadata {
+            id: Uuid::parse_str(&id)?,
+            title,
+            sync_revision,
+            updated_at: chrono::DateTime::parse_from_rfc3339(&updated_at)?
+                .with_timezone(&chrono::Utc),
+        })
+    }
+
+    /// Cheap change detector for the library as a whole: document count
+    /// plus the most recent update timestamp. Used by the snapshot writer
+    /// to skip rewrites when nothing changed.
+    pub async fn library_fingerprint(&self) -> SyncResult<(i64, Option<String>)> {
+        let row = sqlx::query(
+            "SELECT COUNT(*) as count, MAX(updated_at) as latest FROM documents WHERE deleted_at IS NULL",
+        )
+        .fetch_one(&self.pool)
+        .await?;
+
+        Ok((row.try_get("count")?, row.try_get("latest").ok()))
+    }
+
     pub async fn count_documents(&self) -> SyncResult<i64> {
         let count: i64 =
             sqlx::query_scalar("SELECT COUNT(*) FROM documents WHERE deleted_at IS NULL")
@@ -352,6 +674,8 @@ impl ClientDatabase {
         operation_type: ChangeEventType,
         old_content_hash: Option<String>,
     ) -> SyncResult<()> {
+        self.cache.invalidate(&doc.id);
+
         // Start a transaction for atomicity
         let mut tx = self.pool.begin().await?;
 
@@ -368,6 +692,7 @@ impl ClientDatabase {
             .bind(params.6) // deleted_at
             .bind(params.7) // sync_status
             .bind(params.8) // title
+            .bind(params.9) // content_hash
             .execute(&mut *tx)
             .await?;
 
@@ -397,16 +722,226 @@ impl ClientDatabase {
         // Commit atomically - both operations succeed or both fail
         tx.commit().await?;
 
+        // Invalidate again now that the transaction is committed: a read
+        // that raced it may otherwise have re-inserted the old row
+        self.cache.invalidate(&doc.id);
+
         tracing::info!(
             "DATABASE: Atomically saved document {} with pending status and queued patch",
             doc.id
         );
 
-        // Update FTS index for this document
-        if let Err(e) = self.update_fts_for_document(&doc.id).await {
-            tracing::warn!("FTS: Failed to update index for {}: {:?}", doc.id, e);
+        // Defer the FTS index write off the save path
+        self.queue_fts_update(&doc.id);
+
+        Ok(())
+    }
+
+    /// Apply a batch of document writes in a single transaction
+    ///
+    /// Each entry upserts a document and optionally queues a sync operation
+    /// alongside it. All writes commit or roll back together, which avoids
+    /// the per-call transaction overhead of saving documents one at a time
+    /// (important for importers and bulk-edit paths).
+    pub async fn write_documents_batch(&self, writes: &[BatchDocumentWrite]) -> SyncResult<()> {
+        if writes.is_empty() {
+            return Ok(());
+        }
+
+        tracing::info!(
+            "DATABASE: 💾 Writing batch of {} documents in one transaction",
+            writes.len()
+        );
+
+        for write in writes {
+            self.cache.invalidate(&write.document.id);
+        }
+
+        let mut tx = self.pool.begin().await?;
+
+        for write in writes {
+            let params = DbHelpers::document_to_params(&write.document, write.sync_status)?;
+
+            sqlx::query(Queries::UPSERT_DOCUMENT)
+                .bind(params.0) // id
+                .bind(params.1) // user_id
+                .bind(params.2) // content
+                .bind(params.3) // version
+                .bind(params.4) // created_at
+                .bind(params.5) // updated_at
+                .bind(params.6) // deleted_at
+                .bind(params.7) // sync_status
+                .bind(params.8) // title
+                .bind(params.9) // content_hash
+                .execute(&mut *tx)
+                .await?;
+
+            if let Some((patch, operation_type, old_content_hash)) = &write.queue {
+                let patch_json = serde_json::to_string(patch)?;
+
+                if let Some(hash) = old_content_hash {
+                    sqlx::query(
+                        "INSERT INTO sync_queue (document_id, operation_type, patch, old_content_hash) VALUES (?, ?, ?, ?)"
+                    )
+                    .bind(write.document.id.to_string())
+                    .bind(operation_type.to_string())
+                    .bind(patch_json)
+                    .bind(hash)
+                    .execute(&mut *tx)
+                    .await?;
+                } else {
+                    sqlx::query(Queries::INSERT_SYNC_QUEUE)
+                        .bind(write.document.id.to_string())
+                        .bind(operation_type.to_string())
+                        .bind(patch_json)
+                        .execute(&mut *tx)
+                        .await?;
+                }
+            }
+        }
+
+        tx.commit().await?;
+
+        // Invalidate again now that the transaction is committed: reads
+        // that raced it may otherwise have re-inserted the old rows
+        for write in writes {
+            self.cache.invalidate(&write.document.id);
+        }
+
+        tracing::info!(
+            "DATABASE: ✅ Batch of {} documents committed atomically",
+            writes.len()
+        );
+
+        // Defer the FTS index writes off the write path
+        for write in writes {
+            self.queue_fts_update(&write.document.id);
+        }
+
+        Ok(())
+    }
+
+    /// Stream NDJSON documents into the database in large transactions
+    ///
+    /// Each line is one document: either a bare content object (an id is
+    /// generated) or `{"id": "...", "content": {...}}` to preserve ids
+    /// from an export. Unlike per-document creates, the import writes
+    /// `IMPORT_BATCH_SIZE` rows per transaction, skips the per-document
+    /// FTS updates in favor of one `rebuild_fts_index` pass at the end,
+    /// and records no sync-queue entries. Pass `mark_synced` for
+    /// server-seeded imports whose rows must not upload; otherwise rows
+    /// land pending and the next sync pass uploads them as creates.
+    ///
+    /// Unparseable lines are counted in the report and skipped rather
+    /// than aborting a multi-minute import.
+    pub async fn import_documents<R: std::io::BufRead>(
+        &self,
+        reader: R,
+        mark_synced: bool,
+    ) -> SyncResult<ImportReport> {
+        let user_id = self.get_user_id().await?;
+        let status = if mark_synced {
+            SyncStatus::Synced
+        } else {
+            SyncStatus::Pending
+        };
+
+        let mut report = ImportReport::default();
+        let mut batch: Vec<Document> = Vec::with_capacity(IMPORT_BATCH_SIZE);
+
+        for line in reader.lines() {
+            let line = line?;
+            let trimmed = line.trim();
+            if trimmed.is_empty() {
+                continue;
+            }
+
+            let value: serde_json::Value = match serde_json::from_str(trimmed) {
+                Ok(v) => v,
+                Err(e) => {
+                    tracing::warn!("IMPORT: Skipping unparseable line: {}", e);
+                    report.failed += 1;
+                    continue;
+                }
+            };
+
+            let (id, content) = match (value.get("id"), value.get("content")) {
+                (Some(id_value), Some(content)) => {
+                    let Some(id) = id_value.as_str().and_then(|s| Uuid::parse_str(s).ok()) else {
+                        tracing::warn!("IMPORT: Skipping line with invalid id: {}", id_value);
+                        report.failed += 1;
+                        continue;
+                    };
+                    (id, content.clone())
+                }
+                _ => (Uuid::new_v4(), value),
+            };
+
+            let now = chrono::Utc::now();
+            batch.push(Document {
+                id,
+                user_id,
+                content,
+                sync_revision: 1,
+                content_hash: None,
+                title: None,
+                created_at: now,
+                updated_at: now,
+                deleted_at: None,
+            });
+
+            if batch.len() >= IMPORT_BATCH_SIZE {
+                self.import_batch(&batch, status).await?;
+                report.imported += batch.len() as u64;
+                batch.clear();
+            }
+        }
+
+        if !batch.is_empty() {
+            self.import_batch(&batch, status).await?;
+            report.imported += batch.len() as u64;
+        }
+
+        // One FTS pass over the finished table instead of one index
+        // update per imported document
+        self.rebuild_fts_index().await?;
+
+        // Imported rows replace whatever the read cache held
+        self.cache.clear();
+
+        tracing::info!(
+            "IMPORT: ✅ Imported {} documents ({} lines skipped)",
+            report.imported,
+            report.failed
+        );
+
+        Ok(report)
+    }
+
+    async fn import_batch(&self, docs: &[Document], status: SyncStatus) -> SyncResult<()> {
+        let started = Instant::now();
+        let mut tx = self.pool.begin().await?;
+
+        for doc in docs {
+            let params = DbHelpers::document_to_params(doc, Some(status))?;
+
+            sqlx::query(Queries::UPSERT_DOCUMENT)
+                .bind(params.0) // id
+                .bind(params.1) // user_id
+                .bind(params.2) // content
+                .bind(params.3) // version
+                .bind(params.4) // created_at
+                .bind(params.5) // updated_at
+                .bind(params.6) // deleted_at
+                .bind(params.7) // sync_status
+                .bind(params.8) // title
+                .bind(params.9) // content_hash
+                .execute(&mut *tx)
+                .await?;
         }
 
+        tx.commit().await?;
+        self.metrics.db_query.record(started.elapsed());
         Ok(())
     }
 
@@ -463,6 +998,9 @@ impl ClientDatabase {
                 .await?;
         }
 
+        // The inline rebuild below covers everything the queue was holding
+        self.fts_queue.dirty.lock().unwrap().clear();
+
         // Rebuild the index with new configuration (inline to use same transaction)
         sqlx::query(Queries::CLEAR_FTS_INDEX)
             .execute(&mut *tx)
@@ -481,6 +1019,45 @@ impl ClientDatabase {
         Ok(())
     }
 
+    /// Mark a document's FTS row dirty and return immediately
+    ///
+    /// The actual index write happens in a debounced batch off the save
+    /// path: the first enqueue schedules a flush `FTS_DEBOUNCE` later, and
+    /// every save of the same document in that window folds into a single
+    /// index write. Searches call `flush_fts_queue` first, so deferring
+    /// never makes query results stale.
+    fn queue_fts_update(&self, document_id: &Uuid) {
+        self.fts_queue.dirty.lock().unwrap().insert(*document_id);
+
+        if self.fts_queue.flush_scheduled.swap(true, Ordering::AcqRel) {
+            return;
+        }
+
+        let Ok(handle) = tokio::runtime::Handle::try_current() else {
+            // No runtime to debounce on; the ids stay queued for the
+            // next search barrier or enqueue to pick up
+            self.fts_queue
+                .flush_scheduled
+                .store(false, Ordering::Release);
+            return;
+        };
+
+        let queue = self.fts_queue.clone();
+        let pool = self.pool.clone();
+        handle.spawn(async move {
+            tokio::time::sleep(FTS_DEBOUNCE).await;
+            queue.flush_scheduled.store(false, Ordering::Release);
+            if let Err(e) = FtsQueue::flush(&queue, &pool).await {
+                tracing::warn!("FTS: Debounced flush failed: {:?}", e);
+            }
+        });
+    }
+
+    /// Apply every queued FTS update now (flush-before-query barrier)
+    pub async fn flush_fts_queue(&self) -> SyncResult<()> {
+        FtsQueue::flush(&self.fts_queue, &self.pool).await
+    }
+
     /// Update the FTS index entry for a single document.
     /// Call this after creating or updating a document.
     pub async fn update_fts_for_document(&self, document_id: &Uuid) -> SyncResult<()> {
@@ -515,6 +1092,9 @@ impl ClientDatabase {
 
     /// Rebuild the entire FTS index from all documents.
     pub async fn rebuild_fts_index(&self) -> SyncResult<()> {
+        // A full rebuild covers everything the queue was holding
+        self.fts_queue.dirty.lock().unwrap().clear();
+
         // Clear existing index
         sqlx::query(Queries::CLEAR_FTS_INDEX)
             .execute(&self.pool)
@@ -532,14 +1112,108 @@ impl ClientDatabase {
     /// Search documents using FTS5 full-text search.
     /// Returns all documents matching the query.
     pub async fn search_documents(&self, query: &str, limit: i64) -> SyncResult<Vec<Document>> {
+        // Flush-before-query barrier: apply deferred index writes first
+        self.flush_fts_queue().await?;
+
+        let started = Instant::now();
         let rows = sqlx::query(Queries::SEARCH_DOCUMENTS)
             .bind(query)
             .bind(limit)
             .fetch_all(&self.pool)
             .await?;
+        self.metrics.db_query.record(started.elapsed());
 
         rows.into_iter()
             .map(|row| DbHelpers::parse_document(&row))
             .collect()
     }
+
+    /// Search documents using FTS5, returning metadata only
+    ///
+    /// Same matching and ranking as `search_documents`, but projects just
+    /// id/title/sync_revision/updated_at for result list rendering.
+    pub async fn search_documents_metadata(
+        &self,
+        query: &str,
+        limit: i64,
+    ) -> SyncResult<Vec<DocumentMetadata>> {
+        // Flush-before-query barrier: apply deferred index writes first
+        self.flush_fts_queue().await?;
+
+        let rows = sqlx::query(Queries::SEARCH_DOCUMENTS_METADATA)
+            .bind(query)
+            .bind(limit)
+            .fetch_all(&self.pool)
+            .await?;
+
+        rows.iter().map(Self::parse_document_metadata).collect()
+    }
+
+    /// Fetch one bm25-ordered page of full-document search results
+    ///
+    /// Same matching as `search_documents` plus an offset, so result
+    /// lists can page instead of refetching a growing prefix.
+    pub async fn search_documents_page(
+        &self,
+        query: &str,
+        limit: i64,
+        offset: i64,
+    ) -> SyncResult<Vec<Document>> {
+        // Flush-before-query barrier: apply deferred index writes first
+        self.flush_fts_queue().await?;
+
+        let started = Instant::now();
+        let rows = sqlx::query(Queries::SEARCH_DOCUMENTS_PAGE)
+            .bind(query)
+            .bind(limit)
+            .bind(offset)
+            .fetch_all(&self.pool)
+            .await?;
+        self.metrics.db_query.record(started.elapsed());
+
+        rows.into_iter()
+            .map(|row| DbHelpers::parse_document(&row))
+            .collect()
+    }
+
+    /// Fetch one bm25-ordered page of search hits as id/title/rank/snippet
+    ///
+    /// The cheap projection for search-as-you-type: no content bodies are
+    /// read or serialized, and highlighting comes from FTS5's snippet()
+    /// instead of client-side extraction. Fetch full bodies afterwards
+    /// with `get_document` for the hit the user opens.
+    pub async fn search_documents_snippets(
+        &self,
+        query: &str,
+        limit: i64,
+        offset: i64,
+    ) -> SyncResult<Vec<SearchHit>> {
+        // Flush-before-query barrier: apply deferred index writes first
+        self.flush_fts_queue().await?;
+
+        let started = Instant::now();
+        let rows = sqlx::query(Queries::SEARCH_DOCUMENTS_SNIPPETS)
+            .bind(query)
+            .bind(limit)
+            .bind(offset)
+            .fetch_all(&self.pool)
+            .await?;
+        self.metrics.db_query.record(started.elapsed());
+
+        rows.iter()
+            .map(|row| {
+                let id: String = row.try_get("id")?;
+                let title: Option<String> = row.try_get("title").ok();
+                let rank: f64 = row.try_get("rank")?;
+                let snippet: String = row.try_get("snippet")?;
+
+                Ok(SearchHit {
+                    id: Uuid::parse_str(&id)?,
+                    title,
+                    rank,
+                    snippet,
+                })
+            })
+            .collect()
+    }
 }
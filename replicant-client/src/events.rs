@@ -33,10 +33,18 @@
 
 use replicant_core::{errors::ClientError, SyncResult};
 use std::ffi::{c_char, c_void, CString};
+use std::sync::atomic::{AtomicUsize, Ordering};
 use std::sync::{mpsc, Mutex};
 use std::thread::{self, ThreadId};
 use uuid::Uuid;
 
+/// Maximum number of events held in the queue before new events are dropped
+///
+/// The queue itself is the lock-free std mpsc channel (producers never touch
+/// the drain-side mutex), so this bound exists purely to cap memory if the
+/// application stops draining events during a very large sync.
+const EVENT_QUEUE_CAPACITY: usize = 100_000;
+
 /// Event types that can be emitted by the sync client
 #[repr(C)]
 #[derive(Debug, Clone, Copy, PartialEq)]
@@ -270,6 +278,69 @@ pub type ConflictEventCallback = extern "C" fn(
     context: *mut c_void,
 );
 
+/// Completion callback for asynchronous operations (replicant_*_async)
+///
+/// Invoked from `process_events()` on the callback thread once a queued
+/// operation has finished, so the calling thread never waits on I/O.
+///
+/// # Parameters
+/// * `operation_id` - Identifier returned when the operation was enqueued
+/// * `result_code` - ReplicantSyncResult value (0 on success, negative on failure)
+/// * `document_id` - UUID of the affected document (may be null)
+/// * `error` - Error message (null on success)
+/// * `context` - User-defined context pointer
+pub type OperationCompleteCallback = extern "C" fn(
+    operation_id: u64,
+    result_code: i32,
+    document_id: *const c_char,
+    error: *const c_char,
+    context: *mut c_void,
+);
+
+/// A single event record within a batched drain
+///
+/// String fields point into an arena owned by the dispatcher for the
+/// duration of the callback; they are null when not applicable to the
+/// event type and must be copied if they need to outlive the callback.
+#[repr(C)]
+pub struct BatchedEvent {
+    /// The event type (determines which fields below are meaningful)
+    pub event_type: EventType,
+    /// Document UUID (document and conflict events, null otherwise)
+    pub document_id: *const c_char,
+    /// Document title or server URL (connection events), null otherwise
+    pub title: *const c_char,
+    /// Document JSON content / winning conflict content, null otherwise
+    pub content: *const c_char,
+    /// Error message / losing conflict content, null otherwise
+    pub error: *const c_char,
+    /// Document count (sync events) or attempt number (connection events)
+    pub numeric_data: u64,
+    /// Connected flag for connection events
+    pub boolean_data: bool,
+}
+
+/// Batch event callback receiving all drained events in one call
+///
+/// # Parameters
+/// * `events` - Array of event records (valid only for the duration of the call)
+/// * `count` - Number of records in the array
+/// * `context` - User-defined context pointer
+pub type EventBatchCallback =
+    extern "C" fn(events: *const BatchedEvent, count: usize, context: *mut c_void);
+
+/// Notifier fired when the event queue transitions from empty to non-empty
+///
+/// Unlike every other callback, this is invoked from whichever thread
+/// queued the event (typically a sync task), NOT the callback thread. It
+/// must only schedule a wake-up of the drain thread - e.g. trigger a
+/// message-loop update that calls `process_events()` - never drain events
+/// or touch the engine itself.
+///
+/// # Parameters
+/// * `context` - User-defined context pointer
+pub type EventNotifierCallback = extern "C" fn(context: *mut c_void);
+
 // =============================================================================
 // Callback Entry Types (Internal)
 // =============================================================================
@@ -278,6 +349,8 @@ struct DocumentCallbackEntry {
     callback: DocumentEventCallback,
     context: *mut c_void,
     event_filter: Option<EventType>,
+    // When set, only events for these document ids are delivered
+    document_filter: Option<Vec<String>>,
 }
 
 struct SyncCallbackEntry {
@@ -300,6 +373,16 @@ struct ConflictCallbackEntry {
     context: *mut c_void,
 }
 
+struct OperationCallbackEntry {
+    callback: OperationCompleteCallback,
+    context: *mut c_void,
+}
+
+struct NotifierEntry {
+    callback: EventNotifierCallback,
+    context: *mut c_void,
+}
+
 // Safety: Callback entries are only accessed from the registered thread
 unsafe impl Send for DocumentCallbackEntry {}
 unsafe impl Sync for DocumentCallbackEntry {}
@@ -311,6 +394,11 @@ unsafe impl Send for ConnectionCallbackEntry {}
 unsafe impl Sync for ConnectionCallbackEntry {}
 unsafe impl Send for ConflictCallbackEntry {}
 unsafe impl Sync for ConflictCallbackEntry {}
+unsafe impl Send for OperationCallbackEntry {}
+unsafe impl Sync for OperationCallbackEntry {}
+// Safety: the notifier is explicitly documented as callable from any thread
+unsafe impl Send for NotifierEntry {}
+unsafe impl Sync for NotifierEntry {}
 
 // =============================================================================
 // Rust Callback Entry (Internal)
@@ -321,6 +409,16 @@ struct RustCallbackEntry {
     event_filter: Option<EventType>,
 }
 
+/// Completion record for an asynchronous operation, queued until the
+/// callback thread drains it via `process_events()`
+#[derive(Debug, Clone)]
+struct QueuedCompletion {
+    operation_id: u64,
+    result_code: i32,
+    document_id: Option<String>,
+    error: Option<String>,
+}
+
 #[derive(Debug, Clone)]
 pub struct QueuedEvent {
     event_type: EventType,
@@ -377,30 +475,95 @@ pub struct EventDispatcher {
     error_callbacks: Mutex<Vec<ErrorCallbackEntry>>,
     connection_callbacks: Mutex<Vec<ConnectionCallbackEntry>>,
     conflict_callbacks: Mutex<Vec<ConflictCallbackEntry>>,
+    operation_callbacks: Mutex<Vec<OperationCallbackEntry>>,
     // Rust-native callback storage
     rust_callbacks: Mutex<Vec<RustCallbackEntry>>,
     // Event queue
     event_queue: Mutex<mpsc::Receiver<QueuedEvent>>,
     event_sender: mpsc::Sender<QueuedEvent>,
+    // Async operation completion queue (separate from the event queue so
+    // completions cannot be starved by document event traffic)
+    completion_queue: Mutex<mpsc::Receiver<QueuedCompletion>>,
+    completion_sender: mpsc::Sender<QueuedCompletion>,
+    // Number of events currently queued, used to bound the queue without
+    // making producers block or contend with the drain thread
+    queued_event_count: AtomicUsize,
+    // When set, consecutive DocumentUpdated events for the same document
+    // are collapsed into the latest one before delivery
+    coalesce_updates: std::sync::atomic::AtomicBool,
+    // Fired from the producing thread when the queue goes empty -> non-empty,
+    // letting applications wake their drain thread instead of polling
+    notifier: Mutex<Option<NotifierEntry>>,
+    // Number of async completions currently queued (for notifier edge detection)
+    queued_completion_count: AtomicUsize,
     callback_thread_id: Mutex<Option<ThreadId>>,
 }
 
 impl EventDispatcher {
     pub fn new() -> Self {
         let (sender, receiver) = mpsc::channel();
+        let (completion_sender, completion_receiver) = mpsc::channel();
         Self {
             document_callbacks: Mutex::new(Vec::new()),
             sync_callbacks: Mutex::new(Vec::new()),
             error_callbacks: Mutex::new(Vec::new()),
             connection_callbacks: Mutex::new(Vec::new()),
             conflict_callbacks: Mutex::new(Vec::new()),
+            operation_callbacks: Mutex::new(Vec::new()),
             rust_callbacks: Mutex::new(Vec::new()),
             event_queue: Mutex::new(receiver),
             event_sender: sender,
+            completion_queue: Mutex::new(completion_receiver),
+            completion_sender,
+            queued_event_count: AtomicUsize::new(0),
+            coalesce_updates: std::sync::atomic::AtomicBool::new(false),
+            notifier: Mutex::new(None),
+            queued_completion_count: AtomicUsize::new(0),
             callback_thread_id: Mutex::new(None),
         }
     }
 
+    /// Install (or clear, with `None`) the wake-on-event notifier
+    ///
+    /// The notifier fires whenever the event or completion queue goes from
+    /// empty to non-empty, so applications can trigger a drain instead of
+    /// polling `process_events()` on a timer. See `EventNotifierCallback`
+    /// for the threading contract.
+    pub fn set_event_notifier(
+        &self,
+        callback: Option<EventNotifierCallback>,
+        context: *mut c_void,
+    ) -> SyncResult<()> {
+        let mut notifier = self
+            .notifier
+            .lock()
+            .map_err(|_| ClientError::LockError("notifier".into()))?;
+
+        *notifier = callback.map(|callback| NotifierEntry { callback, context });
+
+        Ok(())
+    }
+
+    /// Fire the notifier (called on an empty -> non-empty queue transition)
+    fn notify_queue_non_empty(&self) {
+        if let Ok(notifier) = self.notifier.lock() {
+            if let Some(entry) = notifier.as_ref() {
+                (entry.callback)(entry.context);
+            }
+        }
+    }
+
+    /// Enable or disable update coalescing (off by default)
+    ///
+    /// When enabled, a burst of consecutive DocumentUpdated events for the
+    /// same document is collapsed into the latest one before delivery, so
+    /// 50 rapid patches during a sync cost one callback invocation instead
+    /// of 50. Non-update events and updates to other documents are never
+    /// reordered or dropped.
+    pub fn set_update_coalescing(&self, enabled: bool) {
+        self.coalesce_updates.store(enabled, Ordering::Relaxed);
+    }
+
     /// Helper to set callback thread ID on first registration
     fn ensure_callback_thread(&self) -> SyncResult<()> {
         let mut thread_id = self
@@ -440,6 +603,47 @@ impl EventDispatcher {
             callback,
             context,
             event_filter,
+            document_filter: None,
+        });
+
+        Ok(())
+    }
+
+    /// Register a document callback limited to a set of document ids
+    ///
+    /// Like `register_document_callback`, but the callback only receives
+    /// events whose document id is in `document_ids`. Intended for
+    /// per-view listeners that watch one document (or a handful) and
+    /// should not be woken by every other document during a sync burst.
+    ///
+    /// # Parameters
+    /// * `callback` - Function to call for matching document events
+    /// * `context` - User-defined context pointer passed to callback
+    /// * `event_filter` - Optional event type filter, as for `register_document_callback`
+    /// * `document_ids` - Document ids the callback subscribes to (must be non-empty)
+    pub fn register_document_callback_for_documents(
+        &self,
+        callback: DocumentEventCallback,
+        context: *mut c_void,
+        event_filter: Option<EventType>,
+        document_ids: Vec<Uuid>,
+    ) -> SyncResult<()> {
+        if document_ids.is_empty() {
+            return Err(ClientError::InvalidState("empty document id set".into()).into());
+        }
+
+        self.ensure_callback_thread()?;
+
+        let mut callbacks = self
+            .document_callbacks
+            .lock()
+            .map_err(|_| ClientError::LockError("document_callbacks".into()))?;
+
+        callbacks.push(DocumentCallbackEntry {
+            callback,
+            context,
+            event_filter,
+            document_filter: Some(document_ids.iter().map(|id| id.to_string()).collect()),
         });
 
         Ok(())
@@ -533,6 +737,31 @@ impl EventDispatcher {
         Ok(())
     }
 
+    /// Register a callback for async operation completions
+    ///
+    /// Invoked from `process_events()` when an operation enqueued by one of
+    /// the `replicant_*_async` functions finishes.
+    ///
+    /// # Parameters
+    /// * `callback` - Function to call when an async operation completes
+    /// * `context` - User-defined context pointer passed to callback
+    pub fn register_operation_callback(
+        &self,
+        callback: OperationCompleteCallback,
+        context: *mut c_void,
+    ) -> SyncResult<()> {
+        self.ensure_callback_thread()?;
+
+        let mut callbacks = self
+            .operation_callbacks
+            .lock()
+            .map_err(|_| ClientError::LockError("operation_callbacks".into()))?;
+
+        callbacks.push(OperationCallbackEntry { callback, context });
+
+        Ok(())
+    }
+
     /// Register a Rust-native callback for all events
     ///
     /// This provides an idiomatic Rust interface using the `SyncEvent` enum.
@@ -732,6 +961,28 @@ impl EventDispatcher {
         );
     }
 
+    /// Queue an async operation completion for the callback thread
+    pub fn emit_operation_complete(
+        &self,
+        operation_id: u64,
+        result_code: i32,
+        document_id: Option<&Uuid>,
+        error: Option<&str>,
+    ) {
+        let completion = QueuedCompletion {
+            operation_id,
+            result_code,
+            document_id: document_id.map(|id| id.to_string()),
+            error: error.map(|e| e.to_string()),
+        };
+
+        if self.completion_sender.send(completion).is_err() {
+            tracing::error!("Failed to queue completion - receiver may have been dropped");
+        } else if self.queued_completion_count.fetch_add(1, Ordering::Relaxed) == 0 {
+            self.notify_queue_non_empty();
+        }
+    }
+
     /// Queue an event for later processing on the callback thread
     #[allow(clippy::too_many_arguments)] // FFI callback constraints
     fn queue_event(
@@ -744,6 +995,17 @@ impl EventDispatcher {
         numeric_data: u64,
         boolean_data: bool,
     ) {
+        // Bound the queue: drop rather than block producers if the
+        // application has stopped draining events
+        if self.queued_event_count.load(Ordering::Relaxed) >= EVENT_QUEUE_CAPACITY {
+            tracing::warn!(
+                "Event queue full ({} events) - dropping {:?} event",
+                EVENT_QUEUE_CAPACITY,
+                event_type
+            );
+            return;
+        }
+
         let queued_event = QueuedEvent {
             event_type,
             document_id: document_id.map(|id| id.to_string()),
@@ -756,6 +1018,8 @@ impl EventDispatcher {
 
         if self.event_sender.send(queued_event).is_err() {
             tracing::error!("Failed to queue event - receiver may have been dropped");
+        } else if self.queued_event_count.fetch_add(1, Ordering::Relaxed) == 0 {
+            self.notify_queue_non_empty();
         }
     }
 
@@ -781,6 +1045,10 @@ impl EventDispatcher {
             .conflict_callbacks
             .lock()
             .map_err(|_| ClientError::LockError("conflict_callbacks".into()))?;
+        let operation = self
+            .operation_callbacks
+            .lock()
+            .map_err(|_| ClientError::LockError("operation_callbacks".into()))?;
         let rust = self
             .rust_callbacks
             .lock()
@@ -791,6 +1059,7 @@ impl EventDispatcher {
             || !error.is_empty()
             || !conn.is_empty()
             || !conflict.is_empty()
+            || !operation.is_empty()
             || !rust.is_empty())
     }
 
@@ -846,11 +1115,24 @@ impl EventDispatcher {
             .lock()
             .map_err(|_| ClientError::LockError("event queue".into()))?;
 
+        // Drain the queue up front so coalescing can see the whole burst
+        // and the receiver lock is released before callbacks run
+        let mut drained: Vec<QueuedEvent> = Vec::new();
+        while let Ok(queued_event) = receiver.try_recv() {
+            self.queued_event_count.fetch_sub(1, Ordering::Relaxed);
+            drained.push(queued_event);
+        }
+        drop(receiver);
+
+        if self.coalesce_updates.load(Ordering::Relaxed) {
+            drained = Self::coalesce_consecutive_updates(drained);
+        }
+
         let mut processed_count = 0;
         let mut temp_strings: Vec<CString> = Vec::new();
 
-        // Process all available events
-        while let Ok(queued_event) = receiver.try_recv() {
+        // Process all drained events
+        for queued_event in drained {
             // Dispatch to Rust callbacks first (no FFI overhead)
             if !rust_callbacks.is_empty() {
                 let sync_event = SyncEvent::from_queued(&queued_event);
@@ -911,6 +1193,12 @@ impl EventDispatcher {
                                 continue;
                             }
                         }
+                        if let Some(ref subscribed) = entry.document_filter {
+                            match queued_event.document_id.as_ref() {
+                                Some(id) if subscribed.iter().any(|s| s == id) => {}
+                                _ => continue,
+                            }
+                        }
                         (entry.callback)(
                             queued_event.event_type,
                             doc_id_ptr,
@@ -971,6 +1259,215 @@ impl EventDispatcher {
             processed_count += 1;
         }
 
+        // Drain async operation completions (same thread-affinity guarantees)
+        processed_count += self.drain_completions()?;
+
+        Ok(processed_count)
+    }
+
+    /// Collapse consecutive DocumentUpdated events for the same document
+    ///
+    /// Only runs of updates to a single document are collapsed (keeping the
+    /// latest), so ordering relative to creates, deletes and other
+    /// documents' events is preserved exactly.
+    fn coalesce_consecutive_updates(events: Vec<QueuedEvent>) -> Vec<QueuedEvent> {
+        let mut coalesced: Vec<QueuedEvent> = Vec::with_capacity(events.len());
+
+        for event in events {
+            if event.event_type == EventType::DocumentUpdated {
+                if let Some(last) = coalesced.last_mut() {
+                    if last.event_type == EventType::DocumentUpdated
+                        && last.document_id == event.document_id
+                    {
+                        *last = event;
+                        continue;
+                    }
+                }
+            }
+            coalesced.push(event);
+        }
+
+        coalesced
+    }
+
+    /// Drain queued async operation completions to registered callbacks
+    ///
+    /// Shared by `process_events` and `process_events_batch` so completions
+    /// are delivered regardless of which drain API the application uses.
+    fn drain_completions(&self) -> SyncResult<usize> {
+        let operation_callbacks = self
+            .operation_callbacks
+            .lock()
+            .map_err(|_| ClientError::LockError("operation_callbacks".into()))?;
+        let completion_receiver = self
+            .completion_queue
+            .lock()
+            .map_err(|_| ClientError::LockError("completion queue".into()))?;
+
+        let mut processed_count = 0;
+        let mut temp_strings: Vec<CString> = Vec::new();
+
+        while let Ok(completion) = completion_receiver.try_recv() {
+            self.queued_completion_count.fetch_sub(1, Ordering::Relaxed);
+            temp_strings.clear();
+
+            let document_id_cstr = completion.document_id.as_ref().map(|id| {
+                let cstr = CString::new(id.as_str()).unwrap_or_else(|_| CString::new("").unwrap());
+                let ptr = cstr.as_ptr();
+                temp_strings.push(cstr);
+                ptr
+            });
+
+            let error_cstr = completion.error.as_ref().map(|e| {
+                let cstr = CString::new(e.as_str()).unwrap_or_else(|_| CString::new("").unwrap());
+                let ptr = cstr.as_ptr();
+                temp_strings.push(cstr);
+                ptr
+            });
+
+            for entry in operation_callbacks.iter() {
+                (entry.callback)(
+                    completion.operation_id,
+                    completion.result_code,
+                    document_id_cstr.unwrap_or(std::ptr::null()),
+                    error_cstr.unwrap_or(std::ptr::null()),
+                    entry.context,
+                );
+            }
+
+            processed_count += 1;
+        }
+
+        Ok(processed_count)
+    }
+
+    /// Drain all queued events into a single batch callback invocation
+    ///
+    /// Unlike `process_events`, which allocates fresh CStrings and makes one
+    /// FFI crossing per event, this copies every string field of the drained
+    /// events into one arena allocation and hands the callback an array of
+    /// `BatchedEvent` records in a single call. During large syncs this
+    /// amortizes both the allocation and the FFI crossing cost across the
+    /// whole drain.
+    ///
+    /// Events consumed here are not delivered to individually registered
+    /// callbacks - an application should use one drain API or the other.
+    /// Async operation completions are still delivered to registered
+    /// operation callbacks as part of this call.
+    ///
+    /// Must be called on the callback thread (established by the first
+    /// callback registration, or by the first call to this method).
+    ///
+    /// # Parameters
+    /// * `callback` - Function receiving the whole batch
+    /// * `context` - User-defined context pointer passed to the callback
+    /// * `max_events` - Maximum events to drain in this call (0 = no limit)
+    pub fn process_events_batch(
+        &self,
+        callback: EventBatchCallback,
+        context: *mut c_void,
+        max_events: usize,
+    ) -> SyncResult<usize> {
+        // Establish/verify callback thread affinity
+        self.ensure_callback_thread()?;
+        {
+            let thread_id = self
+                .callback_thread_id
+                .lock()
+                .map_err(|_| ClientError::LockError("thread ID".into()))?;
+            if *thread_id != Some(thread::current().id()) {
+                return Err(ClientError::ThreadSafetyViolation.into());
+            }
+        }
+
+        // Drain the queue up front so the receiver lock is not held while
+        // the callback runs
+        let mut drained: Vec<QueuedEvent> = Vec::new();
+        {
+            let receiver = self
+                .event_queue
+                .lock()
+                .map_err(|_| ClientError::LockError("event queue".into()))?;
+
+            while max_events == 0 || drained.len() < max_events {
+                match receiver.try_recv() {
+                    Ok(event) => {
+                        self.queued_event_count.fetch_sub(1, Ordering::Relaxed);
+                        drained.push(event);
+                    }
+                    Err(_) => break,
+                }
+            }
+        }
+
+        if self.coalesce_updates.load(Ordering::Relaxed) {
+            drained = Self::coalesce_consecutive_updates(drained);
+        }
+
+        let mut processed_count = 0;
+
+        if !drained.is_empty() {
+            // Size the arena exactly, then copy every string field into it
+            // as NUL-terminated bytes - one allocation for the whole drain
+            let arena_len: usize = drained
+                .iter()
+                .flat_map(|e| [&e.document_id, &e.title, &e.content, &e.error])
+                .filter_map(|s| s.as_ref().map(|s| s.len() + 1))
+                .sum();
+
+            let mut arena: Vec<u8> = Vec::with_capacity(arena_len);
+            let mut offsets: Vec<[Option<usize>; 4]> = Vec::with_capacity(drained.len());
+
+            fn push_str(arena: &mut Vec<u8>, s: Option<&String>) -> Option<usize> {
+                let s = s?;
+                let offset = arena.len();
+                // Interior NULs would truncate the C string; substitute
+                // empty, matching the per-event drain's CString fallback
+                if !s.as_bytes().contains(&0) {
+                    arena.extend_from_slice(s.as_bytes());
+                }
+                arena.push(0);
+                Some(offset)
+            }
+
+            for event in &drained {
+                offsets.push([
+                    push_str(&mut arena, event.document_id.as_ref()),
+                    push_str(&mut arena, event.title.as_ref()),
+                    push_str(&mut arena, event.content.as_ref()),
+                    push_str(&mut arena, event.error.as_ref()),
+                ]);
+            }
+
+            let base = arena.as_ptr() as *const c_char;
+            let to_ptr = |offset: Option<usize>| {
+                offset
+                    .map(|o| unsafe { base.add(o) })
+                    .unwrap_or(std::ptr::null())
+            };
+
+            let records: Vec<BatchedEvent> = drained
+                .iter()
+                .zip(offsets.iter())
+                .map(|(event, offs)| BatchedEvent {
+                    event_type: event.event_type,
+                    document_id: to_ptr(offs[0]),
+                    title: to_ptr(offs[1]),
+                    content: to_ptr(offs[2]),
+                    error: to_ptr(offs[3]),
+                    numeric_data: event.numeric_data,
+                    boolean_data: event.boolean_data,
+                })
+                .collect();
+
+            callback(records.as_ptr(), records.len(), context);
+
+            processed_count += records.len();
+        }
+
+        // Completions keep flowing even for batch-only consumers
+        processed_count += self.drain_completions()?;
+
         Ok(processed_count)
     }
 
@@ -1288,6 +1785,282 @@ mod tests {
         assert_eq!(conflict_count.load(Ordering::SeqCst), 1);
     }
 
+    #[test]
+    fn test_operation_callback() {
+        let dispatcher = EventDispatcher::new();
+        let completion_count = Arc::new(AtomicUsize::new(0));
+        let completion_clone = completion_count.clone();
+
+        extern "C" fn operation_callback(
+            _operation_id: u64,
+            result_code: i32,
+            _document_id: *const c_char,
+            _error: *const c_char,
+            context: *mut c_void,
+        ) {
+            assert_eq!(result_code, 0);
+            let count = unsafe { &*(context as *const AtomicUsize) };
+            count.fetch_add(1, Ordering::SeqCst);
+        }
+
+        dispatcher
+            .register_operation_callback(
+                operation_callback,
+                &*completion_clone as *const AtomicUsize as *mut c_void,
+            )
+            .unwrap();
+
+        let doc_id = Uuid::new_v4();
+        dispatcher.emit_operation_complete(1, 0, Some(&doc_id), None);
+        dispatcher.emit_operation_complete(2, 0, None, None);
+
+        let processed = dispatcher.process_events().unwrap();
+        assert_eq!(processed, 2);
+        assert_eq!(completion_count.load(Ordering::SeqCst), 2);
+    }
+
+    #[test]
+    fn test_event_notifier_fires_on_empty_to_non_empty() {
+        let dispatcher = EventDispatcher::new();
+        let notify_count = Arc::new(AtomicUsize::new(0));
+        let notify_clone = notify_count.clone();
+
+        extern "C" fn notifier(context: *mut c_void) {
+            let count = unsafe { &*(context as *const AtomicUsize) };
+            count.fetch_add(1, Ordering::SeqCst);
+        }
+
+        extern "C" fn sync_callback(
+            _event_type: EventType,
+            _doc_count: u64,
+            _context: *mut c_void,
+        ) {
+        }
+
+        dispatcher
+            .register_sync_callback(sync_callback, std::ptr::null_mut())
+            .unwrap();
+        dispatcher
+            .set_event_notifier(
+                Some(notifier),
+                &*notify_clone as *const AtomicUsize as *mut c_void,
+            )
+            .unwrap();
+
+        // Only the first event of a burst fires the notifier
+        dispatcher.emit_sync_started();
+        dispatcher.emit_sync_completed(1);
+        dispatcher.emit_sync_started();
+        assert_eq!(notify_count.load(Ordering::SeqCst), 1);
+
+        // After a drain, the next event fires it again
+        dispatcher.process_events().unwrap();
+        dispatcher.emit_sync_completed(2);
+        assert_eq!(notify_count.load(Ordering::SeqCst), 2);
+
+        // Completions fire the notifier through their own queue too
+        dispatcher.process_events().unwrap();
+        dispatcher.emit_operation_complete(1, 0, None, None);
+        assert_eq!(notify_count.load(Ordering::SeqCst), 3);
+
+        // Clearing the notifier stops further wake-ups
+        dispatcher.process_events().unwrap();
+        dispatcher.set_event_notifier(None, std::ptr::null_mut()).unwrap();
+        dispatcher.emit_sync_started();
+        assert_eq!(notify_count.load(Ordering::SeqCst), 3);
+    }
+
+    #[test]
+    fn test_per_document_subscription() {
+        let dispatcher = EventDispatcher::new();
+        let watched_count = Arc::new(AtomicUsize::new(0));
+        let watched_clone = watched_count.clone();
+
+        extern "C" fn count_callback(
+            _event_type: EventType,
+            _doc_id: *const c_char,
+            _title: *const c_char,
+            _content: *const c_char,
+            context: *mut c_void,
+        ) {
+            let count = unsafe { &*(context as *const AtomicUsize) };
+            count.fetch_add(1, Ordering::SeqCst);
+        }
+
+        let watched_id = Uuid::new_v4();
+        let other_id = Uuid::new_v4();
+
+        // Subscribe to one document only
+        dispatcher
+            .register_document_callback_for_documents(
+                count_callback,
+                &*watched_clone as *const AtomicUsize as *mut c_void,
+                None,
+                vec![watched_id],
+            )
+            .unwrap();
+
+        dispatcher.emit_document_created(&watched_id, &serde_json::json!({"title": "Watched"}));
+        dispatcher.emit_document_created(&other_id, &serde_json::json!({"title": "Other"}));
+        dispatcher.emit_document_updated(&other_id, &serde_json::json!({"title": "Other2"}));
+        dispatcher.emit_document_deleted(&watched_id);
+
+        // All four events are processed, but only the watched document's
+        // two events reach the callback
+        let processed = dispatcher.process_events().unwrap();
+        assert_eq!(processed, 4);
+        assert_eq!(watched_count.load(Ordering::SeqCst), 2);
+
+        // Empty subscription sets are rejected
+        assert!(dispatcher
+            .register_document_callback_for_documents(
+                count_callback,
+                std::ptr::null_mut(),
+                None,
+                vec![],
+            )
+            .is_err());
+    }
+
+    #[test]
+    fn test_update_coalescing() {
+        let dispatcher = EventDispatcher::new();
+        let events_received = Arc::new(Mutex::new(Vec::<(EventType, String)>::new()));
+        let events_clone = events_received.clone();
+
+        dispatcher
+            .register_rust_callback(move |event| {
+                let entry = match &event {
+                    SyncEvent::DocumentCreated { title, .. } => {
+                        (EventType::DocumentCreated, title.clone())
+                    }
+                    SyncEvent::DocumentUpdated { title, .. } => {
+                        (EventType::DocumentUpdated, title.clone())
+                    }
+                    SyncEvent::DocumentDeleted { id } => (EventType::DocumentDeleted, id.clone()),
+                    _ => (event.event_type(), String::new()),
+                };
+                events_clone.lock().unwrap().push(entry);
+            })
+            .unwrap();
+
+        dispatcher.set_update_coalescing(true);
+
+        let doc_a = Uuid::new_v4();
+        let doc_b = Uuid::new_v4();
+
+        // A burst of updates to doc_a collapses to the latest one; the
+        // interleaved doc_b update and the delete survive untouched
+        dispatcher.emit_document_updated(&doc_a, &serde_json::json!({"title": "a1"}));
+        dispatcher.emit_document_updated(&doc_a, &serde_json::json!({"title": "a2"}));
+        dispatcher.emit_document_updated(&doc_a, &serde_json::json!({"title": "a3"}));
+        dispatcher.emit_document_updated(&doc_b, &serde_json::json!({"title": "b1"}));
+        dispatcher.emit_document_updated(&doc_a, &serde_json::json!({"title": "a4"}));
+        dispatcher.emit_document_deleted(&doc_a);
+
+        let processed = dispatcher.process_events().unwrap();
+        assert_eq!(processed, 4);
+
+        let events = events_received.lock().unwrap();
+        assert_eq!(
+            *events,
+            vec![
+                (EventType::DocumentUpdated, "a3".to_string()),
+                (EventType::DocumentUpdated, "b1".to_string()),
+                (EventType::DocumentUpdated, "a4".to_string()),
+                (EventType::DocumentDeleted, doc_a.to_string()),
+            ]
+        );
+        drop(events);
+
+        // Disabling restores one-callback-per-update delivery
+        dispatcher.set_update_coalescing(false);
+        dispatcher.emit_document_updated(&doc_a, &serde_json::json!({"title": "a5"}));
+        dispatcher.emit_document_updated(&doc_a, &serde_json::json!({"title": "a6"}));
+        let processed = dispatcher.process_events().unwrap();
+        assert_eq!(processed, 2);
+    }
+
+    #[test]
+    fn test_process_events_batch() {
+        let dispatcher = EventDispatcher::new();
+
+        // Collects (event_type, document_id) pairs from one batch invocation
+        struct BatchSink {
+            invocations: AtomicUsize,
+            records: Mutex<Vec<(EventType, Option<String>)>>,
+        }
+
+        extern "C" fn batch_callback(
+            events: *const BatchedEvent,
+            count: usize,
+            context: *mut c_void,
+        ) {
+            let sink = unsafe { &*(context as *const BatchSink) };
+            sink.invocations.fetch_add(1, Ordering::SeqCst);
+
+            let records = unsafe { std::slice::from_raw_parts(events, count) };
+            let mut collected = sink.records.lock().unwrap();
+            for record in records {
+                let doc_id = if record.document_id.is_null() {
+                    None
+                } else {
+                    Some(
+                        unsafe { std::ffi::CStr::from_ptr(record.document_id) }
+                            .to_string_lossy()
+                            .into_owned(),
+                    )
+                };
+                collected.push((record.event_type, doc_id));
+            }
+        }
+
+        let sink = BatchSink {
+            invocations: AtomicUsize::new(0),
+            records: Mutex::new(Vec::new()),
+        };
+
+        let doc_id = Uuid::new_v4();
+        dispatcher.emit_document_created(&doc_id, &serde_json::json!({"title": "Batched"}));
+        dispatcher.emit_document_deleted(&doc_id);
+        dispatcher.emit_sync_completed(7);
+
+        let processed = dispatcher
+            .process_events_batch(
+                batch_callback,
+                &sink as *const BatchSink as *mut c_void,
+                0,
+            )
+            .unwrap();
+
+        // All three events delivered through a single callback invocation
+        assert_eq!(processed, 3);
+        assert_eq!(sink.invocations.load(Ordering::SeqCst), 1);
+
+        let records = sink.records.lock().unwrap();
+        assert_eq!(records.len(), 3);
+        assert_eq!(records[0].0, EventType::DocumentCreated);
+        assert_eq!(records[0].1.as_deref(), Some(doc_id.to_string().as_str()));
+        assert_eq!(records[1].0, EventType::DocumentDeleted);
+        assert_eq!(records[2].0, EventType::SyncCompleted);
+        assert_eq!(records[2].1, None);
+        drop(records);
+
+        // Queue is empty afterwards
+        let processed = dispatcher
+            .process_events_batch(batch_callback, &sink as *const BatchSink as *mut c_void, 0)
+            .unwrap();
+        assert_eq!(processed, 0);
+
+        // max_events limits a single drain
+        dispatcher.emit_sync_started();
+        dispatcher.emit_sync_completed(1);
+        let processed = dispatcher
+            .process_events_batch(batch_callback, &sink as *const BatchSink as *mut c_void, 1)
+            .unwrap();
+        assert_eq!(processed, 1);
+    }
+
     #[test]
     fn test_rust_callback() {
         let dispatcher = EventDispatcher::new();
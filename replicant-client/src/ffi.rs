@@ -13,16 +13,19 @@ use uuid::Uuid;
 
 use crate::events::{
     ConflictEventCallback, ConnectionEventCallback, DocumentEventCallback, ErrorEventCallback,
-    EventDispatcher, EventType, SyncEventCallback,
+    EventBatchCallback, EventDispatcher, EventNotifierCallback, EventType,
+    OperationCompleteCallback, SyncEventCallback,
 };
 use crate::{Client as CoreClient, ClientDatabase};
 
 /// Opaque handle to a Replicant client instance
 pub struct Replicant {
-    engine: Option<CoreClient>,
+    engine: Option<Arc<CoreClient>>,
     database: Arc<ClientDatabase>,
     runtime: Runtime,
     pub(crate) event_dispatcher: Arc<EventDispatcher>,
+    // Monotonic id generator for the replicant_*_async entry points
+    next_operation_id: std::sync::atomic::AtomicU64,
 }
 
 /// Result codes for C API functions
@@ -46,6 +49,137 @@ pub struct Document {
     pub sync_revision: i64,
 }
 
+/// SQLite journal mode selector for `ClientOptions`
+#[repr(C)]
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub enum JournalMode {
+    /// Keep the library default (WAL)
+    JournalModeDefault = 0,
+    JournalModeWal = 1,
+    JournalModeDelete = 2,
+    JournalModeTruncate = 3,
+    JournalModePersist = 4,
+    JournalModeMemory = 5,
+}
+
+/// SQLite synchronous level selector for `ClientOptions`
+#[repr(C)]
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub enum SynchronousMode {
+    /// Keep the library default (FULL)
+    SynchronousDefault = 0,
+    SynchronousOff = 1,
+    SynchronousNormal = 2,
+    SynchronousFull = 3,
+    SynchronousExtra = 4,
+}
+
+/// SQLite performance profile for `replicant_create_with_options`
+///
+/// Zero values keep the library default for that field, so a
+/// zero-initialized struct behaves exactly like `replicant_create`.
+/// Hosts on slow storage typically set `SynchronousNormal` together
+/// with a larger cache and mmap window.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct ClientOptions {
+    pub journal_mode: JournalMode,
+    pub synchronous: SynchronousMode,
+    /// Database page size in bytes (power of two, 512..65536); only
+    /// takes effect on a fresh database file
+    pub page_size_bytes: u32,
+    /// Page-cache budget in KiB
+    pub cache_size_kib: i64,
+    /// Memory-mapped I/O window in bytes
+    pub mmap_size_bytes: i64,
+    /// Busy handler timeout in milliseconds
+    pub busy_timeout_ms: u32,
+    /// SQLite connection pool size
+    pub pool_size: u32,
+    /// Per-connection prepared-statement cache entries
+    pub statement_cache_capacity: u32,
+}
+
+impl ClientOptions {
+    fn to_database_options(self) -> crate::database::DatabaseOptions {
+        use sqlx::sqlite::{SqliteJournalMode, SqliteSynchronous};
+
+        let mut options = crate::database::DatabaseOptions::default();
+        options.journal_mode = match self.journal_mode {
+            JournalMode::JournalModeDefault => options.journal_mode,
+            JournalMode::JournalModeWal => SqliteJournalMode::Wal,
+            JournalMode::JournalModeDelete => SqliteJournalMode::Delete,
+            JournalMode::JournalModeTruncate => SqliteJournalMode::Truncate,
+            JournalMode::JournalModePersist => SqliteJournalMode::Persist,
+            JournalMode::JournalModeMemory => SqliteJournalMode::Memory,
+        };
+        options.synchronous = match self.synchronous {
+            SynchronousMode::SynchronousDefault => options.synchronous,
+            SynchronousMode::SynchronousOff => SqliteSynchronous::Off,
+            SynchronousMode::SynchronousNormal => SqliteSynchronous::Normal,
+            SynchronousMode::SynchronousFull => SqliteSynchronous::Full,
+            SynchronousMode::SynchronousExtra => SqliteSynchronous::Extra,
+        };
+        options.page_size_bytes = self.page_size_bytes;
+        options.cache_size_kib = self.cache_size_kib;
+        options.mmap_size_bytes = self.mmap_size_bytes;
+        if self.busy_timeout_ms > 0 {
+            options.busy_timeout = std::time::Duration::from_millis(self.busy_timeout_ms as u64);
+        }
+        if self.pool_size > 0 {
+            options.max_connections = self.pool_size;
+        }
+        if self.statement_cache_capacity > 0 {
+            options.statement_cache_capacity = self.statement_cache_capacity as usize;
+        }
+        options
+    }
+}
+
+/// Summary of one operation's wall-clock timings, in microseconds
+/// (see `replicant_get_metrics_struct`)
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default)]
+pub struct MetricsTiming {
+    pub count: u64,
+    pub total_us: u64,
+    pub mean_us: u64,
+    /// 0 until the first sample is recorded
+    pub min_us: u64,
+    pub max_us: u64,
+    pub last_us: u64,
+}
+
+/// Point-in-time metrics snapshot for C callers
+/// (see `replicant_get_metrics_struct`)
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default)]
+pub struct ClientMetrics {
+    /// Upload send to server confirmation, per document
+    pub sync_upload_latency: MetricsTiming,
+    /// Heartbeat ping to matching pong
+    pub ws_rtt: MetricsTiming,
+    /// SQLite statement timings
+    pub db_query: MetricsTiming,
+    pub uploads_confirmed: u64,
+    pub upload_failures: u64,
+    pub upload_retries: u64,
+    pub event_queue_depth: u64,
+}
+
+impl MetricsTiming {
+    fn from_snapshot(snap: crate::metrics::TimingSnapshot) -> Self {
+        Self {
+            count: snap.count,
+            total_us: snap.total_us,
+            mean_us: snap.mean_us,
+            min_us: snap.min_us,
+            max_us: snap.max_us,
+            last_us: snap.last_us,
+        }
+    }
+}
+
 /// Create a new sync engine instance
 ///
 /// # Arguments
@@ -102,12 +236,102 @@ pub unsafe extern "C" fn replicant_create(
         Err(_) => return ptr::null_mut(),
     };
 
+    create_instance(
+        database_url,
+        server_url,
+        email,
+        api_key,
+        api_secret,
+        crate::database::DatabaseOptions::default(),
+    )
+}
+
+/// Create a new sync engine instance with an explicit SQLite profile
+///
+/// Like `replicant_create` but takes a `ClientOptions` struct selecting
+/// journal mode, synchronous level, page/cache/mmap sizes, busy timeout,
+/// pool size and prepared-statement cache capacity. Zeroed fields keep
+/// the library defaults; a null `options` pointer behaves exactly like
+/// `replicant_create`.
+///
+/// # Safety
+/// Caller must ensure all string pointers are valid, non-null C strings
+/// and `options` is either null or a valid `ClientOptions` pointer
+#[no_mangle]
+pub unsafe extern "C" fn replicant_create_with_options(
+    database_url: *const c_char,
+    server_url: *const c_char,
+    email: *const c_char,
+    api_key: *const c_char,
+    api_secret: *const c_char,
+    options: *const ClientOptions,
+) -> *mut Replicant {
+    if database_url.is_null()
+        || server_url.is_null()
+        || email.is_null()
+        || api_key.is_null()
+        || api_secret.is_null()
+    {
+        return ptr::null_mut();
+    }
+
+    let database_url = match CStr::from_ptr(database_url).to_str() {
+        Ok(s) => s,
+        Err(_) => return ptr::null_mut(),
+    };
+
+    let server_url = match CStr::from_ptr(server_url).to_str() {
+        Ok(s) => s,
+        Err(_) => return ptr::null_mut(),
+    };
+
+    let email = match CStr::from_ptr(email).to_str() {
+        Ok(s) => s,
+        Err(_) => return ptr::null_mut(),
+    };
+
+    let api_key = match CStr::from_ptr(api_key).to_str() {
+        Ok(s) => s,
+        Err(_) => return ptr::null_mut(),
+    };
+
+    let api_secret = match CStr::from_ptr(api_secret).to_str() {
+        Ok(s) => s,
+        Err(_) => return ptr::null_mut(),
+    };
+
+    let db_options = if options.is_null() {
+        crate::database::DatabaseOptions::default()
+    } else {
+        (*options).to_database_options()
+    };
+
+    create_instance(
+        database_url,
+        server_url,
+        email,
+        api_key,
+        api_secret,
+        db_options,
+    )
+}
+
+fn create_instance(
+    database_url: &str,
+    server_url: &str,
+    email: &str,
+    api_key: &str,
+    api_secret: &str,
+    db_options: crate::database::DatabaseOptions,
+) -> *mut Replicant {
     let runtime = match Runtime::new() {
         Ok(rt) => rt,
         Err(_) => return ptr::null_mut(),
     };
 
-    let database = match runtime.block_on(async { ClientDatabase::new(database_url).await }) {
+    let database = match runtime
+        .block_on(async { ClientDatabase::new_with_options(database_url, &db_options).await })
+    {
         Ok(db) => Arc::new(db),
         Err(_) => return ptr::null_mut(),
     };
@@ -124,13 +348,20 @@ pub unsafe extern "C" fn replicant_create(
 
     // Try to create sync engine (optional - can work offline)
     let engine = runtime.block_on(async {
-        let sync_engine = CoreClient::new(database_url, server_url, email, api_key, api_secret)
-            .await
-            .ok()?;
+        let sync_engine = CoreClient::new_with_options(
+            database_url,
+            server_url,
+            email,
+            api_key,
+            api_secret,
+            &db_options,
+        )
+        .await
+        .ok()?;
         // We can't easily replace the event dispatcher in an existing SyncEngine,
         // so we'll use separate dispatchers for now. In a production system,
         // you'd want to refactor to share the same dispatcher.
-        Some(sync_engine)
+        Some(Arc::new(sync_engine))
     });
 
     Box::into_raw(Box::new(Replicant {
@@ -138,6 +369,7 @@ pub unsafe extern "C" fn replicant_create(
         database,
         runtime,
         event_dispatcher,
+        next_operation_id: std::sync::atomic::AtomicU64::new(1),
     }))
 }
 
@@ -357,6 +589,124 @@ pub unsafe extern "C" fn replicant_create_document_with_id(
     SyncResult::Success
 }
 
+/// Shared tail of the bulk import entry points: stream NDJSON into the
+/// database and emit one summary event instead of one per document
+fn import_from_reader<R: std::io::BufRead>(
+    engine: &Replicant,
+    reader: R,
+    mark_synced: bool,
+    out_imported: *mut u64,
+) -> SyncResult {
+    let report = match engine
+        .runtime
+        .block_on(async { engine.database.import_documents(reader, mark_synced).await })
+    {
+        Ok(report) => report,
+        Err(_) => return SyncResult::ErrorDatabase,
+    };
+
+    engine.event_dispatcher.emit_sync_completed(report.imported);
+
+    if !out_imported.is_null() {
+        unsafe { *out_imported = report.imported };
+    }
+    SyncResult::Success
+}
+
+/// Bulk-import documents from an NDJSON file
+///
+/// Each line is one document: either a bare content object (an id is
+/// generated) or `{"id": "...", "content": {...}}` to preserve ids from
+/// an export. Documents are written in large multi-row transactions,
+/// the FTS index is rebuilt once at the end instead of per document,
+/// and a single SyncCompleted event carries the imported count instead
+/// of one DocumentCreated event per row. Pass `mark_synced = true` for
+/// server-seeded imports that must not upload; otherwise the imported
+/// rows are picked up as creates by the next sync pass.
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `ndjson_path` - Path to an NDJSON file, one document per line
+/// * `mark_synced` - Mark imported rows as already synced
+/// * `out_imported` - Optional output pointer for the imported row count (may be null)
+///
+/// # Returns
+/// * SyncResult indicating success or failure; unparseable lines are
+///   skipped, not fatal
+///
+/// # Safety
+/// Caller must ensure engine is valid and ndjson_path is a valid C string
+#[no_mangle]
+pub unsafe extern "C" fn replicant_import_documents(
+    engine: *mut Replicant,
+    ndjson_path: *const c_char,
+    mark_synced: bool,
+    out_imported: *mut u64,
+) -> SyncResult {
+    if engine.is_null() || ndjson_path.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    let path = match CStr::from_ptr(ndjson_path).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let file = match std::fs::File::open(path) {
+        Ok(f) => f,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    import_from_reader(
+        engine,
+        std::io::BufReader::new(file),
+        mark_synced,
+        out_imported,
+    )
+}
+
+/// Bulk-import documents from an NDJSON buffer in memory
+///
+/// Identical to `replicant_import_documents` but reads from a caller
+/// owned buffer (e.g. a memory-mapped export) instead of a file path.
+/// The buffer only needs to stay alive for the duration of the call.
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `data` - NDJSON bytes, one document per line
+/// * `len` - Length of `data` in bytes
+/// * `mark_synced` - Mark imported rows as already synced
+/// * `out_imported` - Optional output pointer for the imported row count (may be null)
+///
+/// # Returns
+/// * SyncResult indicating success or failure
+///
+/// # Safety
+/// Caller must ensure engine is valid and data points to at least len bytes
+#[no_mangle]
+pub unsafe extern "C" fn replicant_import_documents_buffer(
+    engine: *mut Replicant,
+    data: *const u8,
+    len: usize,
+    mark_synced: bool,
+    out_imported: *mut u64,
+) -> SyncResult {
+    if engine.is_null() || (data.is_null() && len > 0) {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+    let bytes = if len == 0 {
+        &[][..]
+    } else {
+        std::slice::from_raw_parts(data, len)
+    };
+
+    import_from_reader(engine, bytes, mark_synced, out_imported)
+}
+
 /// Update an existing document
 ///
 /// # Arguments
@@ -442,23 +792,30 @@ pub unsafe extern "C" fn replicant_update_document(
     }
 }
 
-/// Delete a document
+/// Update a document by applying an RFC-6902 patch directly
 ///
 /// # Arguments
 /// * `engine` - Sync engine instance
-/// * `document_id` - Document ID to delete
+/// * `document_id` - Document ID to update
+/// * `patch_json` - RFC-6902 JSON Patch array (e.g. `[{"op":"replace","path":"/title","value":"New"}]`)
 ///
 /// # Returns
 /// * CSyncResult indicating success or failure
 ///
+/// # Note
+/// Prefer this over replicant_update_document when the caller already knows
+/// which fields changed: the patch is applied and queued for sync as-is,
+/// skipping the full-document diff that the content-based update performs.
+///
 /// # Safety
-/// Caller must ensure engine is valid and document_id is a valid C string
+/// Caller must ensure engine is valid and both document_id and patch_json are valid C strings
 #[no_mangle]
-pub unsafe extern "C" fn replicant_delete_document(
+pub unsafe extern "C" fn replicant_update_document_patch(
     engine: *mut Replicant,
     document_id: *const c_char,
+    patch_json: *const c_char,
 ) -> SyncResult {
-    if engine.is_null() || document_id.is_null() {
+    if engine.is_null() || document_id.is_null() || patch_json.is_null() {
         return SyncResult::ErrorInvalidInput;
     }
 
@@ -474,24 +831,52 @@ pub unsafe extern "C" fn replicant_delete_document(
         Err(_) => return SyncResult::ErrorInvalidInput,
     };
 
+    let patch_json = match CStr::from_ptr(patch_json).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let patch: json_patch::Patch = match serde_json::from_str(patch_json) {
+        Ok(p) => p,
+        Err(_) => return SyncResult::ErrorSerialization,
+    };
+
     if let Some(ref sync_engine) = engine.engine {
         // Online mode
         match engine
             .runtime
-            .block_on(async { sync_engine.delete_document(doc_uuid).await })
+            .block_on(async { sync_engine.update_document_with_patch(doc_uuid, patch).await })
         {
             Ok(_) => SyncResult::Success,
             Err(_) => SyncResult::ErrorConnection,
         }
     } else {
-        // Offline mode
+        // Offline mode - apply the patch locally
+        let mut doc = match engine
+            .runtime
+            .block_on(async { engine.database.get_document(&doc_uuid).await })
+        {
+            Ok(d) => d,
+            Err(_) => return SyncResult::ErrorDatabase,
+        };
+
+        if replicant_core::patches::apply_patch(&mut doc.content, &patch).is_err() {
+            return SyncResult::ErrorInvalidInput;
+        }
+
+        doc.sync_revision += 1;
+        doc.content_hash = None; // Will be recalculated on server
+        doc.updated_at = chrono::Utc::now();
+
         match engine
             .runtime
-            .block_on(async { engine.database.delete_document(&doc_uuid).await })
+            .block_on(async { engine.database.save_document(&doc).await })
         {
             Ok(_) => {
-                // Emit event for offline document deletion
-                engine.event_dispatcher.emit_document_deleted(&doc_uuid);
+                // Emit event for offline document update
+                engine
+                    .event_dispatcher
+                    .emit_document_updated(&doc_uuid, &doc.content);
                 SyncResult::Success
             }
             Err(_) => SyncResult::ErrorDatabase,
@@ -499,331 +884,1779 @@ pub unsafe extern "C" fn replicant_delete_document(
     }
 }
 
-/// Free a C string allocated by this library
+/// Write a batch of documents in one transaction and one runtime entry
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `operations_json` - JSON array of operations: `[{"id": "<uuid>", "content": {...}}, ...]`
+///   The `id` field is optional; a new UUID is generated when omitted.
+/// * `out_results` - Output array for per-item result codes (optional, may be null)
+/// * `results_len` - Capacity of `out_results` in elements
+///
+/// # Returns
+/// * `SyncResult::Success` - Batch transaction committed (individual items may
+///   still report input errors in `out_results`)
+/// * `SyncResult::ErrorInvalidInput` - Null pointers or `operations_json` is not a JSON array
+/// * `SyncResult::ErrorDatabase` - Batch transaction failed; no documents were written
+///
+/// # Note
+/// Existing documents are updated (with a patch queued for sync), new ids are
+/// created. All valid items are applied in a single SQLite transaction, which
+/// is significantly faster than per-document calls for bulk imports and edits.
 ///
 /// # Safety
-/// Caller must ensure the string was allocated by this library and hasn't been freed
+/// Caller must ensure engine is valid, operations_json is a valid C string, and
+/// out_results (if not null) has space for results_len elements
 #[no_mangle]
-pub unsafe extern "C" fn replicant_string_free(s: *mut c_char) {
-    if !s.is_null() {
-        let _ = CString::from_raw(s);
+pub unsafe extern "C" fn replicant_write_documents_batch(
+    engine: *mut Replicant,
+    operations_json: *const c_char,
+    out_results: *mut SyncResult,
+    results_len: usize,
+) -> SyncResult {
+    if engine.is_null() || operations_json.is_null() {
+        return SyncResult::ErrorInvalidInput;
     }
-}
 
-/// Get library version string
-#[no_mangle]
-pub extern "C" fn replicant_get_version() -> *mut c_char {
-    let version = env!("CARGO_PKG_VERSION");
-    match CString::new(version) {
-        Ok(s) => s.into_raw(),
-        Err(_) => ptr::null_mut(),
+    let engine = &mut *engine;
+
+    let operations_json = match CStr::from_ptr(operations_json).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let items: Vec<Value> = match serde_json::from_str(operations_json) {
+        Ok(Value::Array(items)) => items,
+        _ => return SyncResult::ErrorSerialization,
+    };
+
+    let write_item_result = |index: usize, code: SyncResult| {
+        if !out_results.is_null() && index < results_len {
+            out_results.add(index).write(code);
+        }
+    };
+
+    // Parse each item up front so invalid entries get per-item error codes
+    // without aborting the whole batch
+    let mut operations: Vec<(usize, Uuid, Value)> = Vec::with_capacity(items.len());
+
+    for (index, item) in items.iter().enumerate() {
+        let doc_id = match item.get("id") {
+            Some(Value::String(s)) => match Uuid::parse_str(s) {
+                Ok(id) => id,
+                Err(_) => {
+                    write_item_result(index, SyncResult::ErrorInvalidInput);
+                    continue;
+                }
+            },
+            None => Uuid::new_v4(),
+            Some(_) => {
+                write_item_result(index, SyncResult::ErrorInvalidInput);
+                continue;
+            }
+        };
+
+        let content = match item.get("content") {
+            Some(content) => content.clone(),
+            None => {
+                write_item_result(index, SyncResult::ErrorSerialization);
+                continue;
+            }
+        };
+
+        operations.push((index, doc_id, content));
+    }
+
+    if operations.is_empty() {
+        return SyncResult::Success;
+    }
+
+    let batch_result = if let Some(ref sync_engine) = engine.engine {
+        // Online mode - use sync engine (one transaction, then per-document sync)
+        let ops: Vec<(Uuid, Value)> = operations
+            .iter()
+            .map(|(_, id, content)| (*id, content.clone()))
+            .collect();
+
+        engine
+            .runtime
+            .block_on(async { sync_engine.write_batch(ops).await })
+            .map(|documents| {
+                // The sync engine emits on its own dispatcher, not the FFI
+                // one, so FFI callbacks need these emitted here too
+                for doc in &documents {
+                    if doc.sync_revision == 1 {
+                        engine
+                            .event_dispatcher
+                            .emit_document_created(&doc.id, &doc.content);
+                    } else {
+                        engine
+                            .event_dispatcher
+                            .emit_document_updated(&doc.id, &doc.content);
+                    }
+                }
+            })
+    } else {
+        // Offline mode - apply the batch directly against the local database
+        engine.runtime.block_on(async {
+            use crate::database::BatchDocumentWrite;
+
+            let user_id = engine.database.get_user_id().await?;
+            let mut writes = Vec::with_capacity(operations.len());
+
+            for (_, doc_id, content) in &operations {
+                let doc = match engine.database.get_document(doc_id).await {
+                    Ok(mut existing) => {
+                        existing.content = content.clone();
+                        existing.sync_revision += 1;
+                        existing.content_hash = None; // Will be recalculated on server
+                        existing.updated_at = chrono::Utc::now();
+                        existing
+                    }
+                    Err(_) => replicant_core::models::Document {
+                        id: *doc_id,
+                        user_id,
+                        content: content.clone(),
+                        sync_revision: 1,
+                        content_hash: None,
+                        title: None,
+                        created_at: chrono::Utc::now(),
+                        updated_at: chrono::Utc::now(),
+                        deleted_at: None,
+                    },
+                };
+
+                writes.push(BatchDocumentWrite {
+                    document: doc,
+                    sync_status: None,
+                    queue: None,
+                });
+            }
+
+            engine.database.write_documents_batch(&writes).await?;
+
+            for write in &writes {
+                if write.document.sync_revision == 1 {
+                    engine
+                        .event_dispatcher
+                        .emit_document_created(&write.document.id, &write.document.content);
+                } else {
+                    engine
+                        .event_dispatcher
+                        .emit_document_updated(&write.document.id, &write.document.content);
+                }
+            }
+
+            Ok(())
+        })
+    };
+
+    match batch_result {
+        Ok(()) => {
+            for (index, _, _) in &operations {
+                write_item_result(*index, SyncResult::Success);
+            }
+            SyncResult::Success
+        }
+        Err(_) => {
+            for (index, _, _) in &operations {
+                write_item_result(*index, SyncResult::ErrorDatabase);
+            }
+            SyncResult::ErrorDatabase
+        }
     }
 }
 
-/// Register a callback for document events (Created, Updated, Deleted)
+/// Delete a document
 ///
 /// # Arguments
 /// * `engine` - Sync engine instance
-/// * `callback` - C callback function to invoke for document events
-/// * `context` - User-defined context pointer passed to callback
-/// * `event_filter` - Optional filter: 0=Created, 1=Updated, 2=Deleted, -1=all document events
+/// * `document_id` - Document ID to delete
 ///
 /// # Returns
-/// * SyncResult indicating success or failure
+/// * CSyncResult indicating success or failure
 ///
 /// # Safety
-/// Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+/// Caller must ensure engine is valid and document_id is a valid C string
 #[no_mangle]
-pub unsafe extern "C" fn replicant_register_document_callback(
+pub unsafe extern "C" fn replicant_delete_document(
     engine: *mut Replicant,
-    callback: DocumentEventCallback,
-    context: *mut c_void,
-    event_filter: i32,
+    document_id: *const c_char,
 ) -> SyncResult {
-    if engine.is_null() {
+    if engine.is_null() || document_id.is_null() {
         return SyncResult::ErrorInvalidInput;
     }
 
-    let engine = &*engine;
+    let engine = &mut *engine;
 
-    let filter = if event_filter >= 0 {
-        match event_filter {
-            0 => Some(EventType::DocumentCreated),
-            1 => Some(EventType::DocumentUpdated),
-            2 => Some(EventType::DocumentDeleted),
-            _ => return SyncResult::ErrorInvalidInput,
+    let document_id = match CStr::from_ptr(document_id).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let doc_uuid = match Uuid::parse_str(document_id) {
+        Ok(id) => id,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    if let Some(ref sync_engine) = engine.engine {
+        // Online mode
+        match engine
+            .runtime
+            .block_on(async { sync_engine.delete_document(doc_uuid).await })
+        {
+            Ok(_) => SyncResult::Success,
+            Err(_) => SyncResult::ErrorConnection,
         }
     } else {
-        None
+        // Offline mode
+        match engine
+            .runtime
+            .block_on(async { engine.database.delete_document(&doc_uuid).await })
+        {
+            Ok(_) => {
+                // Emit event for offline document deletion
+                engine.event_dispatcher.emit_document_deleted(&doc_uuid);
+                SyncResult::Success
+            }
+            Err(_) => SyncResult::ErrorDatabase,
+        }
+    }
+}
+
+// ===== Async Operation Functions =====
+//
+// These variants validate their input, enqueue the work on the client
+// runtime, and return immediately. Completion is reported through the
+// callback registered with replicant_register_operation_callback and is
+// delivered from replicant_process_events on the callback thread, so UI
+// threads never wait on SQLite or WebSocket I/O.
+
+/// Register a callback for async operation completions
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `callback` - C callback invoked when a replicant_*_async operation completes
+/// * `context` - User-defined context pointer passed to callback
+///
+/// # Returns
+/// * SyncResult indicating success or failure
+///
+/// # Safety
+/// Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+#[no_mangle]
+pub unsafe extern "C" fn replicant_register_operation_callback(
+    engine: *mut Replicant,
+    callback: OperationCompleteCallback,
+    context: *mut c_void,
+) -> SyncResult {
+    if engine.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    match engine
+        .event_dispatcher
+        .register_operation_callback(callback, context)
+    {
+        Ok(_) => SyncResult::Success,
+        Err(_) => SyncResult::ErrorUnknown,
+    }
+}
+
+/// Create a new document without blocking the calling thread
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `content_json` - Document content as JSON string
+/// * `out_document_id` - Output buffer for the (pre-generated) document ID (must be at least 37 chars)
+/// * `out_operation_id` - Output pointer for the operation id passed to the completion callback (optional)
+///
+/// # Returns
+/// * SyncResult::Success if the operation was enqueued; the final outcome is
+///   reported through the operation callback
+///
+/// # Note
+/// The document ID is generated up front and written to out_document_id
+/// before this function returns, so callers can track the document
+/// immediately without waiting for the completion callback.
+///
+/// # Safety
+/// Caller must ensure engine is valid, content_json is a valid C string, and out_document_id has space for 37 bytes
+#[no_mangle]
+pub unsafe extern "C" fn replicant_create_document_async(
+    engine: *mut Replicant,
+    content_json: *const c_char,
+    out_document_id: *mut c_char,
+    out_operation_id: *mut u64,
+) -> SyncResult {
+    if engine.is_null() || content_json.is_null() || out_document_id.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    let content_json = match CStr::from_ptr(content_json).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let content: Value = match serde_json::from_str(content_json) {
+        Ok(c) => c,
+        Err(_) => return SyncResult::ErrorSerialization,
+    };
+
+    // Pre-generate the id so the caller can track the document immediately
+    let doc_id = Uuid::new_v4();
+    let id_string = doc_id.to_string();
+    let id_bytes = id_string.as_bytes();
+    if id_bytes.len() >= 36 {
+        ptr::copy_nonoverlapping(id_bytes.as_ptr(), out_document_id as *mut u8, 36);
+        out_document_id.add(36).write(0); // null terminator
+    }
+
+    let operation_id = engine
+        .next_operation_id
+        .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+    if !out_operation_id.is_null() {
+        out_operation_id.write(operation_id);
+    }
+
+    let dispatcher = Arc::clone(&engine.event_dispatcher);
+
+    if let Some(sync_engine) = engine.engine.clone() {
+        // Online mode - use sync engine
+        engine.runtime.spawn(async move {
+            match sync_engine
+                .create_document_with_id(doc_id, content.clone())
+                .await
+            {
+                Ok(_) => {
+                    dispatcher.emit_document_created(&doc_id, &content);
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::Success as i32,
+                        Some(&doc_id),
+                        None,
+                    );
+                }
+                Err(e) => {
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::ErrorConnection as i32,
+                        Some(&doc_id),
+                        Some(&e.to_string()),
+                    );
+                }
+            }
+        });
+    } else {
+        // Offline mode - create locally
+        let database = Arc::clone(&engine.database);
+        engine.runtime.spawn(async move {
+            let result = async {
+                let user_id = database.get_user_id().await?;
+                let doc = replicant_core::models::Document {
+                    id: doc_id,
+                    user_id,
+                    content: content.clone(),
+                    sync_revision: 1,
+                    content_hash: None,
+                    title: None,
+                    created_at: chrono::Utc::now(),
+                    updated_at: chrono::Utc::now(),
+                    deleted_at: None,
+                };
+                database.save_document(&doc).await
+            }
+            .await;
+
+            match result {
+                Ok(_) => {
+                    dispatcher.emit_document_created(&doc_id, &content);
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::Success as i32,
+                        Some(&doc_id),
+                        None,
+                    );
+                }
+                Err(e) => {
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::ErrorDatabase as i32,
+                        Some(&doc_id),
+                        Some(&e.to_string()),
+                    );
+                }
+            }
+        });
+    }
+
+    SyncResult::Success
+}
+
+/// Update an existing document without blocking the calling thread
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `document_id` - Document ID to update
+/// * `content_json` - New document content as JSON string
+/// * `out_operation_id` - Output pointer for the operation id passed to the completion callback (optional)
+///
+/// # Returns
+/// * SyncResult::Success if the operation was enqueued; the final outcome is
+///   reported through the operation callback
+///
+/// # Safety
+/// Caller must ensure engine is valid and both document_id and content_json are valid C strings
+#[no_mangle]
+pub unsafe extern "C" fn replicant_update_document_async(
+    engine: *mut Replicant,
+    document_id: *const c_char,
+    content_json: *const c_char,
+    out_operation_id: *mut u64,
+) -> SyncResult {
+    if engine.is_null() || document_id.is_null() || content_json.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    let document_id = match CStr::from_ptr(document_id).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let doc_uuid = match Uuid::parse_str(document_id) {
+        Ok(id) => id,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let content_json = match CStr::from_ptr(content_json).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let content: Value = match serde_json::from_str(content_json) {
+        Ok(c) => c,
+        Err(_) => return SyncResult::ErrorSerialization,
+    };
+
+    let operation_id = engine
+        .next_operation_id
+        .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+    if !out_operation_id.is_null() {
+        out_operation_id.write(operation_id);
+    }
+
+    let dispatcher = Arc::clone(&engine.event_dispatcher);
+
+    if let Some(sync_engine) = engine.engine.clone() {
+        // Online mode
+        engine.runtime.spawn(async move {
+            match sync_engine.update_document(doc_uuid, content).await {
+                Ok(_) => {
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::Success as i32,
+                        Some(&doc_uuid),
+                        None,
+                    );
+                }
+                Err(e) => {
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::ErrorConnection as i32,
+                        Some(&doc_uuid),
+                        Some(&e.to_string()),
+                    );
+                }
+            }
+        });
+    } else {
+        // Offline mode - update locally
+        let database = Arc::clone(&engine.database);
+        engine.runtime.spawn(async move {
+            let result = async {
+                let mut doc = database.get_document(&doc_uuid).await?;
+                doc.content = content;
+                doc.sync_revision += 1;
+                doc.content_hash = None; // Will be recalculated on server
+                doc.updated_at = chrono::Utc::now();
+                database.save_document(&doc).await?;
+                Ok::<_, replicant_core::errors::SyncError>(doc)
+            }
+            .await;
+
+            match result {
+                Ok(doc) => {
+                    dispatcher.emit_document_updated(&doc_uuid, &doc.content);
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::Success as i32,
+                        Some(&doc_uuid),
+                        None,
+                    );
+                }
+                Err(e) => {
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::ErrorDatabase as i32,
+                        Some(&doc_uuid),
+                        Some(&e.to_string()),
+                    );
+                }
+            }
+        });
+    }
+
+    SyncResult::Success
+}
+
+/// Update a document by applying an RFC-6902 patch without blocking the calling thread
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `document_id` - Document ID to update
+/// * `patch_json` - RFC-6902 JSON Patch array
+/// * `out_operation_id` - Output pointer for the operation id passed to the completion callback (optional)
+///
+/// # Returns
+/// * SyncResult::Success if the operation was enqueued; the final outcome is
+///   reported through the operation callback
+///
+/// # Safety
+/// Caller must ensure engine is valid and both document_id and patch_json are valid C strings
+#[no_mangle]
+pub unsafe extern "C" fn replicant_update_document_patch_async(
+    engine: *mut Replicant,
+    document_id: *const c_char,
+    patch_json: *const c_char,
+    out_operation_id: *mut u64,
+) -> SyncResult {
+    if engine.is_null() || document_id.is_null() || patch_json.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    let document_id = match CStr::from_ptr(document_id).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let doc_uuid = match Uuid::parse_str(document_id) {
+        Ok(id) => id,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let patch_json = match CStr::from_ptr(patch_json).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let patch: json_patch::Patch = match serde_json::from_str(patch_json) {
+        Ok(p) => p,
+        Err(_) => return SyncResult::ErrorSerialization,
+    };
+
+    let operation_id = engine
+        .next_operation_id
+        .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+    if !out_operation_id.is_null() {
+        out_operation_id.write(operation_id);
+    }
+
+    let dispatcher = Arc::clone(&engine.event_dispatcher);
+
+    if let Some(sync_engine) = engine.engine.clone() {
+        // Online mode
+        engine.runtime.spawn(async move {
+            match sync_engine.update_document_with_patch(doc_uuid, patch).await {
+                Ok(_) => {
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::Success as i32,
+                        Some(&doc_uuid),
+                        None,
+                    );
+                }
+                Err(e) => {
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::ErrorConnection as i32,
+                        Some(&doc_uuid),
+                        Some(&e.to_string()),
+                    );
+                }
+            }
+        });
+    } else {
+        // Offline mode - apply the patch locally
+        let database = Arc::clone(&engine.database);
+        engine.runtime.spawn(async move {
+            let result = async {
+                let mut doc = database.get_document(&doc_uuid).await?;
+                replicant_core::patches::apply_patch(&mut doc.content, &patch)?;
+                doc.sync_revision += 1;
+                doc.content_hash = None; // Will be recalculated on server
+                doc.updated_at = chrono::Utc::now();
+                database.save_document(&doc).await?;
+                Ok::<_, replicant_core::errors::SyncError>(doc)
+            }
+            .await;
+
+            match result {
+                Ok(doc) => {
+                    dispatcher.emit_document_updated(&doc_uuid, &doc.content);
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::Success as i32,
+                        Some(&doc_uuid),
+                        None,
+                    );
+                }
+                Err(e) => {
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::ErrorDatabase as i32,
+                        Some(&doc_uuid),
+                        Some(&e.to_string()),
+                    );
+                }
+            }
+        });
+    }
+
+    SyncResult::Success
+}
+
+/// Delete a document without blocking the calling thread
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `document_id` - Document ID to delete
+/// * `out_operation_id` - Output pointer for the operation id passed to the completion callback (optional)
+///
+/// # Returns
+/// * SyncResult::Success if the operation was enqueued; the final outcome is
+///   reported through the operation callback
+///
+/// # Safety
+/// Caller must ensure engine is valid and document_id is a valid C string
+#[no_mangle]
+pub unsafe extern "C" fn replicant_delete_document_async(
+    engine: *mut Replicant,
+    document_id: *const c_char,
+    out_operation_id: *mut u64,
+) -> SyncResult {
+    if engine.is_null() || document_id.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    let document_id = match CStr::from_ptr(document_id).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let doc_uuid = match Uuid::parse_str(document_id) {
+        Ok(id) => id,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let operation_id = engine
+        .next_operation_id
+        .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+    if !out_operation_id.is_null() {
+        out_operation_id.write(operation_id);
+    }
+
+    let dispatcher = Arc::clone(&engine.event_dispatcher);
+
+    if let Some(sync_engine) = engine.engine.clone() {
+        // Online mode
+        engine.runtime.spawn(async move {
+            match sync_engine.delete_document(doc_uuid).await {
+                Ok(_) => {
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::Success as i32,
+                        Some(&doc_uuid),
+                        None,
+                    );
+                }
+                Err(e) => {
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::ErrorConnection as i32,
+                        Some(&doc_uuid),
+                        Some(&e.to_string()),
+                    );
+                }
+            }
+        });
+    } else {
+        // Offline mode
+        let database = Arc::clone(&engine.database);
+        engine.runtime.spawn(async move {
+            match database.delete_document(&doc_uuid).await {
+                Ok(_) => {
+                    dispatcher.emit_document_deleted(&doc_uuid);
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::Success as i32,
+                        Some(&doc_uuid),
+                        None,
+                    );
+                }
+                Err(e) => {
+                    dispatcher.emit_operation_complete(
+                        operation_id,
+                        SyncResult::ErrorDatabase as i32,
+                        Some(&doc_uuid),
+                        Some(&e.to_string()),
+                    );
+                }
+            }
+        });
+    }
+
+    SyncResult::Success
+}
+
+/// Free a C string allocated by this library
+///
+/// # Safety
+/// Caller must ensure the string was allocated by this library and hasn't been freed
+#[no_mangle]
+pub unsafe extern "C" fn replicant_string_free(s: *mut c_char) {
+    if !s.is_null() {
+        let _ = CString::from_raw(s);
+    }
+}
+
+/// Get library version string
+#[no_mangle]
+pub extern "C" fn replicant_get_version() -> *mut c_char {
+    let version = env!("CARGO_PKG_VERSION");
+    match CString::new(version) {
+        Ok(s) => s.into_raw(),
+        Err(_) => ptr::null_mut(),
+    }
+}
+
+/// Register a callback for document events (Created, Updated, Deleted)
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `callback` - C callback function to invoke for document events
+/// * `context` - User-defined context pointer passed to callback
+/// * `event_filter` - Optional filter: 0=Created, 1=Updated, 2=Deleted, -1=all document events
+///
+/// # Returns
+/// * SyncResult indicating success or failure
+///
+/// # Safety
+/// Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+#[no_mangle]
+pub unsafe extern "C" fn replicant_register_document_callback(
+    engine: *mut Replicant,
+    callback: DocumentEventCallback,
+    context: *mut c_void,
+    event_filter: i32,
+) -> SyncResult {
+    if engine.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    let filter = if event_filter >= 0 {
+        match event_filter {
+            0 => Some(EventType::DocumentCreated),
+            1 => Some(EventType::DocumentUpdated),
+            2 => Some(EventType::DocumentDeleted),
+            _ => return SyncResult::ErrorInvalidInput,
+        }
+    } else {
+        None
+    };
+
+    match engine
+        .event_dispatcher
+        .register_document_callback(callback, context, filter)
+    {
+        Ok(_) => SyncResult::Success,
+        Err(_) => SyncResult::ErrorUnknown,
+    }
+}
+
+/// Register a document callback limited to a set of document ids
+///
+/// Like replicant_register_document_callback, but the callback only
+/// receives events whose document id is in the given set. Intended for
+/// per-view listeners that watch one document (or a handful) and should
+/// not be woken by every other document during a sync burst.
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `callback` - C callback function to invoke for matching document events
+/// * `context` - User-defined context pointer passed to callback
+/// * `event_filter` - Event type to filter (0=Created, 1=Updated, 2=Deleted) or -1 for all document events
+/// * `document_ids` - Array of document ID strings (UUIDs) to subscribe to
+/// * `document_count` - Number of entries in document_ids (must be > 0)
+///
+/// # Returns
+/// * SyncResult indicating success or failure
+///
+/// # Safety
+/// Caller must ensure engine is valid, callback is a valid function pointer, document_ids
+/// points to document_count valid C strings, and context pointer outlives the registration
+#[no_mangle]
+pub unsafe extern "C" fn replicant_register_document_callback_for_documents(
+    engine: *mut Replicant,
+    callback: DocumentEventCallback,
+    context: *mut c_void,
+    event_filter: i32,
+    document_ids: *const *const c_char,
+    document_count: usize,
+) -> SyncResult {
+    if engine.is_null() || document_ids.is_null() || document_count == 0 {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    let filter = if event_filter >= 0 {
+        match event_filter {
+            0 => Some(EventType::DocumentCreated),
+            1 => Some(EventType::DocumentUpdated),
+            2 => Some(EventType::DocumentDeleted),
+            _ => return SyncResult::ErrorInvalidInput,
+        }
+    } else {
+        None
+    };
+
+    let mut ids = Vec::with_capacity(document_count);
+    for i in 0..document_count {
+        let id_ptr = *document_ids.add(i);
+        if id_ptr.is_null() {
+            return SyncResult::ErrorInvalidInput;
+        }
+        let id_str = match CStr::from_ptr(id_ptr).to_str() {
+            Ok(s) => s,
+            Err(_) => return SyncResult::ErrorInvalidInput,
+        };
+        match Uuid::parse_str(id_str) {
+            Ok(id) => ids.push(id),
+            Err(_) => return SyncResult::ErrorInvalidInput,
+        }
+    }
+
+    match engine
+        .event_dispatcher
+        .register_document_callback_for_documents(callback, context, filter, ids)
+    {
+        Ok(_) => SyncResult::Success,
+        Err(_) => SyncResult::ErrorUnknown,
+    }
+}
+
+/// Enable or disable document update coalescing (off by default)
+///
+/// When enabled, a burst of consecutive DocumentUpdated events for the
+/// same document is collapsed into the latest one before delivery, so 50
+/// rapid patches during a sync cost one callback invocation (and one UI
+/// refresh) instead of 50. Non-update events and updates to other
+/// documents are never reordered or dropped.
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `enabled` - true to coalesce consecutive updates, false to deliver every event
+///
+/// # Returns
+/// * SyncResult::Success on success
+/// * SyncResult::ErrorInvalidInput if engine is null
+///
+/// # Safety
+/// Caller must ensure engine is a valid pointer
+#[no_mangle]
+pub unsafe extern "C" fn replicant_set_event_coalescing(
+    engine: *mut Replicant,
+    enabled: bool,
+) -> SyncResult {
+    if engine.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+    engine.event_dispatcher.set_update_coalescing(enabled);
+
+    SyncResult::Success
+}
+
+/// Register a callback for sync events (Started, Completed)
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `callback` - C callback function to invoke for sync events
+/// * `context` - User-defined context pointer passed to callback
+///
+/// # Returns
+/// * SyncResult indicating success or failure
+///
+/// # Safety
+/// Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+#[no_mangle]
+pub unsafe extern "C" fn replicant_register_sync_callback(
+    engine: *mut Replicant,
+    callback: SyncEventCallback,
+    context: *mut c_void,
+) -> SyncResult {
+    if engine.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    match engine
+        .event_dispatcher
+        .register_sync_callback(callback, context)
+    {
+        Ok(_) => SyncResult::Success,
+        Err(_) => SyncResult::ErrorUnknown,
+    }
+}
+
+/// Register a callback for error events (SyncError)
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `callback` - C callback function to invoke for error events
+/// * `context` - User-defined context pointer passed to callback
+///
+/// # Returns
+/// * SyncResult indicating success or failure
+///
+/// # Safety
+/// Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+#[no_mangle]
+pub unsafe extern "C" fn replicant_register_error_callback(
+    engine: *mut Replicant,
+    callback: ErrorEventCallback,
+    context: *mut c_void,
+) -> SyncResult {
+    if engine.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    match engine
+        .event_dispatcher
+        .register_error_callback(callback, context)
+    {
+        Ok(_) => SyncResult::Success,
+        Err(_) => SyncResult::ErrorUnknown,
+    }
+}
+
+/// Register a callback for connection events (Lost, Attempted, Succeeded)
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `callback` - C callback function to invoke for connection events
+/// * `context` - User-defined context pointer passed to callback
+///
+/// # Returns
+/// * SyncResult indicating success or failure
+///
+/// # Safety
+/// Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+#[no_mangle]
+pub unsafe extern "C" fn replicant_register_connection_callback(
+    engine: *mut Replicant,
+    callback: ConnectionEventCallback,
+    context: *mut c_void,
+) -> SyncResult {
+    if engine.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    match engine
+        .event_dispatcher
+        .register_connection_callback(callback, context)
+    {
+        Ok(_) => SyncResult::Success,
+        Err(_) => SyncResult::ErrorUnknown,
+    }
+}
+
+/// Register a callback for conflict events (ConflictDetected)
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `callback` - C callback function to invoke for conflict events
+/// * `context` - User-defined context pointer passed to callback
+///
+/// # Returns
+/// * SyncResult indicating success or failure
+///
+/// # Safety
+/// Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+#[no_mangle]
+pub unsafe extern "C" fn replicant_register_conflict_callback(
+    engine: *mut Replicant,
+    callback: ConflictEventCallback,
+    context: *mut c_void,
+) -> SyncResult {
+    if engine.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    match engine
+        .event_dispatcher
+        .register_conflict_callback(callback, context)
+    {
+        Ok(_) => SyncResult::Success,
+        Err(_) => SyncResult::ErrorUnknown,
+    }
+}
+
+/// Install (or clear) a notifier fired when events become available
+///
+/// The notifier fires whenever the event queue goes from empty to
+/// non-empty, so applications can wake their callback thread and call
+/// replicant_process_events immediately instead of polling on a timer.
+/// Pass a null callback to clear the notifier.
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `callback` - Notifier function, or null to clear
+/// * `context` - User-defined context pointer passed to the notifier
+///
+/// # Returns
+/// * SyncResult indicating success or failure
+///
+/// # Important
+/// The notifier is invoked from whichever thread queued the event - NOT
+/// the callback thread. It must only schedule a wake-up (e.g. post a
+/// message-loop update that calls replicant_process_events); it must
+/// never drain events or call back into the engine itself.
+///
+/// # Safety
+/// Caller must ensure engine is valid and context outlives the notifier registration
+#[no_mangle]
+pub unsafe extern "C" fn replicant_set_event_notifier(
+    engine: *mut Replicant,
+    callback: Option<EventNotifierCallback>,
+    context: *mut c_void,
+) -> SyncResult {
+    if engine.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    match engine.event_dispatcher.set_event_notifier(callback, context) {
+        Ok(_) => SyncResult::Success,
+        Err(_) => SyncResult::ErrorUnknown,
+    }
+}
+
+/// Process all queued events on the current thread
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `out_processed_count` - Output pointer for number of events processed (optional)
+///
+/// # Returns
+/// * CSyncResult indicating success or failure
+///
+/// # Important
+/// This function MUST be called on the same thread where callbacks were registered.
+/// Events are queued from any thread but only processed on the callback thread.
+///
+/// # Safety
+/// Caller must ensure engine is valid and out_processed_count points to valid memory (if not null)
+#[no_mangle]
+pub unsafe extern "C" fn replicant_process_events(
+    engine: *mut Replicant,
+    out_processed_count: *mut u32,
+) -> SyncResult {
+    if engine.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    match engine.event_dispatcher.process_events() {
+        Ok(count) => {
+            if !out_processed_count.is_null() {
+                out_processed_count.write(count as u32);
+            }
+            SyncResult::Success
+        }
+        Err(_) => SyncResult::ErrorUnknown,
+    }
+}
+
+/// Process all queued events in a single batched callback invocation
+///
+/// Drains up to `max_events` queued events (0 = no limit) and invokes
+/// `callback` once with an array of event records. All string fields are
+/// backed by one arena allocation per drain, so large syncs cost one
+/// allocation and one FFI crossing instead of one per event.
+///
+/// Events consumed here are NOT delivered to callbacks registered with
+/// replicant_register_*_callback - use one drain API or the other. Async
+/// operation completions are still delivered to a registered operation
+/// callback as part of this call.
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `callback` - Function receiving the batch of event records
+/// * `context` - User-defined context pointer passed to the callback
+/// * `max_events` - Maximum events to drain in this call (0 = no limit)
+/// * `out_processed_count` - Output pointer for number of events processed (optional)
+///
+/// # Returns
+/// * CSyncResult indicating success or failure
+///
+/// # Important
+/// This function MUST be called on the callback thread (established by the
+/// first callback registration or the first call to this function). The
+/// event records and their strings are only valid for the duration of the
+/// callback.
+///
+/// # Safety
+/// Caller must ensure engine is valid and out_processed_count points to valid memory (if not null)
+#[no_mangle]
+pub unsafe extern "C" fn replicant_process_events_batch(
+    engine: *mut Replicant,
+    callback: EventBatchCallback,
+    context: *mut c_void,
+    max_events: u32,
+    out_processed_count: *mut u32,
+) -> SyncResult {
+    if engine.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    match engine
+        .event_dispatcher
+        .process_events_batch(callback, context, max_events as usize)
+    {
+        Ok(count) => {
+            if !out_processed_count.is_null() {
+                out_processed_count.write(count as u32);
+            }
+            SyncResult::Success
+        }
+        Err(_) => SyncResult::ErrorUnknown,
+    }
+}
+
+/// Get a document by ID
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `document_id` - Document ID as UUID string
+/// * `out_content` - Output pointer for document JSON content (caller must free with replicant_string_free)
+///
+/// # Returns
+/// * SyncResult::Success if document found and content returned
+/// * SyncResult::ErrorInvalidInput if document not found or invalid ID
+///
+/// # Safety
+/// Caller must ensure engine is valid, document_id is a valid C string, and out_content is a valid pointer
+#[no_mangle]
+pub unsafe extern "C" fn replicant_get_document(
+    engine: *mut Replicant,
+    document_id: *const c_char,
+    out_content: *mut *mut c_char,
+) -> SyncResult {
+    if engine.is_null() || document_id.is_null() || out_content.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    let document_id = match CStr::from_ptr(document_id).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
     };
 
-    match engine
-        .event_dispatcher
-        .register_document_callback(callback, context, filter)
+    let doc_uuid = match Uuid::parse_str(document_id) {
+        Ok(id) => id,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let doc = match engine
+        .runtime
+        .block_on(async { engine.database.get_document(&doc_uuid).await })
     {
-        Ok(_) => SyncResult::Success,
-        Err(_) => SyncResult::ErrorUnknown,
+        Ok(d) => d,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    // Serialize document to JSON
+    let json = match serde_json::to_string(&doc) {
+        Ok(j) => j,
+        Err(_) => return SyncResult::ErrorSerialization,
+    };
+
+    match CString::new(json) {
+        Ok(c_str) => {
+            *out_content = c_str.into_raw();
+            SyncResult::Success
+        }
+        Err(_) => SyncResult::ErrorSerialization,
     }
 }
 
-/// Register a callback for sync events (Started, Completed)
+/// Arena layout for struct-based document reads: the total allocation
+/// length is stored ahead of the string data so the whole arena can be
+/// reconstructed and freed from the first string pointer alone.
+const DOCUMENT_ARENA_HEADER: usize = std::mem::size_of::<usize>();
+
+/// Owned string fields of one document, staged before arena packing
+struct DocumentStrings {
+    id: String,
+    title: Option<String>,
+    content: String,
+    sync_revision: i64,
+}
+
+impl From<&replicant_core::models::Document> for DocumentStrings {
+    fn from(doc: &replicant_core::models::Document) -> Self {
+        Self {
+            id: doc.id.to_string(),
+            title: doc.title.clone(),
+            content: doc.content.to_string(),
+            sync_revision: doc.sync_revision,
+        }
+    }
+}
+
+/// Copy each document's fields into one arena and produce `Document`
+/// records whose pointers point into it. The first record's `id` always
+/// points at the arena's first string, which is how the free functions
+/// recover the allocation.
+fn build_document_records(docs: &[DocumentStrings]) -> Vec<Document> {
+    fn push_cstr(arena: &mut Vec<u8>, s: Option<&str>) -> Option<usize> {
+        let s = s?;
+        let offset = arena.len();
+        // Interior NULs would truncate the C string; strip them
+        if s.as_bytes().contains(&0) {
+            arena.extend(s.bytes().filter(|&b| b != 0));
+        } else {
+            arena.extend_from_slice(s.as_bytes());
+        }
+        arena.push(0);
+        Some(offset)
+    }
+
+    let arena_len: usize = DOCUMENT_ARENA_HEADER
+        + docs
+            .iter()
+            .map(|d| {
+                d.id.len()
+                    + 1
+                    + d.title.as_ref().map(|t| t.len() + 1).unwrap_or(0)
+                    + d.content.len()
+                    + 1
+            })
+            .sum::<usize>();
+
+    let mut arena: Vec<u8> = Vec::with_capacity(arena_len);
+    arena.extend_from_slice(&[0u8; DOCUMENT_ARENA_HEADER]);
+
+    let offsets: Vec<(usize, Option<usize>, usize)> = docs
+        .iter()
+        .map(|d| {
+            (
+                push_cstr(&mut arena, Some(&d.id)).unwrap(),
+                push_cstr(&mut arena, d.title.as_deref()),
+                push_cstr(&mut arena, Some(&d.content)).unwrap(),
+            )
+        })
+        .collect();
+
+    // Record the final length in the header, then leak the buffer; the
+    // free functions rebuild the Vec from the first string pointer
+    let total = arena.len();
+    arena[..DOCUMENT_ARENA_HEADER].copy_from_slice(&total.to_ne_bytes());
+    let base = Box::into_raw(arena.into_boxed_slice()) as *mut u8;
+
+    docs.iter()
+        .zip(offsets)
+        .map(|(d, (id_off, title_off, content_off))| Document {
+            id: unsafe { base.add(id_off) as *mut c_char },
+            title: title_off
+                .map(|off| unsafe { base.add(off) as *mut c_char })
+                .unwrap_or(ptr::null_mut()),
+            content: unsafe { base.add(content_off) as *mut c_char },
+            sync_revision: d.sync_revision,
+        })
+        .collect()
+}
+
+/// Free the arena backing one or more `Document` records, given the
+/// first record's `id` pointer (always the arena's first string)
+unsafe fn free_document_arena(first_id: *mut c_char) {
+    if first_id.is_null() {
+        return;
+    }
+    let base = (first_id as *mut u8).sub(DOCUMENT_ARENA_HEADER);
+    let total = usize::from_ne_bytes(
+        std::slice::from_raw_parts(base, DOCUMENT_ARENA_HEADER)
+            .try_into()
+            .unwrap(),
+    );
+    let slice = std::slice::from_raw_parts_mut(base, total);
+    drop(Box::from_raw(slice as *mut [u8]));
+}
+
+/// Get a document by ID as a filled `Document` struct
+///
+/// Unlike `replicant_get_document`, which returns one JSON blob the
+/// caller must re-parse, this fills the caller's `Document` with
+/// pointers into a single engine-owned arena: one lookup, no JSON
+/// re-parsing on the caller's side. `title` is null for untitled
+/// documents. Free the arena with `replicant_document_free`.
 ///
 /// # Arguments
 /// * `engine` - Sync engine instance
-/// * `callback` - C callback function to invoke for sync events
-/// * `context` - User-defined context pointer passed to callback
+/// * `document_id` - Document ID as UUID string
+/// * `out_document` - Caller-allocated struct to fill
 ///
 /// # Returns
-/// * SyncResult indicating success or failure
+/// * SyncResult::Success if document found and struct filled
+/// * SyncResult::ErrorInvalidInput if document not found or invalid ID
 ///
 /// # Safety
-/// Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+/// Caller must ensure engine is valid, document_id is a valid C string,
+/// and out_document points to a valid `Document`
 #[no_mangle]
-pub unsafe extern "C" fn replicant_register_sync_callback(
+pub unsafe extern "C" fn replicant_get_document_struct(
     engine: *mut Replicant,
-    callback: SyncEventCallback,
-    context: *mut c_void,
+    document_id: *const c_char,
+    out_document: *mut Document,
 ) -> SyncResult {
-    if engine.is_null() {
+    if engine.is_null() || document_id.is_null() || out_document.is_null() {
         return SyncResult::ErrorInvalidInput;
     }
 
     let engine = &*engine;
 
-    match engine
-        .event_dispatcher
-        .register_sync_callback(callback, context)
+    let document_id = match CStr::from_ptr(document_id).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let doc_uuid = match Uuid::parse_str(document_id) {
+        Ok(id) => id,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let doc = match engine
+        .runtime
+        .block_on(async { engine.database.get_document(&doc_uuid).await })
     {
-        Ok(_) => SyncResult::Success,
-        Err(_) => SyncResult::ErrorUnknown,
+        Ok(d) => d,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let rows = [DocumentStrings::from(&doc)];
+    let mut records = build_document_records(&rows);
+    *out_document = records.pop().unwrap();
+
+    SyncResult::Success
+}
+
+/// Free the arena behind a `Document` filled by replicant_get_document_struct
+///
+/// # Safety
+/// Caller must pass a struct previously filled by
+/// replicant_get_document_struct that hasn't been freed
+#[no_mangle]
+pub unsafe extern "C" fn replicant_document_free(document: *mut Document) {
+    if document.is_null() {
+        return;
     }
+    free_document_arena((*document).id);
+    (*document).id = ptr::null_mut();
+    (*document).title = ptr::null_mut();
+    (*document).content = ptr::null_mut();
 }
 
-/// Register a callback for error events (SyncError)
+/// Get all documents as an array of `Document` structs
+///
+/// Batch form of `replicant_get_document_struct`: every record's strings
+/// point into one shared arena, so a full listing costs two allocations
+/// (records + arena) and zero JSON re-parsing on the caller's side. Free
+/// with `replicant_documents_free`.
 ///
 /// # Arguments
 /// * `engine` - Sync engine instance
-/// * `callback` - C callback function to invoke for error events
-/// * `context` - User-defined context pointer passed to callback
+/// * `out_documents` - Output pointer for the record array (null when empty)
+/// * `out_count` - Output pointer for the number of records
 ///
 /// # Returns
-/// * SyncResult indicating success or failure
+/// * SyncResult::Success with the filled array (count 0 if no documents)
 ///
 /// # Safety
-/// Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+/// Caller must ensure engine is valid and both output pointers are valid
 #[no_mangle]
-pub unsafe extern "C" fn replicant_register_error_callback(
+pub unsafe extern "C" fn replicant_get_all_documents_struct(
     engine: *mut Replicant,
-    callback: ErrorEventCallback,
-    context: *mut c_void,
+    out_documents: *mut *mut Document,
+    out_count: *mut u32,
 ) -> SyncResult {
-    if engine.is_null() {
+    if engine.is_null() || out_documents.is_null() || out_count.is_null() {
         return SyncResult::ErrorInvalidInput;
     }
 
     let engine = &*engine;
 
-    match engine
-        .event_dispatcher
-        .register_error_callback(callback, context)
+    let docs = match engine
+        .runtime
+        .block_on(async { engine.database.get_all_documents().await })
     {
-        Ok(_) => SyncResult::Success,
-        Err(_) => SyncResult::ErrorUnknown,
+        Ok(d) => d,
+        Err(_) => return SyncResult::ErrorDatabase,
+    };
+
+    if docs.is_empty() {
+        *out_documents = ptr::null_mut();
+        *out_count = 0;
+        return SyncResult::Success;
     }
+
+    let rows: Vec<DocumentStrings> = docs.iter().map(DocumentStrings::from).collect();
+    let records = build_document_records(&rows);
+    *out_count = records.len() as u32;
+    *out_documents = Box::into_raw(records.into_boxed_slice()) as *mut Document;
+
+    SyncResult::Success
 }
 
-/// Register a callback for connection events (Lost, Attempted, Succeeded)
+/// Free an array returned by replicant_get_all_documents_struct
+///
+/// # Safety
+/// Caller must pass the pointer and count exactly as returned by
+/// replicant_get_all_documents_struct, at most once
+#[no_mangle]
+pub unsafe extern "C" fn replicant_documents_free(documents: *mut Document, count: u32) {
+    if documents.is_null() || count == 0 {
+        return;
+    }
+    free_document_arena((*documents).id);
+    let slice = std::slice::from_raw_parts_mut(documents, count as usize);
+    drop(Box::from_raw(slice as *mut [Document]));
+}
+
+/// Set the byte budget of the in-process document read cache
+///
+/// Repeat replicant_get_document calls for the same document are served
+/// from memory until the document changes. The cache holds at most
+/// `max_bytes` of document content (least-recently-used documents are
+/// evicted first). Pass 0 to disable caching entirely.
 ///
 /// # Arguments
 /// * `engine` - Sync engine instance
-/// * `callback` - C callback function to invoke for connection events
-/// * `context` - User-defined context pointer passed to callback
+/// * `max_bytes` - Maximum cache size in bytes (0 disables the cache)
 ///
 /// # Returns
-/// * SyncResult indicating success or failure
+/// * SyncResult::Success on success
+/// * SyncResult::ErrorInvalidInput if engine is null
 ///
 /// # Safety
-/// Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+/// Caller must ensure engine is a valid pointer
 #[no_mangle]
-pub unsafe extern "C" fn replicant_register_connection_callback(
+pub unsafe extern "C" fn replicant_set_document_cache_budget(
     engine: *mut Replicant,
-    callback: ConnectionEventCallback,
-    context: *mut c_void,
+    max_bytes: usize,
 ) -> SyncResult {
     if engine.is_null() {
         return SyncResult::ErrorInvalidInput;
     }
 
     let engine = &*engine;
+    engine.database.set_document_cache_budget(max_bytes);
 
-    match engine
-        .event_dispatcher
-        .register_connection_callback(callback, context)
-    {
-        Ok(_) => SyncResult::Success,
-        Err(_) => SyncResult::ErrorUnknown,
-    }
+    SyncResult::Success
 }
 
-/// Register a callback for conflict events (ConflictDetected)
+/// Get all documents as a JSON array
 ///
 /// # Arguments
 /// * `engine` - Sync engine instance
-/// * `callback` - C callback function to invoke for conflict events
-/// * `context` - User-defined context pointer passed to callback
+/// * `out_documents` - Output pointer for JSON array of documents (caller must free with replicant_string_free)
 ///
 /// # Returns
-/// * SyncResult indicating success or failure
+/// * SyncResult::Success with JSON array (empty array [] if no documents)
 ///
 /// # Safety
-/// Caller must ensure engine is valid, callback is a valid function pointer, and context pointer outlives the callback registration
+/// Caller must ensure engine is valid and out_documents is a valid pointer
 #[no_mangle]
-pub unsafe extern "C" fn replicant_register_conflict_callback(
+pub unsafe extern "C" fn replicant_get_all_documents(
     engine: *mut Replicant,
-    callback: ConflictEventCallback,
-    context: *mut c_void,
+    out_documents: *mut *mut c_char,
 ) -> SyncResult {
-    if engine.is_null() {
+    if engine.is_null() || out_documents.is_null() {
         return SyncResult::ErrorInvalidInput;
     }
 
     let engine = &*engine;
 
-    match engine
-        .event_dispatcher
-        .register_conflict_callback(callback, context)
+    let docs = match engine
+        .runtime
+        .block_on(async { engine.database.get_all_documents().await })
     {
-        Ok(_) => SyncResult::Success,
-        Err(_) => SyncResult::ErrorUnknown,
+        Ok(d) => d,
+        Err(_) => return SyncResult::ErrorDatabase,
+    };
+
+    // Serialize documents array to JSON
+    let json = match serde_json::to_string(&docs) {
+        Ok(j) => j,
+        Err(_) => return SyncResult::ErrorSerialization,
+    };
+
+    match CString::new(json) {
+        Ok(c_str) => {
+            *out_documents = c_str.into_raw();
+            SyncResult::Success
+        }
+        Err(_) => SyncResult::ErrorSerialization,
     }
 }
 
-/// Process all queued events on the current thread
+/// Get metadata for all documents as a JSON array (no content bodies)
 ///
 /// # Arguments
 /// * `engine` - Sync engine instance
-/// * `out_processed_count` - Output pointer for number of events processed (optional)
+/// * `out_metadata` - Output pointer for JSON array of metadata objects
+///   `{"id", "title", "sync_revision", "updated_at"}` (caller must free with replicant_string_free)
 ///
 /// # Returns
-/// * CSyncResult indicating success or failure
+/// * SyncResult::Success with JSON array (empty array [] if no documents)
 ///
-/// # Important
-/// This function MUST be called on the same thread where callbacks were registered.
-/// Events are queued from any thread but only processed on the callback thread.
+/// # Note
+/// Use this instead of replicant_get_all_documents for list views: content
+/// bodies are never read or deserialized, so listing tens of thousands of
+/// documents costs kilobytes rather than the size of every body.
 ///
 /// # Safety
-/// Caller must ensure engine is valid and out_processed_count points to valid memory (if not null)
+/// Caller must ensure engine is valid and out_metadata is a valid pointer
 #[no_mangle]
-pub unsafe extern "C" fn replicant_process_events(
+pub unsafe extern "C" fn replicant_get_documents_metadata(
     engine: *mut Replicant,
-    out_processed_count: *mut u32,
+    out_metadata: *mut *mut c_char,
 ) -> SyncResult {
-    if engine.is_null() {
+    if engine.is_null() || out_metadata.is_null() {
         return SyncResult::ErrorInvalidInput;
     }
 
     let engine = &*engine;
 
-    match engine.event_dispatcher.process_events() {
-        Ok(count) => {
-            if !out_processed_count.is_null() {
-                out_processed_count.write(count as u32);
-            }
+    let metadata = match engine
+        .runtime
+        .block_on(async { engine.database.get_documents_metadata().await })
+    {
+        Ok(m) => m,
+        Err(_) => return SyncResult::ErrorDatabase,
+    };
+
+    let json = match serde_json::to_string(&metadata) {
+        Ok(j) => j,
+        Err(_) => return SyncResult::ErrorSerialization,
+    };
+
+    match CString::new(json) {
+        Ok(c_str) => {
+            *out_metadata = c_str.into_raw();
             SyncResult::Success
         }
-        Err(_) => SyncResult::ErrorUnknown,
+        Err(_) => SyncResult::ErrorSerialization,
     }
 }
 
-/// Get a document by ID
+/// Read the cold-start snapshot for a database without opening an engine
 ///
 /// # Arguments
-/// * `engine` - Sync engine instance
-/// * `document_id` - Document ID as UUID string
-/// * `out_content` - Output pointer for document JSON content (caller must free with replicant_string_free)
+/// * `database_path` - Same database path/URL that would be passed to
+///   replicant_create; the snapshot file lives next to the database
+/// * `out_documents` - Output pointer for a JSON array of
+///   `{"id", "title", "sync_revision", "updated_at", "content"}` objects
+///   (caller must free with replicant_string_free)
 ///
 /// # Returns
-/// * SyncResult::Success if document found and content returned
-/// * SyncResult::ErrorInvalidInput if document not found or invalid ID
+/// * SyncResult::Success with the snapshot contents
+/// * SyncResult::ErrorDatabase if no snapshot exists yet or it is corrupt
+///
+/// # Note
+/// This opens nothing but a memory-mapped file - no SQLite, no migrations,
+/// no network - so an app can render its document list within milliseconds
+/// of launch while replicant_create initializes in the background. The
+/// snapshot is written periodically by a running engine and may be up to
+/// one write interval stale; replace the snapshot view with live data once
+/// the engine is up.
 ///
 /// # Safety
-/// Caller must ensure engine is valid, document_id is a valid C string, and out_content is a valid pointer
+/// Caller must ensure database_path is a valid C string and out_documents
+/// is a valid pointer
 #[no_mangle]
-pub unsafe extern "C" fn replicant_get_document(
-    engine: *mut Replicant,
-    document_id: *const c_char,
-    out_content: *mut *mut c_char,
+pub unsafe extern "C" fn replicant_open_snapshot(
+    database_path: *const c_char,
+    out_documents: *mut *mut c_char,
 ) -> SyncResult {
-    if engine.is_null() || document_id.is_null() || out_content.is_null() {
+    if database_path.is_null() || out_documents.is_null() {
         return SyncResult::ErrorInvalidInput;
     }
 
-    let engine = &*engine;
-
-    let document_id = match CStr::from_ptr(document_id).to_str() {
+    let database_path = match CStr::from_ptr(database_path).to_str() {
         Ok(s) => s,
         Err(_) => return SyncResult::ErrorInvalidInput,
     };
 
-    let doc_uuid = match Uuid::parse_str(document_id) {
-        Ok(id) => id,
-        Err(_) => return SyncResult::ErrorInvalidInput,
+    let snapshot_path = match crate::snapshot::snapshot_path(database_path) {
+        Some(p) => p,
+        None => return SyncResult::ErrorInvalidInput,
     };
 
-    let doc = match engine
-        .runtime
-        .block_on(async { engine.database.get_document(&doc_uuid).await })
-    {
-        Ok(d) => d,
-        Err(_) => return SyncResult::ErrorInvalidInput,
+    let snapshot = match crate::snapshot::Snapshot::open(&snapshot_path) {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorDatabase,
     };
 
-    // Serialize document to JSON
-    let json = match serde_json::to_string(&doc) {
+    let json = match snapshot.documents_json() {
         Ok(j) => j,
-        Err(_) => return SyncResult::ErrorSerialization,
+        Err(_) => return SyncResult::ErrorDatabase,
     };
 
     match CString::new(json) {
         Ok(c_str) => {
-            *out_content = c_str.into_raw();
+            *out_documents = c_str.into_raw();
             SyncResult::Success
         }
         Err(_) => SyncResult::ErrorSerialization,
     }
 }
 
-/// Get all documents as a JSON array
+/// Opaque handle to an incremental document cursor
+///
+/// Pages documents out of SQLite in fixed-size batches so callers can
+/// iterate large document sets without materializing them in one string.
+pub struct DocumentCursor {
+    database: Arc<ClientDatabase>,
+    runtime: tokio::runtime::Handle,
+    last_id: Option<Uuid>,
+    exhausted: bool,
+}
+
+/// Open a cursor over all (non-deleted) local documents
 ///
 /// # Arguments
 /// * `engine` - Sync engine instance
-/// * `out_documents` - Output pointer for JSON array of documents (caller must free with replicant_string_free)
 ///
 /// # Returns
-/// * SyncResult::Success with JSON array (empty array [] if no documents)
+/// * Pointer to a DocumentCursor on success, null on failure
+///
+/// # Note
+/// Unlike replicant_get_all_documents, the cursor pages rows out of SQLite
+/// incrementally (ordered by document id), so memory stays flat no matter
+/// how many documents exist. Documents created while iterating may or may
+/// not be observed by the cursor.
 ///
 /// # Safety
-/// Caller must ensure engine is valid and out_documents is a valid pointer
+/// Caller must ensure engine is valid, must free the cursor with
+/// replicant_cursor_destroy, and must not use the cursor after the engine
+/// has been destroyed
 #[no_mangle]
-pub unsafe extern "C" fn replicant_get_all_documents(
+pub unsafe extern "C" fn replicant_open_document_cursor(
     engine: *mut Replicant,
+) -> *mut DocumentCursor {
+    if engine.is_null() {
+        return ptr::null_mut();
+    }
+
+    let engine = &*engine;
+
+    Box::into_raw(Box::new(DocumentCursor {
+        database: Arc::clone(&engine.database),
+        runtime: engine.runtime.handle().clone(),
+        last_id: None,
+        exhausted: false,
+    }))
+}
+
+/// Fetch the next batch of documents from a cursor
+///
+/// # Arguments
+/// * `cursor` - Cursor created by replicant_open_document_cursor
+/// * `batch_size` - Maximum number of documents to return (0 for default of 100)
+/// * `out_documents` - Output pointer for JSON array of documents (caller must free with replicant_string_free)
+/// * `out_count` - Output pointer for the number of documents in the batch (optional)
+///
+/// # Returns
+/// * SyncResult::Success with a JSON array in out_documents; an empty array
+///   (and out_count of 0) means the cursor is exhausted
+/// * SyncResult::ErrorDatabase if the page query fails
+///
+/// # Safety
+/// Caller must ensure cursor and out_documents are valid pointers and
+/// out_count (if not null) points to valid memory
+#[no_mangle]
+pub unsafe extern "C" fn replicant_cursor_next_batch(
+    cursor: *mut DocumentCursor,
+    batch_size: u32,
     out_documents: *mut *mut c_char,
+    out_count: *mut u32,
 ) -> SyncResult {
-    if engine.is_null() || out_documents.is_null() {
+    if cursor.is_null() || out_documents.is_null() {
         return SyncResult::ErrorInvalidInput;
     }
 
-    let engine = &*engine;
+    let cursor = &mut *cursor;
 
-    let docs = match engine
-        .runtime
-        .block_on(async { engine.database.get_all_documents().await })
-    {
-        Ok(d) => d,
-        Err(_) => return SyncResult::ErrorDatabase,
+    let limit = if batch_size == 0 { 100 } else { batch_size as i64 };
+
+    let docs = if cursor.exhausted {
+        Vec::new()
+    } else {
+        let database = Arc::clone(&cursor.database);
+        let after_id = cursor.last_id;
+        match cursor
+            .runtime
+            .block_on(async move { database.get_documents_page(after_id.as_ref(), limit).await })
+        {
+            Ok(d) => d,
+            Err(_) => return SyncResult::ErrorDatabase,
+        }
     };
 
-    // Serialize documents array to JSON
+    if (docs.len() as i64) < limit {
+        cursor.exhausted = true;
+    }
+    if let Some(last) = docs.last() {
+        cursor.last_id = Some(last.id);
+    }
+
+    // Serialize just this batch to JSON
     let json = match serde_json::to_string(&docs) {
         Ok(j) => j,
         Err(_) => return SyncResult::ErrorSerialization,
@@ -832,12 +2665,27 @@ pub unsafe extern "C" fn replicant_get_all_documents(
     match CString::new(json) {
         Ok(c_str) => {
             *out_documents = c_str.into_raw();
+            if !out_count.is_null() {
+                out_count.write(docs.len() as u32);
+            }
             SyncResult::Success
         }
         Err(_) => SyncResult::ErrorSerialization,
     }
 }
 
+/// Destroy a document cursor and free its memory
+///
+/// # Safety
+/// Caller must ensure the cursor was created by replicant_open_document_cursor
+/// and hasn't been freed
+#[no_mangle]
+pub unsafe extern "C" fn replicant_cursor_destroy(cursor: *mut DocumentCursor) {
+    if !cursor.is_null() {
+        let _ = Box::from_raw(cursor);
+    }
+}
+
 /// Get the count of local documents
 ///
 /// # Arguments
@@ -942,6 +2790,101 @@ pub unsafe extern "C" fn replicant_count_pending_sync(
     SyncResult::Success
 }
 
+/// Collect the current metrics snapshot for an instance
+///
+/// Sync and transport counters come from the sync engine's registry when
+/// one exists; query timings come from the database handle the C API
+/// reads and writes through, and the event queue depth from the
+/// dispatcher serving the registered C callbacks.
+fn collect_metrics(engine: &Replicant) -> crate::metrics::MetricsSnapshot {
+    let mut snapshot = match &engine.engine {
+        Some(sync_engine) => sync_engine.metrics(),
+        None => crate::metrics::MetricsSnapshot::default(),
+    };
+    snapshot.db_query = engine.database.metrics.db_query.snapshot();
+    snapshot.event_queue_depth = engine.event_dispatcher.pending_event_count() as u64;
+    snapshot
+}
+
+/// Get a metrics snapshot as a JSON string
+///
+/// The snapshot covers upload latency, heartbeat round-trip time, SQLite
+/// query timings, upload retry counts and the event queue depth. All
+/// counters are always on; reading them is cheap and side-effect free.
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `out_json` - Output pointer for the JSON string (caller must free with replicant_string_free)
+///
+/// # Returns
+/// * SyncResult::Success with JSON written to out_json
+///
+/// # Safety
+/// Caller must ensure engine is valid and out_json is a valid pointer
+#[no_mangle]
+pub unsafe extern "C" fn replicant_get_metrics(
+    engine: *mut Replicant,
+    out_json: *mut *mut c_char,
+) -> SyncResult {
+    if engine.is_null() || out_json.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+    let snapshot = collect_metrics(engine);
+
+    let json = match serde_json::to_string(&snapshot) {
+        Ok(j) => j,
+        Err(_) => return SyncResult::ErrorSerialization,
+    };
+
+    match CString::new(json) {
+        Ok(c_str) => {
+            *out_json = c_str.into_raw();
+            SyncResult::Success
+        }
+        Err(_) => SyncResult::ErrorSerialization,
+    }
+}
+
+/// Get a metrics snapshot as a plain struct, without any allocation
+///
+/// Same numbers as `replicant_get_metrics`, for callers that want typed
+/// fields instead of JSON.
+///
+/// # Arguments
+/// * `engine` - Sync engine instance
+/// * `out_metrics` - Output pointer the snapshot is written to
+///
+/// # Returns
+/// * SyncResult::Success with the snapshot written to out_metrics
+///
+/// # Safety
+/// Caller must ensure engine is valid and out_metrics is a valid pointer
+#[no_mangle]
+pub unsafe extern "C" fn replicant_get_metrics_struct(
+    engine: *mut Replicant,
+    out_metrics: *mut ClientMetrics,
+) -> SyncResult {
+    if engine.is_null() || out_metrics.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+    let snapshot = collect_metrics(engine);
+
+    *out_metrics = ClientMetrics {
+        sync_upload_latency: MetricsTiming::from_snapshot(snapshot.sync_upload_latency),
+        ws_rtt: MetricsTiming::from_snapshot(snapshot.ws_rtt),
+        db_query: MetricsTiming::from_snapshot(snapshot.db_query),
+        uploads_confirmed: snapshot.uploads_confirmed,
+        upload_failures: snapshot.upload_failures,
+        upload_retries: snapshot.upload_retries,
+        event_queue_depth: snapshot.event_queue_depth,
+    };
+    SyncResult::Success
+}
+
 // ===== FTS (Full-Text Search) Functions =====
 
 /// Configure which JSON paths to index for full-text search
@@ -1057,6 +3000,201 @@ pub unsafe extern "C" fn replicant_search_documents(
     }
 }
 
+/// Search documents using FTS5, returning metadata only (no content bodies)
+///
+/// # Arguments
+/// * `engine` - Replicant client instance
+/// * `query` - FTS5 query string (same syntax as replicant_search_documents)
+/// * `limit` - Maximum number of results (0 for default of 100)
+/// * `out_metadata` - Output pointer for JSON array of metadata objects
+///   `{"id", "title", "sync_revision", "updated_at"}`
+///
+/// # Returns
+/// * SyncResult::Success with JSON array in out_metadata
+/// * SyncResult::ErrorInvalidInput if query is invalid
+/// * SyncResult::ErrorDatabase if search fails
+///
+/// # Note
+/// Same matching and ranking as replicant_search_documents, but result rows
+/// skip the content column entirely - use this to populate search result
+/// lists, then fetch individual bodies with replicant_get_document.
+///
+/// # Safety
+/// Caller must ensure engine is valid, query is a valid C string,
+/// and out_metadata is a valid pointer. Caller must free result with replicant_string_free.
+#[no_mangle]
+pub unsafe extern "C" fn replicant_search_documents_metadata(
+    engine: *mut Replicant,
+    query: *const c_char,
+    limit: u32,
+    out_metadata: *mut *mut c_char,
+) -> SyncResult {
+    if engine.is_null() || query.is_null() || out_metadata.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    let query = match CStr::from_ptr(query).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let limit = if limit == 0 { 100 } else { limit as i64 };
+
+    let metadata = match engine
+        .runtime
+        .block_on(async { engine.database.search_documents_metadata(query, limit).await })
+    {
+        Ok(m) => m,
+        Err(_) => return SyncResult::ErrorDatabase,
+    };
+
+    let json = match serde_json::to_string(&metadata) {
+        Ok(j) => j,
+        Err(_) => return SyncResult::ErrorSerialization,
+    };
+
+    match CString::new(json) {
+        Ok(c_str) => {
+            *out_metadata = c_str.into_raw();
+            SyncResult::Success
+        }
+        Err(_) => SyncResult::ErrorSerialization,
+    }
+}
+
+/// Search documents using FTS5, returning one bm25-ordered page
+///
+/// # Arguments
+/// * `engine` - Replicant client instance
+/// * `query` - FTS5 query string (same syntax as replicant_search_documents)
+/// * `limit` - Maximum number of results (0 for default of 100)
+/// * `offset` - Number of ranked results to skip (for pagination)
+/// * `out_documents` - Output pointer for JSON array of matching documents
+///
+/// # Returns
+/// * SyncResult::Success with JSON array in out_documents
+/// * SyncResult::ErrorInvalidInput if query is invalid
+/// * SyncResult::ErrorDatabase if search fails
+///
+/// # Safety
+/// Caller must ensure engine is valid, query is a valid C string, and
+/// out_documents is a valid pointer. Free result with replicant_string_free
+#[no_mangle]
+pub unsafe extern "C" fn replicant_search_documents_page(
+    engine: *mut Replicant,
+    query: *const c_char,
+    limit: u32,
+    offset: u32,
+    out_documents: *mut *mut c_char,
+) -> SyncResult {
+    if engine.is_null() || query.is_null() || out_documents.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    let query = match CStr::from_ptr(query).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let limit = if limit == 0 { 100 } else { limit as i64 };
+
+    let docs = match engine.runtime.block_on(async {
+        engine
+            .database
+            .search_documents_page(query, limit, offset as i64)
+            .await
+    }) {
+        Ok(d) => d,
+        Err(_) => return SyncResult::ErrorDatabase,
+    };
+
+    let json = match serde_json::to_string(&docs) {
+        Ok(j) => j,
+        Err(_) => return SyncResult::ErrorSerialization,
+    };
+
+    match CString::new(json) {
+        Ok(c_str) => {
+            *out_documents = c_str.into_raw();
+            SyncResult::Success
+        }
+        Err(_) => SyncResult::ErrorSerialization,
+    }
+}
+
+/// Search documents using FTS5, returning ranked snippets only
+///
+/// The cheap projection for search-as-you-type: each hit is
+/// `{"id", "title", "rank", "snippet"}` — no content bodies are read or
+/// serialized. `rank` is the bm25 score (lower is more relevant) and
+/// `snippet` comes from FTS5's snippet() with matches wrapped in
+/// `<b>`/`</b>`. Fetch the full body with replicant_get_document for
+/// the hit the user opens.
+///
+/// # Arguments
+/// * `engine` - Replicant client instance
+/// * `query` - FTS5 query string (same syntax as replicant_search_documents)
+/// * `limit` - Maximum number of results (0 for default of 100)
+/// * `offset` - Number of ranked results to skip (for pagination)
+/// * `out_hits` - Output pointer for JSON array of hit objects
+///
+/// # Returns
+/// * SyncResult::Success with JSON array in out_hits
+/// * SyncResult::ErrorInvalidInput if query is invalid
+/// * SyncResult::ErrorDatabase if search fails
+///
+/// # Safety
+/// Caller must ensure engine is valid, query is a valid C string, and
+/// out_hits is a valid pointer. Free result with replicant_string_free
+#[no_mangle]
+pub unsafe extern "C" fn replicant_search_documents_snippets(
+    engine: *mut Replicant,
+    query: *const c_char,
+    limit: u32,
+    offset: u32,
+    out_hits: *mut *mut c_char,
+) -> SyncResult {
+    if engine.is_null() || query.is_null() || out_hits.is_null() {
+        return SyncResult::ErrorInvalidInput;
+    }
+
+    let engine = &*engine;
+
+    let query = match CStr::from_ptr(query).to_str() {
+        Ok(s) => s,
+        Err(_) => return SyncResult::ErrorInvalidInput,
+    };
+
+    let limit = if limit == 0 { 100 } else { limit as i64 };
+
+    let hits = match engine.runtime.block_on(async {
+        engine
+            .database
+            .search_documents_snippets(query, limit, offset as i64)
+            .await
+    }) {
+        Ok(h) => h,
+        Err(_) => return SyncResult::ErrorDatabase,
+    };
+
+    let json = match serde_json::to_string(&hits) {
+        Ok(j) => j,
+        Err(_) => return SyncResult::ErrorSerialization,
+    };
+
+    match CString::new(json) {
+        Ok(c_str) => {
+            *out_hits = c_str.into_raw();
+            SyncResult::Success
+        }
+        Err(_) => SyncResult::ErrorSerialization,
+    }
+}
+
 /// Rebuild the full-text search index
 ///
 /// # Arguments
@@ -1088,3 +3226,46 @@ pub unsafe extern "C" fn replicant_rebuild_search_index(engine: *mut Replicant)
         Err(_) => SyncResult::ErrorDatabase,
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::ffi::CStr;
+
+    #[test]
+    fn test_document_arena_round_trip() {
+        let rows = vec![
+            DocumentStrings {
+                id: "doc-1".to_string(),
+                title: Some("First".to_string()),
+                content: "{\"a\":1}".to_string(),
+                sync_revision: 3,
+            },
+            DocumentStrings {
+                id: "doc-2".to_string(),
+                title: None,
+                content: "{\"b\":2}".to_string(),
+                sync_revision: 7,
+            },
+        ];
+
+        let records = build_document_records(&rows);
+        unsafe {
+            assert_eq!(CStr::from_ptr(records[0].id).to_str().unwrap(), "doc-1");
+            assert_eq!(CStr::from_ptr(records[0].title).to_str().unwrap(), "First");
+            assert_eq!(
+                CStr::from_ptr(records[0].content).to_str().unwrap(),
+                "{\"a\":1}"
+            );
+            assert_eq!(records[0].sync_revision, 3);
+
+            assert_eq!(CStr::from_ptr(records[1].id).to_str().unwrap(), "doc-2");
+            assert!(records[1].title.is_null());
+            assert_eq!(records[1].sync_revision, 7);
+
+            // One arena backs every record; freeing from the first id
+            // releases it all (Miri/ASan would flag a mismatched layout)
+            free_document_arena(records[0].id);
+        }
+    }
+}
@@ -1,8 +1,12 @@
+pub mod cache;
 pub mod client;
 pub mod database;
 pub mod events;
+pub mod metrics;
 pub mod offline_queue;
 pub mod queries;
+pub mod snapshot;
+pub mod upload_scheduler;
 pub mod websocket;
 
 // C FFI module
@@ -49,6 +53,7 @@ mod tests {
                 local_changes JSON,
                 sync_status TEXT DEFAULT 'synced',
                 title TEXT,
+                content_hash TEXT,
                 CHECK (sync_status IN ('synced', 'pending', 'conflict'))
             );
             "#,
@@ -80,7 +85,7 @@ mod tests {
             id: Uuid::new_v4(),
             user_id,
             content: content.clone(),
-            content_hash: None,
+            content_hash: Some("xxh3:00112233445566778899aabbccddeeff".to_string()),
             title: None,
             sync_revision: 1,
             created_at: chrono::Utc::now(),
@@ -96,6 +101,9 @@ mod tests {
         assert_eq!(loaded_doc.id, doc.id);
         // Title is now part of content JSON, so just compare the content
         assert_eq!(loaded_doc.content, doc.content);
+        // The stored hash must survive the round trip so the incremental
+        // checksum path has a starting point on the next update
+        assert_eq!(loaded_doc.content_hash, doc.content_hash);
     }
 
     #[test]
@@ -158,6 +166,7 @@ mod tests {
                 local_changes JSON,
                 sync_status TEXT DEFAULT 'synced',
                 title TEXT,
+                content_hash TEXT,
                 CHECK (sync_status IN ('synced', 'pending', 'conflict'))
             );
             "#,
@@ -236,6 +245,7 @@ mod tests {
                 local_changes JSON,
                 sync_status TEXT DEFAULT 'synced',
                 title TEXT,
+                content_hash TEXT,
                 CHECK (sync_status IN ('synced', 'pending', 'conflict'))
             );
             "#,
@@ -0,0 +1,218 @@
+//! Always-on client metrics registry
+//!
+//! Lightweight counters and timing summaries for the paths that matter
+//! when a user reports "sync feels slow": upload round trips, the
+//! heartbeat RTT, SQLite query timings, upload retries and the event
+//! queue depth. Recording a sample is a few relaxed atomic operations,
+//! so the registry stays enabled in release builds. Snapshots are read
+//! through `Client::metrics` or `replicant_get_metrics` in the C API.
+
+use serde::Serialize;
+use std::collections::HashSet;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::Mutex;
+use std::time::{Duration, Instant};
+use uuid::Uuid;
+
+/// Running summary of one operation's wall-clock timings, in microseconds
+#[derive(Debug, Default)]
+pub struct TimingStats {
+    count: AtomicU64,
+    total_us: AtomicU64,
+    /// 0 means "no samples yet"
+    min_us: AtomicU64,
+    max_us: AtomicU64,
+    last_us: AtomicU64,
+}
+
+impl TimingStats {
+    pub fn record(&self, elapsed: Duration) {
+        let us = elapsed.as_micros() as u64;
+        self.count.fetch_add(1, Ordering::Relaxed);
+        self.total_us.fetch_add(us, Ordering::Relaxed);
+        self.last_us.store(us, Ordering::Relaxed);
+        self.max_us.fetch_max(us, Ordering::Relaxed);
+        let _ = self
+            .min_us
+            .fetch_update(Ordering::Relaxed, Ordering::Relaxed, |current| {
+                if current == 0 || us < current {
+                    Some(us)
+                } else {
+                    None
+                }
+            });
+    }
+
+    pub fn snapshot(&self) -> TimingSnapshot {
+        let count = self.count.load(Ordering::Relaxed);
+        let total_us = self.total_us.load(Ordering::Relaxed);
+        TimingSnapshot {
+            count,
+            total_us,
+            mean_us: if count > 0 { total_us / count } else { 0 },
+            min_us: self.min_us.load(Ordering::Relaxed),
+            max_us: self.max_us.load(Ordering::Relaxed),
+            last_us: self.last_us.load(Ordering::Relaxed),
+        }
+    }
+}
+
+/// Point-in-time view of a [`TimingStats`]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Serialize)]
+pub struct TimingSnapshot {
+    pub count: u64,
+    pub total_us: u64,
+    pub mean_us: u64,
+    pub min_us: u64,
+    pub max_us: u64,
+    pub last_us: u64,
+}
+
+/// The registry itself. One instance lives in `ClientDatabase` so the
+/// database layer can time its own queries, and the sync engine shares
+/// that same instance for its upload and transport counters.
+#[derive(Debug, Default)]
+pub struct Metrics {
+    /// Upload send to server confirmation, per document
+    pub sync_upload_latency: TimingStats,
+    /// Heartbeat ping to matching pong
+    pub ws_rtt: TimingStats,
+    /// SQLite statement timings (cache hits are not queries and don't count)
+    pub db_query: TimingStats,
+    pub uploads_confirmed: AtomicU64,
+    pub upload_failures: AtomicU64,
+    pub upload_retries: AtomicU64,
+    ping_sent_at: Mutex<Option<Instant>>,
+    /// Documents sent but not yet confirmed; re-sending one counts as a retry
+    unconfirmed_uploads: Mutex<HashSet<Uuid>>,
+}
+
+impl Metrics {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Called when a heartbeat ping goes out on the socket
+    pub fn mark_ping_sent(&self) {
+        *self.ping_sent_at.lock().unwrap() = Some(Instant::now());
+    }
+
+    /// Called when the matching pong arrives; records one RTT sample
+    pub fn record_pong(&self) {
+        if let Some(sent) = self.ping_sent_at.lock().unwrap().take() {
+            self.ws_rtt.record(sent.elapsed());
+        }
+    }
+
+    /// Called when an upload is sent. Sending a document that was already
+    /// sent and never confirmed counts as a retry
+    pub fn note_upload_sent(&self, document_id: &Uuid) {
+        let mut unconfirmed = self.unconfirmed_uploads.lock().unwrap();
+        if !unconfirmed.insert(*document_id) {
+            self.upload_retries.fetch_add(1, Ordering::Relaxed);
+        }
+    }
+
+    /// Called when the server confirms an upload
+    pub fn note_upload_confirmed(&self, document_id: &Uuid, latency: Duration) {
+        self.unconfirmed_uploads.lock().unwrap().remove(document_id);
+        self.uploads_confirmed.fetch_add(1, Ordering::Relaxed);
+        self.sync_upload_latency.record(latency);
+    }
+
+    /// Called when the server rejects an upload
+    pub fn note_upload_failed(&self) {
+        self.upload_failures.fetch_add(1, Ordering::Relaxed);
+    }
+
+    /// Point-in-time snapshot. The event queue depth is sampled by the
+    /// caller from whichever dispatcher serves its callbacks
+    pub fn snapshot(&self, event_queue_depth: usize) -> MetricsSnapshot {
+        MetricsSnapshot {
+            sync_upload_latency: self.sync_upload_latency.snapshot(),
+            ws_rtt: self.ws_rtt.snapshot(),
+            db_query: self.db_query.snapshot(),
+            uploads_confirmed: self.uploads_confirmed.load(Ordering::Relaxed),
+            upload_failures: self.upload_failures.load(Ordering::Relaxed),
+            upload_retries: self.upload_retries.load(Ordering::Relaxed),
+            event_queue_depth: event_queue_depth as u64,
+        }
+    }
+}
+
+/// Everything the registry knows, frozen at one instant. Serializes to
+/// the JSON shape returned by `replicant_get_metrics`
+#[derive(Debug, Clone, Copy, Default, Serialize)]
+pub struct MetricsSnapshot {
+    pub sync_upload_latency: TimingSnapshot,
+    pub ws_rtt: TimingSnapshot,
+    pub db_query: TimingSnapshot,
+    pub uploads_confirmed: u64,
+    pub upload_failures: u64,
+    pub upload_retries: u64,
+    pub event_queue_depth: u64,
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_timing_stats_summary() {
+        let stats = TimingStats::default();
+        stats.record(Duration::from_micros(100));
+        stats.record(Duration::from_micros(300));
+        stats.record(Duration::from_micros(200));
+
+        let snap = stats.snapshot();
+        assert_eq!(snap.count, 3);
+        assert_eq!(snap.total_us, 600);
+        assert_eq!(snap.mean_us, 200);
+        assert_eq!(snap.min_us, 100);
+        assert_eq!(snap.max_us, 300);
+        assert_eq!(snap.last_us, 200);
+    }
+
+    #[test]
+    fn test_resend_counts_as_retry() {
+        let metrics = Metrics::new();
+        let doc_id = Uuid::new_v4();
+
+        metrics.note_upload_sent(&doc_id);
+        assert_eq!(metrics.upload_retries.load(Ordering::Relaxed), 0);
+
+        // Same document again without a confirmation in between
+        metrics.note_upload_sent(&doc_id);
+        assert_eq!(metrics.upload_retries.load(Ordering::Relaxed), 1);
+
+        // After confirmation a fresh send is not a retry
+        metrics.note_upload_confirmed(&doc_id, Duration::from_millis(5));
+        metrics.note_upload_sent(&doc_id);
+        assert_eq!(metrics.upload_retries.load(Ordering::Relaxed), 1);
+        assert_eq!(metrics.uploads_confirmed.load(Ordering::Relaxed), 1);
+    }
+
+    #[test]
+    fn test_pong_without_ping_records_nothing() {
+        let metrics = Metrics::new();
+        metrics.record_pong();
+        assert_eq!(metrics.ws_rtt.snapshot().count, 0);
+
+        metrics.mark_ping_sent();
+        metrics.record_pong();
+        assert_eq!(metrics.ws_rtt.snapshot().count, 1);
+        // A second pong for the same ping is ignored
+        metrics.record_pong();
+        assert_eq!(metrics.ws_rtt.snapshot().count, 1);
+    }
+
+    #[test]
+    fn test_snapshot_serializes_to_json() {
+        let metrics = Metrics::new();
+        metrics.db_query.record(Duration::from_micros(42));
+
+        let json = serde_json::to_value(metrics.snapshot(7)).unwrap();
+        assert_eq!(json["db_query"]["count"], 1);
+        assert_eq!(json["event_queue_depth"], 7);
+    }
+}
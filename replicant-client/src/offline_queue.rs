@@ -1,6 +1,7 @@
 use crate::queries::Queries;
-use replicant_core::{protocol::ClientMessage, SyncResult};
+use replicant_core::{patches::merge_patches, protocol::ClientMessage, SyncResult};
 use sqlx::{Row, SqlitePool};
+use std::collections::HashMap;
 use uuid::Uuid;
 
 pub struct OfflineQueue {
@@ -25,11 +26,134 @@ impl OfflineQueue {
         Ok(())
     }
 
+    /// Compact the queue so reconnect replays O(documents), not O(edits)
+    ///
+    /// A long offline session stores every edit verbatim, so a few hot
+    /// documents can accumulate hundreds of `UpdateDocument` messages that
+    /// would each cost a WebSocket round trip on reconnect. This pass:
+    ///
+    /// - merges each document's queued update patches into one message
+    ///   (via `merge_patches`), keeping the oldest base content hash so the
+    ///   server's optimistic-lock check still sees the pre-offline state
+    /// - drops create+delete pairs (and any updates in between) entirely -
+    ///   the server never saw the document
+    /// - drops updates that precede a queued delete for the same document
+    ///
+    /// Message order is preserved: merged updates stay at the position of
+    /// the document's first queued update. Returns the number of queue
+    /// rows removed.
+    pub async fn compact_queue(&self) -> SyncResult<usize> {
+        struct QueueItem {
+            id: i64,
+            message: ClientMessage,
+            dirty: bool,
+            removed: bool,
+        }
+
+        let rows = sqlx::query(Queries::GET_SYNC_QUEUE_ALL)
+            .fetch_all(&self.pool)
+            .await?;
+
+        let mut items: Vec<QueueItem> = Vec::with_capacity(rows.len());
+        for row in rows {
+            let id: i64 = row.get("id");
+            let patch: Option<String> = row.get("patch");
+            let message: ClientMessage = serde_json::from_str(&patch.unwrap_or_default())?;
+            items.push(QueueItem {
+                id,
+                message,
+                dirty: false,
+                removed: false,
+            });
+        }
+
+        // Per-document position of the surviving update / create message
+        let mut update_idx: HashMap<Uuid, usize> = HashMap::new();
+        let mut create_idx: HashMap<Uuid, usize> = HashMap::new();
+
+        for i in 0..items.len() {
+            match &items[i].message {
+                ClientMessage::CreateDocument { document } => {
+                    create_idx.insert(document.id, i);
+                }
+                ClientMessage::UpdateDocument { patch } => {
+                    let document_id = patch.document_id;
+                    let new_patch = patch.patch.clone();
+
+                    if let Some(&first) = update_idx.get(&document_id) {
+                        // Fold this update into the document's first one
+                        if let ClientMessage::UpdateDocument { patch: merged } =
+                            &mut items[first].message
+                        {
+                            merged.patch = merge_patches(&merged.patch, &new_patch);
+                        }
+                        items[first].dirty = true;
+                        items[i].removed = true;
+                    } else {
+                        update_idx.insert(document_id, i);
+                    }
+                }
+                ClientMessage::DeleteDocument { document_id } => {
+                    let document_id = *document_id;
+
+                    // Updates before a delete are moot either way
+                    if let Some(first) = update_idx.remove(&document_id) {
+                        items[first].removed = true;
+                        items[first].dirty = false;
+                    }
+
+                    // Created and deleted while offline: server never saw it
+                    if let Some(created) = create_idx.remove(&document_id) {
+                        items[created].removed = true;
+                        items[i].removed = true;
+                    }
+                }
+                _ => {}
+            }
+        }
+
+        let removed_count = items.iter().filter(|item| item.removed).count();
+        if removed_count == 0 {
+            return Ok(0);
+        }
+
+        // Apply removals and rewrites atomically
+        let mut tx = self.pool.begin().await?;
+
+        for item in &items {
+            if item.removed {
+                sqlx::query(Queries::DELETE_FROM_QUEUE)
+                    .bind(item.id)
+                    .execute(&mut *tx)
+                    .await?;
+            } else if item.dirty {
+                sqlx::query(Queries::UPDATE_QUEUE_MESSAGE)
+                    .bind(serde_json::to_string(&item.message)?)
+                    .bind(item.id)
+                    .execute(&mut *tx)
+                    .await?;
+            }
+        }
+
+        tx.commit().await?;
+
+        tracing::info!(
+            "QUEUE: Compacted offline queue: {} of {} messages removed",
+            removed_count,
+            items.len()
+        );
+
+        Ok(removed_count)
+    }
+
     pub async fn process_queue<F, Fut>(&self, mut send_fn: F) -> SyncResult<()>
     where
         F: FnMut(ClientMessage) -> Fut,
         Fut: std::future::Future<Output = SyncResult<()>>,
     {
+        // Collapse redundant messages before replaying anything
+        self.compact_queue().await?;
+
         let rows = sqlx::query(Queries::GET_SYNC_QUEUE)
             .fetch_all(&self.pool)
             .await?;
@@ -83,3 +207,188 @@ pub fn operation_type(message: &ClientMessage) -> &'static str {
         _ => "other",
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use replicant_core::models::{Document, DocumentPatch};
+    use replicant_core::patches::{apply_patch, calculate_checksum, create_patch};
+    use serde_json::json;
+    use sqlx::sqlite::SqlitePoolOptions;
+
+    async fn setup_queue() -> OfflineQueue {
+        let pool = SqlitePoolOptions::new()
+            .max_connections(1)
+            .connect(":memory:")
+            .await
+            .unwrap();
+
+        sqlx::query(
+            r#"
+            CREATE TABLE sync_queue (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                document_id TEXT NOT NULL,
+                operation_type TEXT NOT NULL,
+                patch JSON,
+                created_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,
+                retry_count INTEGER DEFAULT 0
+            )
+            "#,
+        )
+        .execute(&pool)
+        .await
+        .unwrap();
+
+        OfflineQueue::new(pool)
+    }
+
+    fn create_message(document_id: Uuid, content: serde_json::Value) -> ClientMessage {
+        ClientMessage::CreateDocument {
+            document: Document {
+                id: document_id,
+                user_id: Uuid::new_v4(),
+                content,
+                sync_revision: 1,
+                content_hash: None,
+                title: None,
+                created_at: chrono::Utc::now(),
+                updated_at: chrono::Utc::now(),
+                deleted_at: None,
+            },
+        }
+    }
+
+    fn update_message(
+        document_id: Uuid,
+        from: &serde_json::Value,
+        to: &serde_json::Value,
+    ) -> ClientMessage {
+        ClientMessage::UpdateDocument {
+            patch: DocumentPatch {
+                document_id,
+                patch: create_patch(from, to).unwrap(),
+                content_hash: calculate_checksum(from),
+            },
+        }
+    }
+
+    async fn queued_messages(queue: &OfflineQueue) -> Vec<ClientMessage> {
+        let rows = sqlx::query(Queries::GET_SYNC_QUEUE_ALL)
+            .fetch_all(&queue.pool)
+            .await
+            .unwrap();
+
+        rows.into_iter()
+            .map(|row| {
+                let patch: Option<String> = row.get("patch");
+                serde_json::from_str(&patch.unwrap()).unwrap()
+            })
+            .collect()
+    }
+
+    #[tokio::test]
+    async fn test_compact_merges_updates_per_document() {
+        let queue = setup_queue().await;
+        let doc_a = Uuid::new_v4();
+        let doc_b = Uuid::new_v4();
+
+        let a1 = json!({"title": "a", "count": 1});
+        let a2 = json!({"title": "a", "count": 2});
+        let a3 = json!({"title": "a", "count": 3});
+        let b1 = json!({"title": "b"});
+        let b2 = json!({"title": "b2"});
+
+        queue.enqueue(update_message(doc_a, &a1, &a2)).await.unwrap();
+        queue.enqueue(update_message(doc_b, &b1, &b2)).await.unwrap();
+        queue.enqueue(update_message(doc_a, &a2, &a3)).await.unwrap();
+
+        let removed = queue.compact_queue().await.unwrap();
+        assert_eq!(removed, 1);
+
+        let messages = queued_messages(&queue).await;
+        assert_eq!(messages.len(), 2);
+
+        // doc_a's merged patch keeps its original position, replays to the
+        // final state, and keeps the oldest base content hash
+        match &messages[0] {
+            ClientMessage::UpdateDocument { patch } => {
+                assert_eq!(patch.document_id, doc_a);
+                assert_eq!(patch.content_hash, calculate_checksum(&a1));
+
+                let mut content = a1.clone();
+                apply_patch(&mut content, &patch.patch).unwrap();
+                assert_eq!(content, a3);
+            }
+            other => panic!("expected UpdateDocument, got {:?}", other),
+        }
+        match &messages[1] {
+            ClientMessage::UpdateDocument { patch } => assert_eq!(patch.document_id, doc_b),
+            other => panic!("expected UpdateDocument, got {:?}", other),
+        }
+    }
+
+    #[tokio::test]
+    async fn test_compact_drops_create_delete_pairs() {
+        let queue = setup_queue().await;
+        let ephemeral = Uuid::new_v4();
+        let surviving = Uuid::new_v4();
+
+        let v1 = json!({"title": "temp"});
+        let v2 = json!({"title": "temp2"});
+
+        queue
+            .enqueue(create_message(ephemeral, v1.clone()))
+            .await
+            .unwrap();
+        queue
+            .enqueue(create_message(surviving, json!({"title": "keep"})))
+            .await
+            .unwrap();
+        queue.enqueue(update_message(ephemeral, &v1, &v2)).await.unwrap();
+        queue
+            .enqueue(ClientMessage::DeleteDocument {
+                document_id: ephemeral,
+            })
+            .await
+            .unwrap();
+
+        // Create, update and delete of the ephemeral document all vanish
+        let removed = queue.compact_queue().await.unwrap();
+        assert_eq!(removed, 3);
+
+        let messages = queued_messages(&queue).await;
+        assert_eq!(messages.len(), 1);
+        match &messages[0] {
+            ClientMessage::CreateDocument { document } => assert_eq!(document.id, surviving),
+            other => panic!("expected CreateDocument, got {:?}", other),
+        }
+    }
+
+    #[tokio::test]
+    async fn test_compact_drops_updates_before_delete() {
+        let queue = setup_queue().await;
+        let doc = Uuid::new_v4();
+
+        let v1 = json!({"n": 1});
+        let v2 = json!({"n": 2});
+
+        queue.enqueue(update_message(doc, &v1, &v2)).await.unwrap();
+        queue
+            .enqueue(ClientMessage::DeleteDocument { document_id: doc })
+            .await
+            .unwrap();
+
+        let removed = queue.compact_queue().await.unwrap();
+        assert_eq!(removed, 1);
+
+        let messages = queued_messages(&queue).await;
+        assert_eq!(messages.len(), 1);
+        assert!(matches!(
+            messages[0],
+            ClientMessage::DeleteDocument { document_id } if document_id == doc
+        ));
+
+        // Nothing left to compact on a second pass
+        assert_eq!(queue.compact_queue().await.unwrap(), 0);
+    }
+}
@@ -17,6 +17,7 @@ pub type DocumentParams = (
     Option<String>, // deleted_at
     String,         // sync_status
     String,         // title
+    Option<String>, // content_hash
 );
 
 /// SQL queries for client database operations
@@ -78,7 +79,7 @@ impl Queries {
     // Document queries
     pub const GET_DOCUMENT: &'static str = r#"
         SELECT id, user_id, content, sync_revision,
-               created_at, updated_at, deleted_at, title
+               created_at, updated_at, deleted_at, title, content_hash
         FROM documents
         WHERE id = ?1
     "#;
@@ -86,15 +87,36 @@ impl Queries {
     pub const UPSERT_DOCUMENT: &'static str = r#"
         INSERT INTO documents (
             id, user_id, content, sync_revision,
-            created_at, updated_at, deleted_at, sync_status, title
-        ) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9)
+            created_at, updated_at, deleted_at, sync_status, title, content_hash
+        ) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10)
         ON CONFLICT(id) DO UPDATE SET
             content = excluded.content,
             sync_revision = excluded.sync_revision,
             updated_at = excluded.updated_at,
             deleted_at = excluded.deleted_at,
             sync_status = excluded.sync_status,
-            title = excluded.title
+            title = excluded.title,
+            content_hash = excluded.content_hash
+    "#;
+
+    /// Keyset-paginated page of documents, ordered by id.
+    /// Pass the last id of the previous page (or '' for the first page).
+    pub const GET_DOCUMENTS_PAGE: &'static str = r#"
+        SELECT id, user_id, content, sync_revision,
+               created_at, updated_at, deleted_at, title, content_hash
+        FROM documents
+        WHERE deleted_at IS NULL AND id > ?1
+        ORDER BY id
+        LIMIT ?2
+    "#;
+
+    /// Metadata-only projection (no content body) for list views.
+    /// Served from the title/updated_at indexes without JSON deserialization.
+    pub const GET_DOCUMENTS_METADATA: &'static str = r#"
+        SELECT id, title, sync_revision, updated_at
+        FROM documents
+        WHERE deleted_at IS NULL
+        ORDER BY updated_at DESC
     "#;
 
     pub const LIST_USER_DOCUMENTS: &'static str = r#"
@@ -135,8 +157,17 @@ impl Queries {
         LIMIT 100
     "#;
 
+    pub const GET_SYNC_QUEUE_ALL: &'static str = r#"
+        SELECT id, patch
+        FROM sync_queue
+        ORDER BY id ASC
+    "#;
+
     pub const DELETE_FROM_QUEUE: &'static str = "DELETE FROM sync_queue WHERE id = ?1";
 
+    pub const UPDATE_QUEUE_MESSAGE: &'static str =
+        "UPDATE sync_queue SET patch = ?1 WHERE id = ?2";
+
     pub const INCREMENT_RETRY_COUNT: &'static str =
         "UPDATE sync_queue SET retry_count = retry_count + 1 WHERE id = ?1";
 
@@ -184,7 +215,7 @@ impl Queries {
 
     pub const SEARCH_DOCUMENTS: &'static str = r#"
         SELECT d.id, d.user_id, d.content, d.sync_revision,
-               d.created_at, d.updated_at, d.deleted_at, d.title
+               d.created_at, d.updated_at, d.deleted_at, d.title, d.content_hash
         FROM documents d
         JOIN documents_fts fts ON d.id = fts.document_id
         WHERE d.deleted_at IS NULL
@@ -192,6 +223,44 @@ impl Queries {
         ORDER BY rank
         LIMIT ?
     "#;
+
+    /// FTS search returning only metadata columns, not content bodies
+    pub const SEARCH_DOCUMENTS_METADATA: &'static str = r#"
+        SELECT d.id, d.title, d.sync_revision, d.updated_at
+        FROM documents d
+        JOIN documents_fts fts ON d.id = fts.document_id
+        WHERE d.deleted_at IS NULL
+          AND documents_fts MATCH ?
+        ORDER BY rank
+        LIMIT ?
+    "#;
+
+    /// One page of full-document FTS results, bm25-ordered
+    pub const SEARCH_DOCUMENTS_PAGE: &'static str = r#"
+        SELECT d.id, d.user_id, d.content, d.sync_revision,
+               d.created_at, d.updated_at, d.deleted_at, d.title, d.content_hash
+        FROM documents d
+        JOIN documents_fts fts ON d.id = fts.document_id
+        WHERE d.deleted_at IS NULL
+          AND documents_fts MATCH ?
+        ORDER BY rank
+        LIMIT ? OFFSET ?
+    "#;
+
+    /// One page of ranked search hits projected to id/title/rank/snippet.
+    /// Column 2 of documents_fts is the indexed body; snippet() trims it
+    /// to 12 tokens around the best match.
+    pub const SEARCH_DOCUMENTS_SNIPPETS: &'static str = r#"
+        SELECT d.id, d.title,
+               bm25(documents_fts) AS rank,
+               snippet(documents_fts, 2, '<b>', '</b>', '…', 12) AS snippet
+        FROM documents d
+        JOIN documents_fts fts ON d.id = fts.document_id
+        WHERE d.deleted_at IS NULL
+          AND documents_fts MATCH ?
+        ORDER BY rank
+        LIMIT ? OFFSET ?
+    "#;
 }
 
 /// Helper functions for common database operations
@@ -216,13 +285,15 @@ impl DbHelpers {
         let updated_at: String = row.get("updated_at");
         let deleted_at: Option<String> = row.get("deleted_at");
         let title: Option<String> = row.try_get("title").ok();
+        // Not every caller's SELECT projects the hash; missing means unknown
+        let content_hash: Option<String> = row.try_get("content_hash").unwrap_or(None);
 
         Ok(Document {
             id: Uuid::parse_str(&id)?,
             user_id: Uuid::parse_str(&user_id)?,
             content: serde_json::from_str(&content)?,
             sync_revision,
-            content_hash: None, // Not stored in client database
+            content_hash,
             title,
             created_at: DateTime::parse_from_rfc3339(&created_at)?.with_timezone(&Utc),
             updated_at: DateTime::parse_from_rfc3339(&updated_at)?.with_timezone(&Utc),
@@ -257,6 +328,7 @@ impl DbHelpers {
             doc.deleted_at.map(|dt| dt.to_rfc3339()),
             status,
             title,
+            doc.content_hash.clone(),
         ))
     }
 
@@ -0,0 +1,373 @@
+//! Memory-mapped document snapshot for instant cold start
+//!
+//! Opening the engine means opening SQLite, running migrations and
+//! materializing the library list - seconds of work on a cold disk cache
+//! with a large library. This module maintains a compact snapshot file
+//! next to the database that an app can memory-map and render its
+//! document list from within milliseconds of launch, while the full
+//! engine initializes in the background and reconciles.
+//!
+//! # File format
+//!
+//! A fixed header (magic, version, entry count) is followed by one
+//! fixed-size index entry per document (id, revision, updated-at, title
+//! and content offsets) and then a byte heap holding titles and content
+//! JSON verbatim. Everything is little-endian and offset-addressed, so a
+//! reader touches only the pages it actually looks at - the OS pages the
+//! rest in lazily.
+//!
+//! # Freshness
+//!
+//! The snapshot is advisory: the engine rewrites it in the background
+//! whenever the library fingerprint (document count + latest update)
+//! changes, via an atomic temp-file rename. A snapshot is therefore at
+//! most one write interval stale, and the app replaces the snapshot view
+//! with live data once the engine is up.
+
+use memmap2::Mmap;
+use replicant_core::{errors::SyncError, models::Document, SyncResult};
+use std::fs::File;
+use std::io::Write;
+use std::path::{Path, PathBuf};
+use uuid::Uuid;
+
+/// File magic, followed by a format version bump on incompatible changes
+const MAGIC: &[u8; 4] = b"RSNP";
+const VERSION: u32 = 1;
+
+/// Header: magic + version + count + reserved word
+const HEADER_SIZE: usize = 16;
+/// Index entry: id (16) + revision (8) + updated_at millis (8) +
+/// title off/len (8) + content off/len (8)
+const ENTRY_SIZE: usize = 48;
+
+/// Heap offset marking an absent (NULL) title
+const NO_TITLE: u32 = u32::MAX;
+
+/// Derive the snapshot path for a SQLite database URL or plain file path
+///
+/// Returns `None` for in-memory databases, which have nothing to snapshot.
+pub fn snapshot_path(database_url: &str) -> Option<PathBuf> {
+    let path = database_url
+        .strip_prefix("sqlite://")
+        .or_else(|| database_url.strip_prefix("sqlite:"))
+        .unwrap_or(database_url);
+    // In-memory databases can also be spelled as a file: URI with
+    // mode=memory in the query, so check before the query is dropped
+    if path.contains("mode=memory") {
+        return None;
+    }
+    // Drop connection-string query parameters (e.g. ?mode=rwc)
+    let path = path.split('?').next().unwrap_or(path);
+
+    if path.is_empty() || path == ":memory:" || path.contains(":memory:") {
+        return None;
+    }
+
+    Some(PathBuf::from(format!("{}.snapshot", path)))
+}
+
+/// Write a snapshot of the given documents, atomically replacing any
+/// previous snapshot at `path`
+///
+/// The file is assembled in memory (index + heap), written to a sibling
+/// temp file and renamed into place, so a reader never observes a
+/// partially written snapshot.
+pub fn write_snapshot(path: &Path, documents: &[Document]) -> SyncResult<()> {
+    let mut index = Vec::with_capacity(HEADER_SIZE + documents.len() * ENTRY_SIZE);
+    let mut heap: Vec<u8> = Vec::new();
+
+    index.extend_from_slice(MAGIC);
+    index.extend_from_slice(&VERSION.to_le_bytes());
+    index.extend_from_slice(&(documents.len() as u32).to_le_bytes());
+    index.extend_from_slice(&[0u8; 4]);
+
+    for doc in documents {
+        let (title_off, title_len) = match &doc.title {
+            Some(title) => {
+                let off = heap.len() as u32;
+                heap.extend_from_slice(title.as_bytes());
+                (off, title.len() as u32)
+            }
+            None => (NO_TITLE, 0),
+        };
+
+        let content = serde_json::to_string(&doc.content)?;
+        let content_off = heap.len() as u32;
+        heap.extend_from_slice(content.as_bytes());
+
+        index.extend_from_slice(doc.id.as_bytes());
+        index.extend_from_slice(&doc.sync_revision.to_le_bytes());
+        index.extend_from_slice(&doc.updated_at.timestamp_millis().to_le_bytes());
+        index.extend_from_slice(&title_off.to_le_bytes());
+        index.extend_from_slice(&title_len.to_le_bytes());
+        index.extend_from_slice(&content_off.to_le_bytes());
+        index.extend_from_slice(&(content.len() as u32).to_le_bytes());
+    }
+
+    let tmp_path = path.with_extension("snapshot.tmp");
+    {
+        let mut file = File::create(&tmp_path)?;
+        file.write_all(&index)?;
+        file.write_all(&heap)?;
+        file.sync_all()?;
+    }
+    std::fs::rename(&tmp_path, path)?;
+
+    Ok(())
+}
+
+/// One document as stored in a snapshot, borrowing from the mapping
+#[derive(Debug)]
+pub struct SnapshotEntry<'a> {
+    pub id: Uuid,
+    pub title: Option<&'a str>,
+    pub sync_revision: i64,
+    pub updated_at: chrono::DateTime<chrono::Utc>,
+    /// Content body exactly as it was serialized into the snapshot
+    pub content_json: &'a str,
+}
+
+/// A memory-mapped, read-only view of a snapshot file
+pub struct Snapshot {
+    mmap: Mmap,
+    count: usize,
+    heap_start: usize,
+}
+
+impl Snapshot {
+    /// Map the snapshot at `path` and validate its header
+    pub fn open(path: &Path) -> SyncResult<Self> {
+        let file = File::open(path)?;
+        // Safety: the mapping is read-only and the writer replaces the
+        // file by rename, so the bytes behind an open mapping never change
+        let mmap = unsafe { Mmap::map(&file)? };
+
+        if mmap.len() < HEADER_SIZE || &mmap[0..4] != MAGIC {
+            return Err(SyncError::InvalidOperation(
+                "Snapshot file is corrupt: bad magic".to_string(),
+            ));
+        }
+        let version = u32::from_le_bytes(mmap[4..8].try_into().unwrap());
+        if version != VERSION {
+            return Err(SyncError::InvalidOperation(format!(
+                "Snapshot version {} is not supported",
+                version
+            )));
+        }
+        let count = u32::from_le_bytes(mmap[8..12].try_into().unwrap()) as usize;
+        let heap_start = HEADER_SIZE + count * ENTRY_SIZE;
+        if mmap.len() < heap_start {
+            return Err(SyncError::InvalidOperation(
+                "Snapshot file is corrupt: truncated index".to_string(),
+            ));
+        }
+
+        Ok(Self {
+            mmap,
+            count,
+            heap_start,
+        })
+    }
+
+    pub fn len(&self) -> usize {
+        self.count
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.count == 0
+    }
+
+    /// Decode the index entry at `index`, borrowing strings from the heap
+    pub fn entry(&self, index: usize) -> SyncResult<SnapshotEntry<'_>> {
+        if index >= self.count {
+            return Err(SyncError::InvalidOperation(format!(
+                "Snapshot entry {} out of range ({} entries)",
+                index, self.count
+            )));
+        }
+        let e = &self.mmap[HEADER_SIZE + index * ENTRY_SIZE..][..ENTRY_SIZE];
+
+        let id = Uuid::from_slice(&e[0..16])?;
+        let sync_revision = i64::from_le_bytes(e[16..24].try_into().unwrap());
+        let updated_millis = i64::from_le_bytes(e[24..32].try_into().unwrap());
+        let title_off = u32::from_le_bytes(e[32..36].try_into().unwrap());
+        let title_len = u32::from_le_bytes(e[36..40].try_into().unwrap());
+        let content_off = u32::from_le_bytes(e[40..44].try_into().unwrap());
+        let content_len = u32::from_le_bytes(e[44..48].try_into().unwrap());
+
+        let title = if title_off == NO_TITLE {
+            None
+        } else {
+            Some(self.heap_str(title_off, title_len)?)
+        };
+
+        Ok(SnapshotEntry {
+            id,
+            title,
+            sync_revision,
+            updated_at: chrono::DateTime::from_timestamp_millis(updated_millis).ok_or_else(
+                || SyncError::InvalidOperation("Snapshot timestamp out of range".to_string()),
+            )?,
+            content_json: self.heap_str(content_off, content_len)?,
+        })
+    }
+
+    /// Render every entry as a JSON array of
+    /// `{"id", "title", "sync_revision", "updated_at", "content"}`
+    ///
+    /// Content bodies are spliced in verbatim from the heap - nothing is
+    /// parsed or re-serialized, so this stays fast on large libraries.
+    pub fn documents_json(&self) -> SyncResult<String> {
+        let mut json = String::with_capacity(self.mmap.len() + 64 * self.count + 2);
+        json.push('[');
+        for i in 0..self.count {
+            let entry = self.entry(i)?;
+            if i > 0 {
+                json.push(',');
+            }
+            json.push_str("{\"id\":\"");
+            json.push_str(&entry.id.to_string());
+            json.push_str("\",\"title\":");
+            match entry.title {
+                Some(title) => json.push_str(&serde_json::to_string(title)?),
+                None => json.push_str("null"),
+            }
+            json.push_str(",\"sync_revision\":");
+            json.push_str(&entry.sync_revision.to_string());
+            json.push_str(",\"updated_at\":\"");
+            json.push_str(&entry.updated_at.to_rfc3339());
+            json.push_str("\",\"content\":");
+            json.push_str(entry.content_json);
+            json.push('}');
+        }
+        json.push(']');
+        Ok(json)
+    }
+
+    fn heap_str(&self, off: u32, len: u32) -> SyncResult<&str> {
+        let start = self.heap_start + off as usize;
+        let end = start + len as usize;
+        let bytes = self.mmap.get(start..end).ok_or_else(|| {
+            SyncError::InvalidOperation("Snapshot file is corrupt: heap offset".to_string())
+        })?;
+        std::str::from_utf8(bytes).map_err(|_| {
+            SyncError::InvalidOperation("Snapshot file is corrupt: invalid UTF-8".to_string())
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use chrono::Utc;
+
+    fn make_document(title: Option<&str>, text: &str) -> Document {
+        Document {
+            id: Uuid::new_v4(),
+            user_id: Uuid::new_v4(),
+            content: serde_json::json!({ "text": text }),
+            sync_revision: 3,
+            content_hash: None,
+            title: title.map(|t| t.to_string()),
+            created_at: Utc::now(),
+            updated_at: Utc::now(),
+            deleted_at: None,
+        }
+    }
+
+    fn temp_snapshot_path(name: &str) -> PathBuf {
+        std::env::temp_dir().join(format!("replicant_{}_{}.snapshot", name, Uuid::new_v4()))
+    }
+
+    #[test]
+    fn test_snapshot_round_trip() {
+        let docs = vec![
+            make_document(Some("First"), "hello"),
+            make_document(None, "untitled"),
+        ];
+        let path = temp_snapshot_path("round_trip");
+        write_snapshot(&path, &docs).unwrap();
+
+        let snapshot = Snapshot::open(&path).unwrap();
+        assert_eq!(snapshot.len(), 2);
+
+        let first = snapshot.entry(0).unwrap();
+        assert_eq!(first.id, docs[0].id);
+        assert_eq!(first.title, Some("First"));
+        assert_eq!(first.sync_revision, 3);
+        assert_eq!(
+            serde_json::from_str::<serde_json::Value>(first.content_json).unwrap(),
+            docs[0].content
+        );
+
+        let second = snapshot.entry(1).unwrap();
+        assert_eq!(second.title, None);
+
+        std::fs::remove_file(&path).unwrap();
+    }
+
+    #[test]
+    fn test_documents_json_is_valid_and_complete() {
+        let docs = vec![
+            make_document(Some("A \"quoted\" title"), "a"),
+            make_document(None, "b"),
+        ];
+        let path = temp_snapshot_path("json");
+        write_snapshot(&path, &docs).unwrap();
+
+        let snapshot = Snapshot::open(&path).unwrap();
+        let json = snapshot.documents_json().unwrap();
+        let parsed: Vec<serde_json::Value> = serde_json::from_str(&json).unwrap();
+
+        assert_eq!(parsed.len(), 2);
+        assert_eq!(parsed[0]["id"], docs[0].id.to_string());
+        assert_eq!(parsed[0]["title"], "A \"quoted\" title");
+        assert_eq!(parsed[1]["title"], serde_json::Value::Null);
+        assert_eq!(parsed[1]["content"], docs[1].content);
+
+        std::fs::remove_file(&path).unwrap();
+    }
+
+    #[test]
+    fn test_write_replaces_previous_snapshot() {
+        let path = temp_snapshot_path("replace");
+        write_snapshot(&path, &[make_document(Some("old"), "x")]).unwrap();
+        write_snapshot(&path, &[]).unwrap();
+
+        let snapshot = Snapshot::open(&path).unwrap();
+        assert!(snapshot.is_empty());
+
+        std::fs::remove_file(&path).unwrap();
+    }
+
+    #[test]
+    fn test_open_rejects_corrupt_file() {
+        let path = temp_snapshot_path("corrupt");
+        std::fs::write(&path, b"not a snapshot").unwrap();
+        assert!(Snapshot::open(&path).is_err());
+        std::fs::remove_file(&path).unwrap();
+    }
+
+    #[test]
+    fn test_snapshot_path_derivation() {
+        assert_eq!(
+            snapshot_path("sqlite:data/app.db"),
+            Some(PathBuf::from("data/app.db.snapshot"))
+        );
+        assert_eq!(
+            snapshot_path("sqlite://data/app.db?mode=rwc"),
+            Some(PathBuf::from("data/app.db.snapshot"))
+        );
+        assert_eq!(
+            snapshot_path("/var/lib/app.db"),
+            Some(PathBuf::from("/var/lib/app.db.snapshot"))
+        );
+        assert_eq!(snapshot_path("sqlite::memory:"), None);
+        assert_eq!(snapshot_path(":memory:"), None);
+        assert_eq!(
+            snapshot_path("sqlite:file:test-db?mode=memory&cache=shared"),
+            None
+        );
+    }
+}
@@ -0,0 +1,121 @@
+//! Upload scheduling for pending documents
+//!
+//! Orders a batch of pending uploads so the documents the user touched
+//! most recently go first, and interleaves small documents between large
+//! ones so a single big payload at the head of the queue can't delay
+//! everything behind it. Ordering is only preserved per document id:
+//! independent documents are free to travel in any order, and the client
+//! keeps a bounded window of them in flight at once.
+
+use crate::database::PendingDocumentInfo;
+use replicant_core::models::Document;
+
+/// How many independent documents may be awaiting server confirmation
+/// at once before the uploader waits for acknowledgements
+pub const MAX_INFLIGHT_UPLOADS: usize = 8;
+
+/// Documents at or above this serialized size count as "large" and are
+/// interleaved rather than allowed to monopolize the send queue
+const SMALL_DOC_BYTES: usize = 16 * 1024;
+
+/// How many small documents are dispatched for every large one
+const SMALL_PER_LARGE: usize = 4;
+
+/// One pending upload with everything the scheduler ranks on
+pub struct UploadJob {
+    pub info: PendingDocumentInfo,
+    pub document: Document,
+    pub size_bytes: usize,
+}
+
+/// Order a batch of pending uploads for dispatch
+///
+/// Jobs are first ranked by `updated_at` (most recently touched first,
+/// so the document the user is looking at syncs ahead of backlog), then
+/// small and large documents are interleaved `SMALL_PER_LARGE`-to-one,
+/// each group keeping its recency order.
+pub fn schedule(mut jobs: Vec<UploadJob>) -> Vec<UploadJob> {
+    jobs.sort_by(|a, b| b.document.updated_at.cmp(&a.document.updated_at));
+
+    let (small, large): (Vec<_>, Vec<_>) = jobs
+        .into_iter()
+        .partition(|job| job.size_bytes < SMALL_DOC_BYTES);
+
+    let mut ordered = Vec::with_capacity(small.len() + large.len());
+    let mut small = small.into_iter();
+    let mut large = large.into_iter();
+    loop {
+        let mut emitted = false;
+        for _ in 0..SMALL_PER_LARGE {
+            if let Some(job) = small.next() {
+                ordered.push(job);
+                emitted = true;
+            }
+        }
+        if let Some(job) = large.next() {
+            ordered.push(job);
+            emitted = true;
+        }
+        if !emitted {
+            break;
+        }
+    }
+    ordered
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use serde_json::json;
+    use uuid::Uuid;
+
+    fn job(size_bytes: usize, updated_secs_ago: i64) -> UploadJob {
+        let id = Uuid::new_v4();
+        let updated_at = chrono::Utc::now() - chrono::Duration::seconds(updated_secs_ago);
+        UploadJob {
+            info: PendingDocumentInfo {
+                id,
+                is_deleted: false,
+            },
+            document: Document {
+                id,
+                user_id: Uuid::new_v4(),
+                content: json!({}),
+                sync_revision: 1,
+                content_hash: None,
+                title: None,
+                created_at: updated_at,
+                updated_at,
+                deleted_at: None,
+            },
+            size_bytes,
+        }
+    }
+
+    #[test]
+    fn test_recently_touched_documents_go_first() {
+        let old = job(100, 3600);
+        let fresh = job(100, 1);
+        let fresh_id = fresh.info.id;
+
+        let ordered = schedule(vec![old, fresh]);
+        assert_eq!(ordered[0].info.id, fresh_id);
+    }
+
+    #[test]
+    fn test_small_documents_interleave_with_large() {
+        // One large document touched most recently, plus a backlog of
+        // small ones: the large doc must not push every small doc back
+        let mut jobs = vec![job(1024 * 1024, 1)];
+        for i in 0..8 {
+            jobs.push(job(100, 10 + i));
+        }
+
+        let ordered = schedule(jobs);
+        let large_position = ordered
+            .iter()
+            .position(|j| j.size_bytes >= SMALL_DOC_BYTES)
+            .unwrap();
+        assert_eq!(large_position, SMALL_PER_LARGE);
+    }
+}
@@ -3,8 +3,12 @@ use backon::{ExponentialBuilder, Retryable};
 use futures_util::{SinkExt, StreamExt};
 use hmac::{Hmac, Mac};
 use replicant_core::{
+    checksums::ChecksumAlgorithm,
     errors::ClientError,
-    protocol::{ClientMessage, ServerMessage},
+    protocol::{
+        decode_binary_message, encode_message, ClientMessage, ServerMessage, WireEncoding,
+        WireFrame,
+    },
     SyncResult,
 };
 use sha2::Sha256;
@@ -56,6 +60,71 @@ impl WebSocketClient {
         api_secret: &str,
         event_dispatcher: Option<Arc<EventDispatcher>>,
         is_connected: Arc<AtomicBool>,
+    ) -> SyncResult<(Self, WebSocketReceiver)> {
+        let (client, receiver) =
+            Self::establish(server_url, event_dispatcher, is_connected).await?;
+
+        // Create timestamp
+        let timestamp = chrono::Utc::now().timestamp();
+
+        // Create HMAC signature
+        let signature = Self::create_hmac_signature(
+            api_secret, timestamp, email, api_key, "", // Empty body for auth
+        );
+
+        // Send authentication with HMAC signature
+        client
+            .send(ClientMessage::Authenticate {
+                email: email.to_string(),
+                client_id,
+                api_key: Some(api_key.to_string()),
+                signature: Some(signature),
+                timestamp: Some(timestamp),
+                encodings: Some(vec![WireEncoding::MessagePack]),
+                checksums: Some(vec![ChecksumAlgorithm::Xxh3]),
+            })
+            .await?;
+
+        Ok((client, receiver))
+    }
+
+    /// Reconnect by presenting a session token from a previous `AuthSuccess`
+    ///
+    /// Skips the HMAC handshake entirely: the server validates the token and
+    /// immediately replays the change stream after `last_sequence`, so sync
+    /// resumes in a single round trip. An expired or unknown token comes back
+    /// as `AuthError`, at which point the caller falls back to
+    /// `connect_with_hmac`.
+    pub async fn resume(
+        server_url: &str,
+        client_id: Uuid,
+        session_id: Uuid,
+        last_sequence: u64,
+        event_dispatcher: Option<Arc<EventDispatcher>>,
+        is_connected: Arc<AtomicBool>,
+    ) -> SyncResult<(Self, WebSocketReceiver)> {
+        let (client, receiver) =
+            Self::establish(server_url, event_dispatcher, is_connected).await?;
+
+        client
+            .send(ClientMessage::ResumeSession {
+                session_id,
+                client_id,
+                last_sequence,
+                encodings: Some(vec![WireEncoding::MessagePack]),
+                checksums: Some(vec![ChecksumAlgorithm::Xxh3]),
+            })
+            .await?;
+
+        Ok((client, receiver))
+    }
+
+    /// Open the socket and spawn the writer/reader tasks shared by both the
+    /// full handshake and session resume
+    async fn establish(
+        server_url: &str,
+        event_dispatcher: Option<Arc<EventDispatcher>>,
+        is_connected: Arc<AtomicBool>,
     ) -> SyncResult<(Self, WebSocketReceiver)> {
         let ws_stream = Self::connect_with_retry(server_url, 3, event_dispatcher).await?;
 
@@ -65,14 +134,31 @@ impl WebSocketClient {
         let (tx_send, mut rx_send) = mpsc::channel::<ClientMessage>(100);
         let (tx_recv, rx_recv) = mpsc::channel::<ServerMessage>(100);
 
+        // Set once the server confirms MessagePack in AuthSuccess; the writer
+        // stays on JSON until then, so pre-negotiation servers keep working
+        let use_msgpack = Arc::new(AtomicBool::new(false));
+
         // Spawn writer task
         is_connected.store(true, std::sync::atomic::Ordering::Relaxed);
         let is_connected_d = is_connected.clone();
+        let use_msgpack_w = use_msgpack.clone();
         tokio::spawn(async move {
             let mut write = write;
             while let Some(msg) = rx_send.recv().await {
-                let json = serde_json::to_string(&msg).unwrap();
-                if write.send(Message::Text(json)).await.is_err() {
+                let encoding = if use_msgpack_w.load(std::sync::atomic::Ordering::Relaxed) {
+                    WireEncoding::MessagePack
+                } else {
+                    WireEncoding::Json
+                };
+                let frame = match encode_message(&msg, encoding) {
+                    Ok(WireFrame::Text(json)) => Message::Text(json),
+                    Ok(WireFrame::Binary(bytes)) => Message::Binary(bytes),
+                    Err(e) => {
+                        tracing::error!("CLIENT: Failed to encode message: {}", e);
+                        continue;
+                    }
+                };
+                if write.send(frame).await.is_err() {
                     is_connected_d.store(false, std::sync::atomic::Ordering::Relaxed);
                 }
             }
@@ -80,21 +166,34 @@ impl WebSocketClient {
 
         // Spawn reader task
         let is_connected_d = is_connected.clone();
+        let use_msgpack_r = use_msgpack.clone();
         tokio::spawn(async move {
             let mut read = read;
             while let Some(msg) = read.next().await {
-                match msg {
-                    Ok(Message::Text(text)) => {
-                        if let Ok(server_msg) = serde_json::from_str::<ServerMessage>(&text) {
-                            if tx_recv.send(server_msg).await.is_err() {
-                                break;
-                            }
-                        }
-                    }
+                let server_msg = match msg {
+                    // Frames are self-describing: text is JSON, binary is
+                    // MessagePack, regardless of negotiation state
+                    Ok(Message::Text(text)) => serde_json::from_str::<ServerMessage>(&text).ok(),
+                    Ok(Message::Binary(bytes)) => decode_binary_message::<ServerMessage>(&bytes).ok(),
                     Ok(Message::Close(_)) => {
                         is_connected_d.store(false, std::sync::atomic::Ordering::Relaxed);
+                        None
+                    }
+                    _ => None,
+                };
+
+                if let Some(server_msg) = server_msg {
+                    if let ServerMessage::AuthSuccess {
+                        encoding: Some(WireEncoding::MessagePack),
+                        ..
+                    } = &server_msg
+                    {
+                        use_msgpack_r.store(true, std::sync::atomic::Ordering::Relaxed);
+                        tracing::info!("CLIENT: Negotiated MessagePack wire encoding");
+                    }
+                    if tx_recv.send(server_msg).await.is_err() {
+                        break;
                     }
-                    _ => {}
                 }
             }
         });
@@ -105,25 +204,6 @@ impl WebSocketClient {
 
         let receiver = WebSocketReceiver { rx: rx_recv };
 
-        // Create timestamp
-        let timestamp = chrono::Utc::now().timestamp();
-
-        // Create HMAC signature
-        let signature = Self::create_hmac_signature(
-            api_secret, timestamp, email, api_key, "", // Empty body for auth
-        );
-
-        // Send authentication with HMAC signature
-        client
-            .send(ClientMessage::Authenticate {
-                email: email.to_string(),
-                client_id,
-                api_key: Some(api_key.to_string()),
-                signature: Some(signature),
-                timestamp: Some(timestamp),
-            })
-            .await?;
-
         Ok((client, receiver))
     }
 
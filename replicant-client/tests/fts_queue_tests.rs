@@ -0,0 +1,105 @@
+//! # Deferred FTS Maintenance Tests
+//!
+//! Tests for the debounced FTS index queue. Saves no longer rewrite
+//! their FTS5 row inline; they mark the document dirty and searches
+//! flush the queue first. These tests pin the consistency contract:
+//! a search issued immediately after a save must see that save.
+
+mod common;
+
+use common::{make_document, setup_test_db};
+use uuid::Uuid;
+
+/// A search immediately after a save sees the new document even though
+/// the index write was deferred (flush-before-query barrier).
+#[tokio::test]
+async fn test_search_flushes_queued_updates() {
+    let db = setup_test_db().await;
+    db.ensure_user_config("ws://localhost:8080/ws")
+        .await
+        .unwrap();
+    let user_id = db.get_user_id().await.unwrap();
+    db.configure_search(&["$.text".to_string()]).await.unwrap();
+
+    let doc = make_document(user_id, "Fresh", "barely saved quokka", 1);
+    db.save_document(&doc).await.unwrap();
+
+    // No sleep: the search itself must flush the queue
+    let hits = db.search_documents("quokka", 10).await.unwrap();
+    assert_eq!(hits.len(), 1);
+    assert_eq!(hits[0].id, doc.id);
+}
+
+/// Repeated saves of one document fold into a single index row holding
+/// the latest content.
+#[tokio::test]
+async fn test_repeated_saves_index_latest_content() {
+    let db = setup_test_db().await;
+    db.ensure_user_config("ws://localhost:8080/ws")
+        .await
+        .unwrap();
+    let user_id = db.get_user_id().await.unwrap();
+    db.configure_search(&["$.text".to_string()]).await.unwrap();
+
+    let mut doc = make_document(user_id, "Draft", "first wording", 1);
+    db.save_document(&doc).await.unwrap();
+
+    doc.content = serde_json::json!({"title": "Draft", "text": "second wording"});
+    db.save_document(&doc).await.unwrap();
+
+    doc.content = serde_json::json!({"title": "Draft", "text": "final wording narwhal"});
+    db.save_document(&doc).await.unwrap();
+
+    let hits = db.search_documents("narwhal", 10).await.unwrap();
+    assert_eq!(hits.len(), 1);
+
+    let stale = db.search_documents("first", 10).await.unwrap();
+    assert!(stale.is_empty(), "Old revisions must leave the index");
+}
+
+/// Deleting a document removes it from the index once the queue flushes.
+#[tokio::test]
+async fn test_delete_removes_document_from_index() {
+    let db = setup_test_db().await;
+    db.ensure_user_config("ws://localhost:8080/ws")
+        .await
+        .unwrap();
+    let user_id = db.get_user_id().await.unwrap();
+    db.configure_search(&["$.text".to_string()]).await.unwrap();
+
+    let doc = make_document(user_id, "Doomed", "soon gone capybara", 1);
+    db.save_document(&doc).await.unwrap();
+    assert_eq!(db.search_documents("capybara", 10).await.unwrap().len(), 1);
+
+    db.delete_document(&doc.id).await.unwrap();
+
+    let hits = db.search_documents("capybara", 10).await.unwrap();
+    assert!(hits.is_empty(), "Deleted documents must not match searches");
+}
+
+/// A failed flush must not lose dirty ids: an explicit flush barrier
+/// after more saves still lands every queued update.
+#[tokio::test]
+async fn test_explicit_flush_applies_all_queued_ids() {
+    let db = setup_test_db().await;
+    db.ensure_user_config("ws://localhost:8080/ws")
+        .await
+        .unwrap();
+    let user_id = db.get_user_id().await.unwrap();
+    db.configure_search(&["$.text".to_string()]).await.unwrap();
+
+    let mut ids = Vec::new();
+    for i in 0..10 {
+        let doc = make_document(user_id, "Bulk", &format!("pangolin {}", i), 1);
+        ids.push(doc.id);
+        db.save_document(&doc).await.unwrap();
+    }
+
+    db.flush_fts_queue().await.unwrap();
+
+    let hits = db.search_documents("pangolin", 100).await.unwrap();
+    let hit_ids: Vec<Uuid> = hits.iter().map(|d| d.id).collect();
+    for id in ids {
+        assert!(hit_ids.contains(&id), "Every queued save must be indexed");
+    }
+}
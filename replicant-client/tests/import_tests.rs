@@ -0,0 +1,115 @@
+//! # Bulk Import Tests
+//!
+//! Tests for the streaming NDJSON import path (`import_documents`).
+//! The import exists for migrations that move six-figure document
+//! counts, so the interesting properties are batching semantics:
+//! preserved ids, pending-vs-presynced status, skipped bad lines, and
+//! the single deferred FTS rebuild.
+
+mod common;
+
+use common::setup_test_db;
+use uuid::Uuid;
+
+/// Imported rows land as pending by default so the next sync pass
+/// uploads them as creates.
+#[tokio::test]
+async fn test_import_rows_are_pending_by_default() {
+    let db = setup_test_db().await;
+    db.ensure_user_config("ws://localhost:8080/ws")
+        .await
+        .unwrap();
+
+    let ndjson = br#"{"title":"First","text":"alpha"}
+{"title":"Second","text":"beta"}
+{"title":"Third","text":"gamma"}
+"#;
+
+    let report = db.import_documents(&ndjson[..], false).await.unwrap();
+    assert_eq!(report.imported, 3);
+    assert_eq!(report.failed, 0);
+
+    let pending = db.get_pending_documents().await.unwrap();
+    assert_eq!(pending.len(), 3, "Imported rows should queue for upload");
+}
+
+/// Server-seeded imports pass mark_synced and must not upload.
+#[tokio::test]
+async fn test_import_mark_synced_skips_upload() {
+    let db = setup_test_db().await;
+    db.ensure_user_config("ws://localhost:8080/ws")
+        .await
+        .unwrap();
+
+    let ndjson = br#"{"title":"Seeded","text":"from server"}
+"#;
+
+    let report = db.import_documents(&ndjson[..], true).await.unwrap();
+    assert_eq!(report.imported, 1);
+
+    let pending = db.get_pending_documents().await.unwrap();
+    assert!(
+        pending.is_empty(),
+        "Pre-synced imports must not be queued for upload"
+    );
+}
+
+/// Wrapped lines (`{"id": ..., "content": ...}`) preserve the exported id.
+#[tokio::test]
+async fn test_import_preserves_wrapped_ids() {
+    let db = setup_test_db().await;
+    db.ensure_user_config("ws://localhost:8080/ws")
+        .await
+        .unwrap();
+
+    let doc_id = Uuid::new_v4();
+    let ndjson = format!(
+        "{{\"id\":\"{}\",\"content\":{{\"title\":\"Kept\",\"text\":\"id survives\"}}}}\n",
+        doc_id
+    );
+
+    let report = db.import_documents(ndjson.as_bytes(), false).await.unwrap();
+    assert_eq!(report.imported, 1);
+
+    let doc = db.get_document(&doc_id).await.unwrap();
+    assert_eq!(doc.content["title"], "Kept");
+}
+
+/// A corrupt line is counted and skipped; the rest of the import
+/// still lands.
+#[tokio::test]
+async fn test_import_skips_unparseable_lines() {
+    let db = setup_test_db().await;
+    db.ensure_user_config("ws://localhost:8080/ws")
+        .await
+        .unwrap();
+
+    let ndjson = br#"{"title":"Good","text":"one"}
+this is not json
+{"title":"Also good","text":"two"}
+"#;
+
+    let report = db.import_documents(&ndjson[..], false).await.unwrap();
+    assert_eq!(report.imported, 2);
+    assert_eq!(report.failed, 1);
+}
+
+/// The deferred FTS rebuild leaves imported documents searchable.
+#[tokio::test]
+async fn test_import_rebuilds_fts_once() {
+    let db = setup_test_db().await;
+    db.ensure_user_config("ws://localhost:8080/ws")
+        .await
+        .unwrap();
+    db.configure_search(&["$.text".to_string()]).await.unwrap();
+
+    let ndjson = br#"{"title":"Searchable","text":"xylophone concerto"}
+{"title":"Other","text":"unrelated"}
+"#;
+
+    db.import_documents(&ndjson[..], false).await.unwrap();
+
+    let hits = db.search_documents("xylophone", 10).await.unwrap();
+    assert_eq!(hits.len(), 1);
+    assert_eq!(hits[0].content["title"], "Searchable");
+}
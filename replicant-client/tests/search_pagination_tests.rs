@@ -0,0 +1,91 @@
+//! # Search Pagination and Snippet Tests
+//!
+//! Tests for the paged search API: bm25-ordered pages with offset, and
+//! the id/title/rank/snippet projection used by search-as-you-type.
+
+mod common;
+
+use common::{make_document, setup_test_db};
+use replicant_client::ClientDatabase;
+use uuid::Uuid;
+
+async fn setup_searchable_db() -> (ClientDatabase, Uuid) {
+    let db = setup_test_db().await;
+    db.ensure_user_config("ws://localhost:8080/ws")
+        .await
+        .unwrap();
+    let user_id = db.get_user_id().await.unwrap();
+    db.configure_search(&["$.text".to_string()]).await.unwrap();
+    (db, user_id)
+}
+
+/// Consecutive pages partition the ranked result set without overlap.
+#[tokio::test]
+async fn test_offset_pages_partition_results() {
+    let (db, user_id) = setup_searchable_db().await;
+
+    for i in 0..5 {
+        let doc = make_document(user_id, "Note", &format!("wombat entry {}", i), 1);
+        db.save_document(&doc).await.unwrap();
+    }
+
+    let page1 = db.search_documents_page("wombat", 2, 0).await.unwrap();
+    let page2 = db.search_documents_page("wombat", 2, 2).await.unwrap();
+    let page3 = db.search_documents_page("wombat", 2, 4).await.unwrap();
+
+    assert_eq!(page1.len(), 2);
+    assert_eq!(page2.len(), 2);
+    assert_eq!(page3.len(), 1);
+
+    let mut seen: Vec<Uuid> = Vec::new();
+    for doc in page1.iter().chain(&page2).chain(&page3) {
+        assert!(!seen.contains(&doc.id), "Pages must not overlap");
+        seen.push(doc.id);
+    }
+}
+
+/// Snippet hits carry id/title/rank/snippet with the match highlighted,
+/// and never the content body.
+#[tokio::test]
+async fn test_snippet_projection_highlights_matches() {
+    let (db, user_id) = setup_searchable_db().await;
+
+    let doc = make_document(
+        user_id,
+        "Field Notes",
+        "today we observed a rare axolotl near the riverbank",
+        1,
+    );
+    db.save_document(&doc).await.unwrap();
+
+    let hits = db
+        .search_documents_snippets("axolotl", 10, 0)
+        .await
+        .unwrap();
+    assert_eq!(hits.len(), 1);
+    assert_eq!(hits[0].id, doc.id);
+    assert!(
+        hits[0].snippet.contains("<b>axolotl</b>"),
+        "snippet() must wrap the match: {}",
+        hits[0].snippet
+    );
+
+    // Lower bm25 means more relevant; a real match is always negative
+    assert!(hits[0].rank < 0.0);
+}
+
+/// bm25 ordering puts the document with more matches first.
+#[tokio::test]
+async fn test_bm25_orders_by_relevance() {
+    let (db, user_id) = setup_searchable_db().await;
+
+    let weak = make_document(user_id, "Weak", "one mention of ocelot here", 1);
+    let strong = make_document(user_id, "Strong", "ocelot ocelot ocelot everywhere", 1);
+    db.save_document(&weak).await.unwrap();
+    db.save_document(&strong).await.unwrap();
+
+    let hits = db.search_documents_snippets("ocelot", 10, 0).await.unwrap();
+    assert_eq!(hits.len(), 2);
+    assert_eq!(hits[0].id, strong.id, "Most relevant hit must rank first");
+    assert!(hits[0].rank <= hits[1].rank);
+}
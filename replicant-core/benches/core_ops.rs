@@ -0,0 +1,177 @@
+//! Criterion benchmarks for the hot core operations
+//!
+//! Covers operational-transform pair resolution and the JSON patch
+//! pipeline (create/apply/merge), which sit on the critical path of
+//! every sync round trip. Run with `cargo bench -p replicant-core`.
+
+use criterion::{criterion_group, criterion_main, BatchSize, Criterion};
+use json_patch::{AddOperation, PatchOperation, RemoveOperation, ReplaceOperation};
+use replicant_core::ot::transform_operation_pair;
+use replicant_core::patches::{
+    apply_patch, compose_patches, create_patch, merge_patches, transform_patches, TransformStrategy,
+};
+use serde_json::{json, Value};
+use std::hint::black_box;
+
+/// A mid-sized document resembling real client payloads: nested object
+/// fields plus an array the OT path math has to walk
+fn sample_document() -> Value {
+    json!({
+        "title": "Quarterly planning",
+        "owner": "user@example.com",
+        "revision_note": "draft",
+        "settings": {
+            "visibility": "team",
+            "locale": "en-US",
+            "flags": {"pinned": true, "archived": false}
+        },
+        "items": (0..50).map(|i| json!({
+            "id": i,
+            "label": format!("item-{}", i),
+            "done": i % 3 == 0,
+            "tags": ["alpha", "beta"]
+        })).collect::<Vec<_>>()
+    })
+}
+
+/// The same document after a handful of scattered edits
+fn edited_document() -> Value {
+    let mut doc = sample_document();
+    doc["title"] = json!("Quarterly planning (rev 2)");
+    doc["settings"]["visibility"] = json!("org");
+    doc["items"][7]["done"] = json!(true);
+    doc["items"][23]["label"] = json!("item-23-renamed");
+    doc["items"][41]["tags"] = json!(["alpha", "beta", "gamma"]);
+    doc
+}
+
+fn bench_transform_operation_pair(c: &mut Criterion) {
+    let add_add = (
+        PatchOperation::Add(AddOperation {
+            path: "/items/2".into(),
+            value: json!({"id": 100, "label": "local"}),
+        }),
+        PatchOperation::Add(AddOperation {
+            path: "/items/5".into(),
+            value: json!({"id": 101, "label": "remote"}),
+        }),
+    );
+    let add_remove = (
+        PatchOperation::Add(AddOperation {
+            path: "/items/10".into(),
+            value: json!({"id": 102}),
+        }),
+        PatchOperation::Remove(RemoveOperation {
+            path: "/items/3".into(),
+        }),
+    );
+    let replace_replace = (
+        PatchOperation::Replace(ReplaceOperation {
+            path: "/settings/visibility".into(),
+            value: json!("private"),
+        }),
+        PatchOperation::Replace(ReplaceOperation {
+            path: "/settings/visibility".into(),
+            value: json!("org"),
+        }),
+    );
+
+    let mut group = c.benchmark_group("ot/transform_operation_pair");
+    group.bench_function("add_add_array", |b| {
+        b.iter(|| transform_operation_pair(black_box(&add_add.0), black_box(&add_add.1)))
+    });
+    group.bench_function("add_remove_array", |b| {
+        b.iter(|| transform_operation_pair(black_box(&add_remove.0), black_box(&add_remove.1)))
+    });
+    group.bench_function("replace_replace_conflict", |b| {
+        b.iter(|| {
+            transform_operation_pair(black_box(&replace_replace.0), black_box(&replace_replace.1))
+        })
+    });
+    group.finish();
+}
+
+fn bench_patches(c: &mut Criterion) {
+    let from = sample_document();
+    let to = edited_document();
+    let patch = create_patch(&from, &to).unwrap();
+    let patch_tail = create_patch(&to, &from).unwrap();
+
+    let mut group = c.benchmark_group("patches");
+    group.bench_function("create_patch", |b| {
+        b.iter(|| create_patch(black_box(&from), black_box(&to)))
+    });
+    group.bench_function("apply_patch", |b| {
+        b.iter_batched(
+            || from.clone(),
+            |mut doc| apply_patch(&mut doc, black_box(&patch)),
+            BatchSize::SmallInput,
+        )
+    });
+    group.bench_function("merge_patches", |b| {
+        b.iter(|| merge_patches(black_box(&patch), black_box(&patch_tail)))
+    });
+    group.finish();
+}
+
+fn bench_transform_large_patches(c: &mut Criterion) {
+    use json_patch::Patch;
+
+    // A long offline queue: repeated writes over a small set of fields,
+    // the shape compose_patches is built to collapse
+    let redundant: Patch = Patch(
+        (0..500)
+            .map(|i| {
+                PatchOperation::Replace(ReplaceOperation {
+                    path: format!("/fields/f{}", i % 25),
+                    value: json!(format!("rev-{}", i)),
+                })
+            })
+            .collect(),
+    );
+
+    // Concurrent edits over distinct fields: nothing folds, so the
+    // pairwise transform runs at full width
+    let distinct: Patch = Patch(
+        (0..100)
+            .map(|i| {
+                PatchOperation::Replace(ReplaceOperation {
+                    path: format!("/fields/f{}", i),
+                    value: json!(i),
+                })
+            })
+            .collect(),
+    );
+
+    let mut group = c.benchmark_group("patches/large");
+    group.bench_function("compose_500_redundant_ops", |b| {
+        b.iter(|| compose_patches(black_box(&redundant)))
+    });
+    group.bench_function("transform_500x500_redundant", |b| {
+        b.iter(|| {
+            transform_patches(
+                black_box(&redundant),
+                black_box(&redundant),
+                TransformStrategy::Operational,
+            )
+        })
+    });
+    group.bench_function("transform_100x100_distinct", |b| {
+        b.iter(|| {
+            transform_patches(
+                black_box(&distinct),
+                black_box(&distinct),
+                TransformStrategy::Operational,
+            )
+        })
+    });
+    group.finish();
+}
+
+criterion_group!(
+    benches,
+    bench_transform_operation_pair,
+    bench_patches,
+    bench_transform_large_patches
+);
+criterion_main!(benches);
@@ -0,0 +1,307 @@
+//! Content checksums with a negotiable algorithm
+//!
+//! The legacy checksum (`patches::calculate_checksum`) serializes the whole
+//! document and SHA-256 hashes it on every update, which makes a one-byte
+//! edit to a large document cost a full serialize + hash on both ends. This
+//! module adds a fast xxHash3-based mode and an incremental variant that
+//! updates a digest from the applied patch instead of re-hashing the whole
+//! document.
+//!
+//! Like the wire encoding, the algorithm is negotiated during
+//! authentication: the client advertises what it can produce in
+//! `Authenticate`, the server picks one and echoes it in `AuthSuccess`.
+//! Checksum strings are self-describing regardless (`xxh3:` prefix vs bare
+//! SHA-256 hex), so [`verify_checksum`] accepts either and mixed peers keep
+//! working.
+//!
+//! # xxHash3 digest structure
+//!
+//! For an object document the digest is the XOR of one xxHash3-128 per
+//! top-level field, each hashing the field name and its canonical JSON
+//! serialization. XOR makes the digest order-independent and invertible:
+//! applying a patch only requires XOR-ing out the old digests of the touched
+//! fields and XOR-ing in the new ones, so [`update_checksum`] costs
+//! O(touched fields) instead of O(document). Non-object documents hash
+//! their whole serialization.
+
+use crate::ot::operation_path;
+use crate::ot::path_utils::parse_path;
+use crate::ot::types::PathSegment;
+use json_patch::{Patch, PatchOperation};
+use serde::{Deserialize, Serialize};
+use serde_json::Value;
+use strum::{Display, EnumString};
+use xxhash_rust::xxh3::Xxh3;
+
+/// Checksum algorithms a peer can produce, negotiated during authentication
+#[derive(
+    Debug, Clone, Copy, Default, PartialEq, Eq, Serialize, Deserialize, Display, EnumString,
+)]
+#[serde(rename_all = "snake_case")]
+#[strum(serialize_all = "snake_case")]
+pub enum ChecksumAlgorithm {
+    /// SHA-256 over the full serialization (legacy, always accepted)
+    #[default]
+    Sha256,
+    /// xxHash3-128 per top-level field, XOR-combined; supports incremental
+    /// updates via [`update_checksum`]
+    Xxh3,
+}
+
+/// Prefix that marks an xxHash3 checksum string; SHA-256 checksums are
+/// bare hex for backward compatibility
+const XXH3_PREFIX: &str = "xxh3:";
+
+/// Calculate a content checksum with the given algorithm
+pub fn calculate_checksum_with(value: &Value, algorithm: ChecksumAlgorithm) -> String {
+    match algorithm {
+        ChecksumAlgorithm::Sha256 => crate::patches::calculate_checksum(value),
+        ChecksumAlgorithm::Xxh3 => format!("{}{:032x}", XXH3_PREFIX, xxh3_digest(value)),
+    }
+}
+
+/// Verify a content checksum, detecting the algorithm from the string
+///
+/// Verification is independent of what was negotiated, so a peer can
+/// always check hashes produced by an older or newer counterpart.
+pub fn verify_checksum(value: &Value, expected: &str) -> bool {
+    let algorithm = if expected.starts_with(XXH3_PREFIX) {
+        ChecksumAlgorithm::Xxh3
+    } else {
+        ChecksumAlgorithm::Sha256
+    };
+    calculate_checksum_with(value, algorithm) == expected
+}
+
+/// Incrementally update an xxHash3 checksum after applying a patch
+///
+/// `previous` must be the checksum of `old_content`, and `new_content` the
+/// result of applying `patch` to it. Only the top-level fields the patch
+/// touches are re-hashed, so the cost is proportional to the patch, not the
+/// document. Returns `None` when the fast path does not apply - a SHA-256
+/// checksum, a non-object document, or a patch that rewrites the document
+/// root - in which case the caller should fall back to a full
+/// [`calculate_checksum_with`].
+pub fn update_checksum(
+    previous: &str,
+    old_content: &Value,
+    new_content: &Value,
+    patch: &Patch,
+) -> Option<String> {
+    let hex = previous.strip_prefix(XXH3_PREFIX)?;
+    let mut digest = u128::from_str_radix(hex, 16).ok()?;
+
+    let old_map = old_content.as_object()?;
+    let new_map = new_content.as_object()?;
+
+    // Collect the top-level fields the patch touches; a root-path or
+    // unparseable operation means the whole document may have changed
+    let mut touched: Vec<&str> = Vec::new();
+    for op in &patch.0 {
+        touched.push(top_level_field(operation_path(op))?);
+        if let PatchOperation::Move(m) = op {
+            touched.push(top_level_field(&m.from)?);
+        }
+        if let PatchOperation::Copy(c) = op {
+            touched.push(top_level_field(&c.from)?);
+        }
+    }
+    touched.sort_unstable();
+    touched.dedup();
+
+    for field in touched {
+        if let Some(old_value) = old_map.get(field) {
+            digest ^= xxh3_field_digest(field, old_value);
+        }
+        if let Some(new_value) = new_map.get(field) {
+            digest ^= xxh3_field_digest(field, new_value);
+        }
+    }
+
+    Some(format!("{}{:032x}", XXH3_PREFIX, digest))
+}
+
+/// The first path segment as an object key, or None for the root path or
+/// a top-level array index
+fn top_level_field(path: &str) -> Option<&str> {
+    let parsed = parse_path(path).ok()?;
+    match parsed.segments.first()? {
+        PathSegment::Object(_) => {
+            // Borrow the key from the raw path rather than the unescaped
+            // segment so the return ties to `path`; escaped keys fall back
+            // to the slow path
+            let raw = &path[1..];
+            let key = raw.split('/').next()?;
+            (!key.contains('~')).then_some(key)
+        }
+        PathSegment::Array(_) => None,
+    }
+}
+
+/// XOR-combined digest over a document's top-level fields
+fn xxh3_digest(value: &Value) -> u128 {
+    match value.as_object() {
+        Some(map) => map.iter().fold(0u128, |acc, (key, field)| {
+            acc ^ xxh3_field_digest(key, field)
+        }),
+        // Non-object documents hash their whole serialization
+        None => hash_stream(|hasher| {
+            serde_json::to_writer(hasher, value).expect("JSON serialization cannot fail")
+        }),
+    }
+}
+
+/// Digest of one field: name, separator, canonical JSON of the value
+fn xxh3_field_digest(key: &str, value: &Value) -> u128 {
+    hash_stream(|hasher| {
+        use std::io::Write;
+        hasher.write_all(key.as_bytes()).unwrap();
+        // NUL cannot appear in a JSON object key, so it delimits
+        // unambiguously
+        hasher.write_all(&[0]).unwrap();
+        serde_json::to_writer(hasher, value).expect("JSON serialization cannot fail")
+    })
+}
+
+/// Run a streaming serialization into an xxHash3 hasher
+fn hash_stream(feed: impl FnOnce(&mut Xxh3Writer)) -> u128 {
+    let mut writer = Xxh3Writer(Xxh3::new());
+    feed(&mut writer);
+    writer.0.digest128()
+}
+
+/// io::Write adapter so serde_json can stream straight into the hasher
+struct Xxh3Writer(Xxh3);
+
+impl std::io::Write for Xxh3Writer {
+    fn write(&mut self, buf: &[u8]) -> std::io::Result<usize> {
+        self.0.update(buf);
+        Ok(buf.len())
+    }
+
+    fn flush(&mut self) -> std::io::Result<()> {
+        Ok(())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::patches::{apply_patch, create_patch};
+    use serde_json::json;
+
+    #[test]
+    fn test_sha256_matches_legacy_checksum() {
+        let doc = json!({"title": "hello", "items": [1, 2, 3]});
+        assert_eq!(
+            calculate_checksum_with(&doc, ChecksumAlgorithm::Sha256),
+            crate::patches::calculate_checksum(&doc)
+        );
+    }
+
+    #[test]
+    fn test_xxh3_is_prefixed_and_stable() {
+        let doc = json!({"title": "hello"});
+        let a = calculate_checksum_with(&doc, ChecksumAlgorithm::Xxh3);
+        let b = calculate_checksum_with(&doc, ChecksumAlgorithm::Xxh3);
+        assert!(a.starts_with("xxh3:"));
+        assert_eq!(a, b);
+        assert_ne!(
+            a,
+            calculate_checksum_with(&json!({"title": "other"}), ChecksumAlgorithm::Xxh3)
+        );
+    }
+
+    #[test]
+    fn test_verify_detects_algorithm_from_prefix() {
+        let doc = json!({"title": "hello", "count": 3});
+        let sha = calculate_checksum_with(&doc, ChecksumAlgorithm::Sha256);
+        let xxh = calculate_checksum_with(&doc, ChecksumAlgorithm::Xxh3);
+        assert!(verify_checksum(&doc, &sha));
+        assert!(verify_checksum(&doc, &xxh));
+        assert!(!verify_checksum(&json!({"title": "tampered"}), &xxh));
+    }
+
+    #[test]
+    fn test_update_checksum_matches_full_recompute() {
+        let old = json!({
+            "title": "draft",
+            "body": "a long body that does not change",
+            "tags": ["a", "b"]
+        });
+        let new = json!({
+            "title": "final",
+            "body": "a long body that does not change",
+            "tags": ["a", "b"],
+            "reviewed": true
+        });
+        let patch = create_patch(&old, &new).unwrap();
+
+        let previous = calculate_checksum_with(&old, ChecksumAlgorithm::Xxh3);
+        let updated = update_checksum(&previous, &old, &new, &patch).unwrap();
+        assert_eq!(
+            updated,
+            calculate_checksum_with(&new, ChecksumAlgorithm::Xxh3)
+        );
+    }
+
+    #[test]
+    fn test_update_checksum_handles_field_removal() {
+        let old = json!({"title": "draft", "scratch": "temp"});
+        let new = json!({"title": "draft"});
+        let patch = create_patch(&old, &new).unwrap();
+
+        let previous = calculate_checksum_with(&old, ChecksumAlgorithm::Xxh3);
+        let updated = update_checksum(&previous, &old, &new, &patch).unwrap();
+        assert_eq!(
+            updated,
+            calculate_checksum_with(&new, ChecksumAlgorithm::Xxh3)
+        );
+    }
+
+    #[test]
+    fn test_update_checksum_nested_edit_rehashes_one_field() {
+        let old = json!({"settings": {"theme": "dark", "locale": "en"}, "title": "t"});
+        let mut new = old.clone();
+        let patch: Patch = serde_json::from_value(json!([
+            {"op": "replace", "path": "/settings/theme", "value": "light"}
+        ]))
+        .unwrap();
+        apply_patch(&mut new, &patch).unwrap();
+
+        let previous = calculate_checksum_with(&old, ChecksumAlgorithm::Xxh3);
+        let updated = update_checksum(&previous, &old, &new, &patch).unwrap();
+        assert_eq!(
+            updated,
+            calculate_checksum_with(&new, ChecksumAlgorithm::Xxh3)
+        );
+    }
+
+    #[test]
+    fn test_update_checksum_falls_back_when_not_applicable() {
+        let old = json!({"title": "draft"});
+        let new = json!({"title": "final"});
+        let patch = create_patch(&old, &new).unwrap();
+
+        // SHA-256 previous checksum has no incremental path
+        let sha = calculate_checksum_with(&old, ChecksumAlgorithm::Sha256);
+        assert!(update_checksum(&sha, &old, &new, &patch).is_none());
+
+        // Root replacement touches everything
+        let root_patch: Patch = serde_json::from_value(json!([
+            {"op": "replace", "path": "", "value": {"title": "final"}}
+        ]))
+        .unwrap();
+        let xxh = calculate_checksum_with(&old, ChecksumAlgorithm::Xxh3);
+        assert!(update_checksum(&xxh, &old, &new, &root_patch).is_none());
+    }
+
+    #[test]
+    fn test_checksum_algorithm_serializes_snake_case() {
+        assert_eq!(
+            serde_json::to_string(&ChecksumAlgorithm::Xxh3).unwrap(),
+            "\"xxh3\""
+        );
+        assert_eq!(ChecksumAlgorithm::default(), ChecksumAlgorithm::Sha256);
+    }
+}
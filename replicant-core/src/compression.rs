@@ -0,0 +1,81 @@
+use crate::errors::SyncError;
+use crate::SyncResult;
+
+/// zstd frame magic number, used to tell compressed payloads apart from
+/// raw ones (MessagePack maps and JSON text can never start with it)
+pub const ZSTD_MAGIC: [u8; 4] = [0x28, 0xB5, 0x2F, 0xFD];
+
+/// Payloads below this size are left uncompressed - the zstd frame
+/// overhead and CPU cost are not worth it for small messages
+pub const COMPRESSION_THRESHOLD_BYTES: usize = 1024;
+
+/// zstd's default level: a good speed/ratio balance for JSON payloads
+const COMPRESSION_LEVEL: i32 = 3;
+
+/// Whether a payload is a zstd frame (checked by its magic number)
+pub fn is_compressed(bytes: &[u8]) -> bool {
+    bytes.starts_with(&ZSTD_MAGIC)
+}
+
+/// Compress a payload with zstd
+pub fn compress(bytes: &[u8]) -> SyncResult<Vec<u8>> {
+    zstd::encode_all(bytes, COMPRESSION_LEVEL)
+        .map_err(|e| SyncError::InvalidOperation(format!("zstd compression failed: {}", e)))
+}
+
+/// Decompress a zstd payload
+pub fn decompress(bytes: &[u8]) -> SyncResult<Vec<u8>> {
+    zstd::decode_all(bytes)
+        .map_err(|e| SyncError::InvalidOperation(format!("zstd decompression failed: {}", e)))
+}
+
+/// Compress a payload only when it pays off: the input is over the size
+/// threshold and the compressed form is actually smaller. The result is
+/// self-describing via `is_compressed`.
+pub fn maybe_compress(bytes: Vec<u8>) -> SyncResult<Vec<u8>> {
+    if bytes.len() < COMPRESSION_THRESHOLD_BYTES {
+        return Ok(bytes);
+    }
+
+    let compressed = compress(&bytes)?;
+    if compressed.len() < bytes.len() {
+        Ok(compressed)
+    } else {
+        Ok(bytes)
+    }
+}
+
+/// Undo `maybe_compress`: decompress zstd frames, pass raw payloads through
+pub fn maybe_decompress(bytes: &[u8]) -> SyncResult<Vec<u8>> {
+    if is_compressed(bytes) {
+        decompress(bytes)
+    } else {
+        Ok(bytes.to_vec())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_small_payloads_pass_through() {
+        let small = b"{\"title\": \"hello\"}".to_vec();
+        let out = maybe_compress(small.clone()).unwrap();
+        assert_eq!(out, small);
+        assert!(!is_compressed(&out));
+        assert_eq!(maybe_decompress(&out).unwrap(), small);
+    }
+
+    #[test]
+    fn test_large_payloads_round_trip_compressed() {
+        // Repetitive JSON compresses well past the threshold
+        let large = format!("[{}]", vec!["{\"op\": \"noop\"}"; 500].join(", ")).into_bytes();
+        assert!(large.len() > COMPRESSION_THRESHOLD_BYTES);
+
+        let out = maybe_compress(large.clone()).unwrap();
+        assert!(is_compressed(&out));
+        assert!(out.len() < large.len());
+        assert_eq!(maybe_decompress(&out).unwrap(), large);
+    }
+}
@@ -1,3 +1,5 @@
+pub mod checksums;
+pub mod compression;
 pub mod conflicts;
 pub mod errors;
 pub mod models;
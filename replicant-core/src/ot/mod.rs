@@ -9,5 +9,5 @@ pub mod transform;
 pub mod types;
 
 pub use path_utils::*;
-pub use transform::transform_operation_pair;
+pub use transform::{operation_path, transform_operation_pair, transform_parsed_pair};
 pub use types::*;
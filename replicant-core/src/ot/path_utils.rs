@@ -89,63 +89,8 @@ pub fn adjust_array_index(
     target_index: usize,
     delta: isize,
 ) -> Result<String, SyncError> {
-    let parsed = parse_path(path)?;
-
-    // Find last array index that matches target
-    let last_array_idx = parsed
-        .segments
-        .iter()
-        .enumerate()
-        .rev()
-        .find_map(|(i, seg)| match seg {
-            PathSegment::Array(idx) if *idx == target_index => Some(i),
-            _ => None,
-        });
-
-    let Some(idx_position) = last_array_idx else {
-        // No matching index, return unchanged
-        return Ok(path.to_string());
-    };
-
-    // Calculate new index
-    let old_index = target_index as isize;
-    let new_index = old_index + delta;
-
-    if new_index < 0 {
-        return Err(SyncError::InvalidOperation(format!(
-            "Index adjustment would be negative: {} + {} = {}",
-            old_index, delta, new_index
-        )));
-    }
-
-    // Rebuild path with adjusted index
-    let mut new_segments = parsed.segments;
-    new_segments[idx_position] = PathSegment::Array(new_index as usize);
-
-    Ok(reconstruct_path(&new_segments))
-}
-
-/// Helper: Reconstruct path from segments
-fn reconstruct_path(segments: &[PathSegment]) -> String {
-    if segments.is_empty() {
-        return "/".to_string();
-    }
-
-    let mut path = String::new();
-    for segment in segments {
-        path.push('/');
-        match segment {
-            PathSegment::Object(key) => {
-                // Re-escape special characters (~ must be escaped before /)
-                let escaped = key.replace('~', "~0").replace('/', "~1");
-                path.push_str(&escaped);
-            }
-            PathSegment::Array(idx) => {
-                path.push_str(&idx.to_string());
-            }
-        }
-    }
-    path
+    let adjusted = parse_path(path)?.adjust_array_index(target_index, delta)?;
+    Ok(adjusted.raw)
 }
 
 /// Determine relationship between two paths
@@ -162,12 +107,12 @@ pub fn compare_paths(path1: &str, path2: &str) -> PathRelation {
         return PathRelation::Same;
     }
 
-    // Check parent-child relationships
-    if path2.starts_with(&format!("{}/", path1)) {
+    // Check parent-child relationships (prefix followed by a separator)
+    if matches!(path2.strip_prefix(path1), Some(rest) if rest.starts_with('/')) {
         return PathRelation::Parent; // path1 is parent of path2
     }
 
-    if path1.starts_with(&format!("{}/", path2)) {
+    if matches!(path1.strip_prefix(path2), Some(rest) if rest.starts_with('/')) {
         return PathRelation::Child; // path1 is child of path2
     }
 
@@ -436,7 +381,7 @@ mod tests {
         assert!(!paths_conflict("/users", "/posts"));
     }
 
-    // === Reconstruct Path Tests ===
+    // === Path Reconstruction Tests (via ParsedPath::from_segments) ===
 
     #[test]
     fn test_reconstruct_path_simple() {
@@ -444,7 +389,7 @@ mod tests {
             PathSegment::Object("foo".to_string()),
             PathSegment::Object("bar".to_string()),
         ];
-        assert_eq!(reconstruct_path(&segments), "/foo/bar");
+        assert_eq!(ParsedPath::from_segments(segments).raw, "/foo/bar");
     }
 
     #[test]
@@ -454,7 +399,7 @@ mod tests {
             PathSegment::Array(5),
             PathSegment::Object("name".to_string()),
         ];
-        assert_eq!(reconstruct_path(&segments), "/items/5/name");
+        assert_eq!(ParsedPath::from_segments(segments).raw, "/items/5/name");
     }
 
     #[test]
@@ -463,12 +408,15 @@ mod tests {
             PathSegment::Object("foo~bar".to_string()),
             PathSegment::Object("baz/qux".to_string()),
         ];
-        assert_eq!(reconstruct_path(&segments), "/foo~0bar/baz~1qux");
+        assert_eq!(
+            ParsedPath::from_segments(segments).raw,
+            "/foo~0bar/baz~1qux"
+        );
     }
 
     #[test]
     fn test_reconstruct_path_empty() {
         let segments: Vec<PathSegment> = vec![];
-        assert_eq!(reconstruct_path(&segments), "/");
+        assert_eq!(ParsedPath::from_segments(segments).raw, "/");
     }
 }
@@ -2,12 +2,31 @@
 //!
 //! This module implements array index adjustments and conflict detection for
 //! concurrent JSON Patch operations.
-
-use crate::ot::path_utils::*;
-use crate::ot::types::PathRelation;
+//!
+//! Paths are parsed once into [`ParsedPath`] and threaded through the
+//! transform functions, so every comparison is an integer/slice compare
+//! instead of re-splitting the pointer string. Callers transforming whole
+//! patches should pre-parse each operation's path and use
+//! [`transform_parsed_pair`]; [`transform_operation_pair`] is a convenience
+//! wrapper that parses per call.
+
+use crate::ot::path_utils::parse_path;
+use crate::ot::types::{ParsedPath, PathRelation};
 use crate::SyncError;
 use json_patch::{AddOperation, PatchOperation, RemoveOperation, ReplaceOperation};
 
+/// The JSON Pointer path an operation targets
+pub fn operation_path(op: &PatchOperation) -> &str {
+    match op {
+        PatchOperation::Add(o) => &o.path,
+        PatchOperation::Remove(o) => &o.path,
+        PatchOperation::Replace(o) => &o.path,
+        PatchOperation::Move(o) => &o.path,
+        PatchOperation::Copy(o) => &o.path,
+        PatchOperation::Test(o) => &o.path,
+    }
+}
+
 // ============================================================================
 // Add vs Add Transformation
 // ============================================================================
@@ -17,27 +36,29 @@ use json_patch::{AddOperation, PatchOperation, RemoveOperation, ReplaceOperation
 /// Returns (local_transformed, remote_transformed) or conflict indicator
 pub fn transform_add_add(
     local: &AddOperation,
+    local_path: &ParsedPath,
     remote: &AddOperation,
+    remote_path: &ParsedPath,
 ) -> Result<(Option<AddOperation>, Option<AddOperation>), SyncError> {
     // Check if both are array operations first (handles same index case)
     if let (Some(local_idx), Some(remote_idx)) = (
-        extract_array_index(&local.path),
-        extract_array_index(&remote.path),
+        local_path.last_array_index(),
+        remote_path.last_array_index(),
     ) {
         // Verify they're in the same array
-        if get_parent_path(&local.path) == get_parent_path(&remote.path) {
+        if local_path.parent() == remote_path.parent() {
             // Both adding to same array - adjust indices
             if local_idx <= remote_idx {
                 // Local goes first, adjust remote up
                 let adjusted_remote = AddOperation {
-                    path: adjust_array_index(&remote.path, remote_idx, 1)?,
+                    path: remote_path.adjust_array_index(remote_idx, 1)?.raw,
                     value: remote.value.clone(),
                 };
                 return Ok((Some(local.clone()), Some(adjusted_remote)));
             } else {
                 // Remote goes first, adjust local up
                 let adjusted_local = AddOperation {
-                    path: adjust_array_index(&local.path, local_idx, 1)?,
+                    path: local_path.adjust_array_index(local_idx, 1)?.raw,
                     value: local.value.clone(),
                 };
                 return Ok((Some(adjusted_local), Some(remote.clone())));
@@ -46,7 +67,7 @@ pub fn transform_add_add(
     }
 
     // Not array operations - check path relations
-    let path_relation = compare_paths(&local.path, &remote.path);
+    let path_relation = local_path.relation_to(remote_path);
 
     match path_relation {
         PathRelation::Same => {
@@ -70,25 +91,27 @@ pub fn transform_add_add(
 /// Returns (local_transformed, remote_transformed) or conflict indicator
 pub fn transform_remove_remove(
     local: &RemoveOperation,
+    local_path: &ParsedPath,
     remote: &RemoveOperation,
+    remote_path: &ParsedPath,
 ) -> Result<(Option<RemoveOperation>, Option<RemoveOperation>), SyncError> {
     // Check for array operations first (handles same index case)
     if let (Some(local_idx), Some(remote_idx)) = (
-        extract_array_index(&local.path),
-        extract_array_index(&remote.path),
+        local_path.last_array_index(),
+        remote_path.last_array_index(),
     ) {
-        if get_parent_path(&local.path) == get_parent_path(&remote.path) {
+        if local_path.parent() == remote_path.parent() {
             // Same array - adjust indices
             if local_idx < remote_idx {
                 // Local removes first, remote index shifts down
                 let adjusted_remote = RemoveOperation {
-                    path: adjust_array_index(&remote.path, remote_idx, -1)?,
+                    path: remote_path.adjust_array_index(remote_idx, -1)?.raw,
                 };
                 return Ok((Some(local.clone()), Some(adjusted_remote)));
             } else if local_idx > remote_idx {
                 // Remote removes first, local index shifts down
                 let adjusted_local = RemoveOperation {
-                    path: adjust_array_index(&local.path, local_idx, -1)?,
+                    path: local_path.adjust_array_index(local_idx, -1)?.raw,
                 };
                 return Ok((Some(adjusted_local), Some(remote.clone())));
             } else {
@@ -99,7 +122,7 @@ pub fn transform_remove_remove(
     }
 
     // Not array operations - check path relations
-    let path_relation = compare_paths(&local.path, &remote.path);
+    let path_relation = local_path.relation_to(remote_path);
 
     match path_relation {
         PathRelation::Same => {
@@ -122,25 +145,26 @@ pub fn transform_remove_remove(
 /// Returns (add_transformed, remove_transformed)
 pub fn transform_add_remove(
     add: &AddOperation,
+    add_path: &ParsedPath,
     remove: &RemoveOperation,
+    remove_path: &ParsedPath,
 ) -> Result<(Option<AddOperation>, Option<RemoveOperation>), SyncError> {
     // Check if they're operating on same array
-    if let (Some(add_idx), Some(rem_idx)) = (
-        extract_array_index(&add.path),
-        extract_array_index(&remove.path),
-    ) {
-        if get_parent_path(&add.path) == get_parent_path(&remove.path) {
+    if let (Some(add_idx), Some(rem_idx)) =
+        (add_path.last_array_index(), remove_path.last_array_index())
+    {
+        if add_path.parent() == remove_path.parent() {
             // Same array - adjust indices
             if add_idx <= rem_idx {
                 // Add happens first, remove index shifts up
                 let adjusted_remove = RemoveOperation {
-                    path: adjust_array_index(&remove.path, rem_idx, 1)?,
+                    path: remove_path.adjust_array_index(rem_idx, 1)?.raw,
                 };
                 Ok((Some(add.clone()), Some(adjusted_remove)))
             } else {
                 // Remove happens first, add index shifts down
                 let adjusted_add = AddOperation {
-                    path: adjust_array_index(&add.path, add_idx, -1)?,
+                    path: add_path.adjust_array_index(add_idx, -1)?.raw,
                     value: add.value.clone(),
                 };
                 Ok((Some(adjusted_add), Some(remove.clone())))
@@ -151,7 +175,7 @@ pub fn transform_add_remove(
         }
     } else {
         // Not array operations - check for path conflict
-        if paths_conflict(&add.path, &remove.path) {
+        if add_path.conflicts_with(remove_path) {
             // Conflict - return both
             Ok((Some(add.clone()), Some(remove.clone())))
         } else {
@@ -170,9 +194,11 @@ pub fn transform_add_remove(
 /// Simplified MVP: only checks if paths are identical
 pub fn transform_replace_replace(
     local: &ReplaceOperation,
+    local_path: &ParsedPath,
     remote: &ReplaceOperation,
+    remote_path: &ParsedPath,
 ) -> Result<(Option<ReplaceOperation>, Option<ReplaceOperation>), SyncError> {
-    if local.path == remote.path {
+    if local_path == remote_path {
         // Same path - conflict, return both
         Ok((Some(local.clone()), Some(remote.clone())))
     } else {
@@ -190,6 +216,9 @@ pub fn transform_replace_replace(
 /// Handles: Add, Remove, Replace with array index adjustments
 /// Returns conflicts for caller to resolve
 ///
+/// Parses both paths per call; when transforming whole patches, pre-parse
+/// each operation's path once and use [`transform_parsed_pair`] instead.
+///
 /// # Examples
 /// ```
 /// use json_patch::{PatchOperation, AddOperation};
@@ -212,10 +241,29 @@ pub fn transform_operation_pair(
     local: &PatchOperation,
     remote: &PatchOperation,
 ) -> Result<(Option<PatchOperation>, Option<PatchOperation>), SyncError> {
+    let local_path = parse_path(operation_path(local)).ok();
+    let remote_path = parse_path(operation_path(remote)).ok();
+    transform_parsed_pair(local, local_path.as_ref(), remote, remote_path.as_ref())
+}
+
+/// Transform two patch operations with pre-parsed paths
+///
+/// `None` paths (e.g. the root pointer, which `parse_path` rejects) pass
+/// both operations through unchanged, matching the string-based behavior.
+pub fn transform_parsed_pair(
+    local: &PatchOperation,
+    local_path: Option<&ParsedPath>,
+    remote: &PatchOperation,
+    remote_path: Option<&ParsedPath>,
+) -> Result<(Option<PatchOperation>, Option<PatchOperation>), SyncError> {
+    let (Some(local_path), Some(remote_path)) = (local_path, remote_path) else {
+        return Ok((Some(local.clone()), Some(remote.clone())));
+    };
+
     match (local, remote) {
         // Add vs Add
         (PatchOperation::Add(l), PatchOperation::Add(r)) => {
-            let (l_result, r_result) = transform_add_add(l, r)?;
+            let (l_result, r_result) = transform_add_add(l, local_path, r, remote_path)?;
             Ok((
                 l_result.map(PatchOperation::Add),
                 r_result.map(PatchOperation::Add),
@@ -224,7 +272,7 @@ pub fn transform_operation_pair(
 
         // Remove vs Remove
         (PatchOperation::Remove(l), PatchOperation::Remove(r)) => {
-            let (l_result, r_result) = transform_remove_remove(l, r)?;
+            let (l_result, r_result) = transform_remove_remove(l, local_path, r, remote_path)?;
             Ok((
                 l_result.map(PatchOperation::Remove),
                 r_result.map(PatchOperation::Remove),
@@ -233,14 +281,14 @@ pub fn transform_operation_pair(
 
         // Add vs Remove (and inverse)
         (PatchOperation::Add(a), PatchOperation::Remove(r)) => {
-            let (a_result, r_result) = transform_add_remove(a, r)?;
+            let (a_result, r_result) = transform_add_remove(a, local_path, r, remote_path)?;
             Ok((
                 a_result.map(PatchOperation::Add),
                 r_result.map(PatchOperation::Remove),
             ))
         }
         (PatchOperation::Remove(r), PatchOperation::Add(a)) => {
-            let (a_result, r_result) = transform_add_remove(a, r)?;
+            let (a_result, r_result) = transform_add_remove(a, remote_path, r, local_path)?;
             Ok((
                 r_result.map(PatchOperation::Remove),
                 a_result.map(PatchOperation::Add),
@@ -249,7 +297,7 @@ pub fn transform_operation_pair(
 
         // Replace vs Replace
         (PatchOperation::Replace(l), PatchOperation::Replace(r)) => {
-            let (l_result, r_result) = transform_replace_replace(l, r)?;
+            let (l_result, r_result) = transform_replace_replace(l, local_path, r, remote_path)?;
             Ok((
                 l_result.map(PatchOperation::Replace),
                 r_result.map(PatchOperation::Replace),
@@ -284,6 +332,11 @@ mod tests {
     use super::*;
     use serde_json::json;
 
+    /// Test helper: parse a path, panicking on invalid input
+    fn parsed(path: &str) -> ParsedPath {
+        parse_path(path).unwrap()
+    }
+
     // ========================================================================
     // Add vs Add Tests
     // ========================================================================
@@ -299,7 +352,9 @@ mod tests {
             value: json!("alice@example.com"),
         };
 
-        let (l, r) = transform_add_add(&local, &remote).unwrap();
+        let (l, r) =
+            transform_add_add(&local, &parsed(&local.path), &remote, &parsed(&remote.path))
+                .unwrap();
         assert!(l.is_some());
         assert!(r.is_some());
         assert_eq!(l.unwrap().path, "/user/name");
@@ -317,7 +372,9 @@ mod tests {
             value: json!("light"),
         };
 
-        let (l, r) = transform_add_add(&local, &remote).unwrap();
+        let (l, r) =
+            transform_add_add(&local, &parsed(&local.path), &remote, &parsed(&remote.path))
+                .unwrap();
         // Both returned - caller resolves conflict
         assert!(l.is_some());
         assert!(r.is_some());
@@ -334,7 +391,9 @@ mod tests {
             value: json!("Remote"),
         };
 
-        let (l, r) = transform_add_add(&local, &remote).unwrap();
+        let (l, r) =
+            transform_add_add(&local, &parsed(&local.path), &remote, &parsed(&remote.path))
+                .unwrap();
         assert!(l.is_some());
         assert!(r.is_some());
         assert_eq!(l.unwrap().path, "/items/2");
@@ -352,7 +411,9 @@ mod tests {
             value: json!("B"),
         };
 
-        let (l, r) = transform_add_add(&local, &remote).unwrap();
+        let (l, r) =
+            transform_add_add(&local, &parsed(&local.path), &remote, &parsed(&remote.path))
+                .unwrap();
         assert!(l.is_some());
         assert!(r.is_some());
         // Remote adjusted to next index
@@ -372,7 +433,9 @@ mod tests {
             value: json!("Remote"),
         };
 
-        let (l, r) = transform_add_add(&local, &remote).unwrap();
+        let (l, r) =
+            transform_add_add(&local, &parsed(&local.path), &remote, &parsed(&remote.path))
+                .unwrap();
         assert!(l.is_some());
         assert!(r.is_some());
         assert_eq!(l.unwrap().path, "/1");
@@ -392,7 +455,9 @@ mod tests {
             path: "/user/temp".into(),
         };
 
-        let (l, r) = transform_remove_remove(&local, &remote).unwrap();
+        let (l, r) =
+            transform_remove_remove(&local, &parsed(&local.path), &remote, &parsed(&remote.path))
+                .unwrap();
         // Both returned - caller decides
         assert!(l.is_some());
         assert!(r.is_some());
@@ -407,7 +472,9 @@ mod tests {
             path: "/config/verbose".into(),
         };
 
-        let (l, r) = transform_remove_remove(&local, &remote).unwrap();
+        let (l, r) =
+            transform_remove_remove(&local, &parsed(&local.path), &remote, &parsed(&remote.path))
+                .unwrap();
         assert!(l.is_some());
         assert!(r.is_some());
     }
@@ -421,7 +488,9 @@ mod tests {
             path: "/items/2".into(),
         };
 
-        let (l, r) = transform_remove_remove(&local, &remote).unwrap();
+        let (l, r) =
+            transform_remove_remove(&local, &parsed(&local.path), &remote, &parsed(&remote.path))
+                .unwrap();
         assert!(l.is_some());
         assert!(r.is_some());
         // Local index adjusted down (remote removes first)
@@ -438,7 +507,9 @@ mod tests {
             path: "/items/3".into(),
         };
 
-        let (l, r) = transform_remove_remove(&local, &remote).unwrap();
+        let (l, r) =
+            transform_remove_remove(&local, &parsed(&local.path), &remote, &parsed(&remote.path))
+                .unwrap();
         // Conflict - both returned
         assert!(l.is_some());
         assert!(r.is_some());
@@ -458,7 +529,8 @@ mod tests {
             path: "/posts/old".into(),
         };
 
-        let (a, r) = transform_add_remove(&add, &remove).unwrap();
+        let (a, r) =
+            transform_add_remove(&add, &parsed(&add.path), &remove, &parsed(&remove.path)).unwrap();
         assert!(a.is_some());
         assert!(r.is_some());
     }
@@ -473,7 +545,8 @@ mod tests {
             path: "/items/3".into(),
         };
 
-        let (a, r) = transform_add_remove(&add, &remove).unwrap();
+        let (a, r) =
+            transform_add_remove(&add, &parsed(&add.path), &remove, &parsed(&remove.path)).unwrap();
         assert!(a.is_some());
         assert!(r.is_some());
         assert_eq!(a.unwrap().path, "/items/1");
@@ -490,7 +563,8 @@ mod tests {
             path: "/items/2".into(),
         };
 
-        let (a, r) = transform_add_remove(&add, &remove).unwrap();
+        let (a, r) =
+            transform_add_remove(&add, &parsed(&add.path), &remove, &parsed(&remove.path)).unwrap();
         assert!(a.is_some());
         assert!(r.is_some());
         assert_eq!(a.unwrap().path, "/items/4"); // Adjusted down
@@ -512,7 +586,9 @@ mod tests {
             value: json!("light"),
         };
 
-        let (l, r) = transform_replace_replace(&local, &remote).unwrap();
+        let (l, r) =
+            transform_replace_replace(&local, &parsed(&local.path), &remote, &parsed(&remote.path))
+                .unwrap();
         // Conflict - both returned
         assert!(l.is_some());
         assert!(r.is_some());
@@ -529,7 +605,9 @@ mod tests {
             value: json!(30),
         };
 
-        let (l, r) = transform_replace_replace(&local, &remote).unwrap();
+        let (l, r) =
+            transform_replace_replace(&local, &parsed(&local.path), &remote, &parsed(&remote.path))
+                .unwrap();
         assert!(l.is_some());
         assert!(r.is_some());
     }
@@ -592,4 +670,22 @@ mod tests {
         assert!(l.is_some());
         assert!(r.is_some());
     }
+
+    #[test]
+    fn test_transform_operation_pair_root_pointer_passthrough() {
+        // json_patch::diff can emit the root pointer ("") for whole-document
+        // replacement; it must pass through rather than error
+        let local = PatchOperation::Replace(ReplaceOperation {
+            path: "".into(),
+            value: json!({"whole": "doc"}),
+        });
+        let remote = PatchOperation::Add(AddOperation {
+            path: "/items/0".into(),
+            value: json!("new"),
+        });
+
+        let (l, r) = transform_operation_pair(&local, &remote).unwrap();
+        assert!(l.is_some());
+        assert!(r.is_some());
+    }
 }
@@ -1,5 +1,7 @@
 //! Core types for Operational Transformation
 
+use crate::SyncError;
+
 /// Relationship between two JSON Pointer paths
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub enum PathRelation {
@@ -16,7 +18,7 @@ pub enum PathRelation {
 }
 
 /// Represents a parsed JSON Pointer segment
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Eq, Hash)]
 pub enum PathSegment {
     /// Object property key
     Object(String),
@@ -25,6 +27,10 @@ pub enum PathSegment {
 }
 
 /// Parsed JSON Pointer path with segments
+///
+/// The segments are the canonical form: comparisons and index math operate
+/// on them directly (integer/slice compares), so a path parsed once can be
+/// compared many times without re-splitting or re-allocating the string.
 #[derive(Debug, Clone)]
 pub struct ParsedPath {
     /// Original path string
@@ -33,9 +39,193 @@ pub struct ParsedPath {
     pub segments: Vec<PathSegment>,
 }
 
+impl ParsedPath {
+    /// Build a path from segments, reconstructing the pointer string
+    /// with `~` and `/` re-escaped per RFC 6901
+    pub fn from_segments(segments: Vec<PathSegment>) -> Self {
+        let raw = if segments.is_empty() {
+            "/".to_string()
+        } else {
+            let mut path = String::new();
+            for segment in &segments {
+                path.push('/');
+                match segment {
+                    PathSegment::Object(key) => {
+                        // Re-escape special characters (~ must be escaped before /)
+                        let escaped = key.replace('~', "~0").replace('/', "~1");
+                        path.push_str(&escaped);
+                    }
+                    PathSegment::Array(idx) => {
+                        path.push_str(&idx.to_string());
+                    }
+                }
+            }
+            path
+        };
+
+        ParsedPath { raw, segments }
+    }
+
+    /// The last array index in the path, if any
+    pub fn last_array_index(&self) -> Option<usize> {
+        self.segments.iter().rev().find_map(|seg| match seg {
+            PathSegment::Array(idx) => Some(*idx),
+            _ => None,
+        })
+    }
+
+    /// Parent segments, or None for the root path
+    pub fn parent(&self) -> Option<&[PathSegment]> {
+        match self.segments.len() {
+            0 => None,
+            n => Some(&self.segments[..n - 1]),
+        }
+    }
+
+    /// Determine the relationship to another parsed path
+    ///
+    /// Pure slice/integer comparison; no parsing or allocation. Matches the
+    /// semantics of `compare_paths` on the raw strings, including treating
+    /// the root path as unrelated to everything but itself.
+    pub fn relation_to(&self, other: &ParsedPath) -> PathRelation {
+        if self.segments == other.segments {
+            return PathRelation::Same;
+        }
+
+        if !self.segments.is_empty() && other.segments.starts_with(&self.segments) {
+            return PathRelation::Parent;
+        }
+
+        if !other.segments.is_empty() && self.segments.starts_with(&other.segments) {
+            return PathRelation::Child;
+        }
+
+        // Same parent = siblings (including root level)
+        match (self.parent(), other.parent()) {
+            (Some(p1), Some(p2)) if p1 == p2 => PathRelation::Sibling,
+            _ => PathRelation::Unrelated,
+        }
+    }
+
+    /// Whether operations on these two paths affect each other
+    pub fn conflicts_with(&self, other: &ParsedPath) -> bool {
+        matches!(
+            self.relation_to(other),
+            PathRelation::Same | PathRelation::Parent | PathRelation::Child
+        )
+    }
+
+    /// Adjust the last array index matching `target_index` by `delta`
+    ///
+    /// Returns a new path with the rebuilt pointer string; if no segment
+    /// matches, the path is returned unchanged.
+    pub fn adjust_array_index(
+        &self,
+        target_index: usize,
+        delta: isize,
+    ) -> Result<ParsedPath, SyncError> {
+        // Find last array index that matches target
+        let last_array_idx =
+            self.segments
+                .iter()
+                .enumerate()
+                .rev()
+                .find_map(|(i, seg)| match seg {
+                    PathSegment::Array(idx) if *idx == target_index => Some(i),
+                    _ => None,
+                });
+
+        let Some(idx_position) = last_array_idx else {
+            // No matching index, return unchanged
+            return Ok(self.clone());
+        };
+
+        let old_index = target_index as isize;
+        let new_index = old_index + delta;
+
+        if new_index < 0 {
+            return Err(SyncError::InvalidOperation(format!(
+                "Index adjustment would be negative: {} + {} = {}",
+                old_index, delta, new_index
+            )));
+        }
+
+        let mut new_segments = self.segments.clone();
+        new_segments[idx_position] = PathSegment::Array(new_index as usize);
+
+        Ok(ParsedPath::from_segments(new_segments))
+    }
+}
+
+impl PartialEq for ParsedPath {
+    /// Equality is segment-wise: two pointers naming the same location are
+    /// equal even if their raw strings differ in escaping
+    fn eq(&self, other: &Self) -> bool {
+        self.segments == other.segments
+    }
+}
+
+impl Eq for ParsedPath {}
+
 #[cfg(test)]
 mod tests {
     use super::*;
+    use crate::ot::path_utils::parse_path;
+
+    #[test]
+    fn test_relation_to_matches_string_semantics() {
+        let a = parse_path("/a").unwrap();
+        let ab = parse_path("/a/b").unwrap();
+        let ac = parse_path("/a/c").unwrap();
+        let root = parse_path("/").unwrap();
+
+        assert_eq!(a.relation_to(&a), PathRelation::Same);
+        assert_eq!(a.relation_to(&ab), PathRelation::Parent);
+        assert_eq!(ab.relation_to(&a), PathRelation::Child);
+        assert_eq!(ab.relation_to(&ac), PathRelation::Sibling);
+        // Root is unrelated to everything but itself, like compare_paths
+        assert_eq!(root.relation_to(&a), PathRelation::Unrelated);
+        assert_eq!(root.relation_to(&root), PathRelation::Same);
+    }
+
+    #[test]
+    fn test_relation_to_root_level_array() {
+        let zero = parse_path("/0").unwrap();
+        let one = parse_path("/1").unwrap();
+        assert_eq!(zero.relation_to(&one), PathRelation::Sibling);
+    }
+
+    #[test]
+    fn test_last_array_index() {
+        assert_eq!(
+            parse_path("/users/0/posts/3").unwrap().last_array_index(),
+            Some(3)
+        );
+        assert_eq!(parse_path("/title").unwrap().last_array_index(), None);
+    }
+
+    #[test]
+    fn test_adjust_array_index_rebuilds_raw() {
+        let path = parse_path("/items/5").unwrap();
+        let adjusted = path.adjust_array_index(5, 1).unwrap();
+        assert_eq!(adjusted.raw, "/items/6");
+        assert_eq!(adjusted.last_array_index(), Some(6));
+
+        // Non-matching index is a no-op
+        let unchanged = path.adjust_array_index(3, 1).unwrap();
+        assert_eq!(unchanged.raw, "/items/5");
+
+        // Underflow is rejected
+        assert!(path.adjust_array_index(5, -6).is_err());
+    }
+
+    #[test]
+    fn test_from_segments_reescapes() {
+        let path = parse_path("/a~1b/c~0d").unwrap();
+        let rebuilt = ParsedPath::from_segments(path.segments.clone());
+        assert_eq!(rebuilt.raw, "/a~1b/c~0d");
+        assert_eq!(rebuilt, path);
+    }
 
     #[test]
     fn test_path_relation_equality() {
@@ -1,7 +1,9 @@
 use crate::errors::SyncError;
-use crate::ot::transform_operation_pair;
+use crate::ot::path_utils::{compare_paths, parse_path};
+use crate::ot::types::{ParsedPath, PathRelation, PathSegment};
+use crate::ot::{operation_path, transform_parsed_pair};
 use crate::SyncResult;
-use json_patch::{Patch, PatchOperation};
+use json_patch::{AddOperation, Patch, PatchOperation, RemoveOperation, ReplaceOperation};
 use serde_json::Value;
 use sha2::{Digest, Sha256};
 
@@ -15,9 +17,10 @@ pub fn apply_patch(document: &mut Value, patch: &Patch) -> SyncResult<()> {
 }
 
 pub fn calculate_checksum(value: &Value) -> String {
-    let json_string = serde_json::to_string(value).unwrap();
+    // Stream the serialization straight into the hasher - same digest as
+    // hashing to_string's output, without materializing the document
     let mut hasher = Sha256::new();
-    hasher.update(json_string.as_bytes());
+    serde_json::to_writer(&mut hasher, value).expect("JSON serialization cannot fail");
     format!("{:x}", hasher.finalize())
 }
 
@@ -27,6 +30,166 @@ pub fn merge_patches(patch1: &Patch, patch2: &Patch) -> Patch {
     Patch(operations)
 }
 
+/// Compose an operation sequence into a canonical, shorter equivalent
+///
+/// Successive Add/Replace/Remove operations on the same object path are
+/// folded together (last writer wins, add-then-remove cancels,
+/// remove-then-add becomes replace), so a long offline queue collapses to
+/// at most one operation per touched path before it hits the pairwise
+/// transform. Folding never crosses an operation on an overlapping
+/// (parent/child) path or a Test/Move/Copy, and operations whose paths
+/// contain array indices are left untouched because inserts and removes
+/// shift their neighbours.
+///
+/// # Example
+/// ```
+/// use replicant_core::patches::compose_patches;
+/// use json_patch::{Patch, PatchOperation, ReplaceOperation};
+/// use serde_json::json;
+///
+/// let patch = Patch(vec![
+///     PatchOperation::Replace(ReplaceOperation {
+///         path: "/title".into(),
+///         value: json!("draft"),
+///     }),
+///     PatchOperation::Replace(ReplaceOperation {
+///         path: "/title".into(),
+///         value: json!("final"),
+///     }),
+/// ]);
+///
+/// let composed = compose_patches(&patch);
+/// assert_eq!(composed.0.len(), 1);
+/// ```
+pub fn compose_patches(patch: &Patch) -> Patch {
+    let mut composed: Vec<PatchOperation> = Vec::with_capacity(patch.0.len());
+
+    'next_op: for op in &patch.0 {
+        if is_foldable(op) {
+            let path = operation_path(op);
+
+            // Scan backwards for an earlier operation on the same path,
+            // stopping at anything that overlaps it or reads document state
+            for i in (0..composed.len()).rev() {
+                let prev = &composed[i];
+                if !matches!(
+                    prev,
+                    PatchOperation::Add(_) | PatchOperation::Remove(_) | PatchOperation::Replace(_)
+                ) {
+                    // Test/Move/Copy observe or move state - don't fold across
+                    break;
+                }
+
+                match compare_paths(operation_path(prev), path) {
+                    PathRelation::Same => {
+                        if fold_pair(&mut composed, i, op) {
+                            continue 'next_op;
+                        }
+                        // Invalid sequence (e.g. remove-then-remove) - keep as-is
+                        break;
+                    }
+                    PathRelation::Parent | PathRelation::Child => break,
+                    _ => {}
+                }
+            }
+        }
+
+        composed.push(op.clone());
+    }
+
+    Patch(composed)
+}
+
+/// Whether an operation is a candidate for folding in `compose_patches`
+///
+/// Only plain object paths qualify: array indices shift neighbouring
+/// elements, so those operations cannot be collapsed pairwise.
+fn is_foldable(op: &PatchOperation) -> bool {
+    if !matches!(
+        op,
+        PatchOperation::Add(_) | PatchOperation::Remove(_) | PatchOperation::Replace(_)
+    ) {
+        return false;
+    }
+
+    match parse_path(operation_path(op)) {
+        Ok(parsed) => !parsed
+            .segments
+            .iter()
+            .any(|seg| matches!(seg, PathSegment::Array(_))),
+        Err(_) => false,
+    }
+}
+
+/// Fold `op` into the earlier same-path operation at `composed[i]`
+///
+/// Returns true if the fold happened. Patches here come from
+/// `json_patch::diff`, where an Add means the member was absent in the
+/// base document - so add-then-remove is a net no-op and
+/// remove-then-add is a net replace.
+fn fold_pair(composed: &mut Vec<PatchOperation>, i: usize, op: &PatchOperation) -> bool {
+    match (&composed[i], op) {
+        // Later write on a member this sequence created - the add carries
+        // the final value
+        (PatchOperation::Add(prev), PatchOperation::Add(new)) => {
+            composed[i] = PatchOperation::Add(AddOperation {
+                path: prev.path.clone(),
+                value: new.value.clone(),
+            });
+            true
+        }
+        (PatchOperation::Add(prev), PatchOperation::Replace(new)) => {
+            composed[i] = PatchOperation::Add(AddOperation {
+                path: prev.path.clone(),
+                value: new.value.clone(),
+            });
+            true
+        }
+
+        // The add created the member, so removing it again is a no-op
+        (PatchOperation::Add(_), PatchOperation::Remove(_)) => {
+            composed.remove(i);
+            true
+        }
+
+        // Last write wins on an existing member
+        (PatchOperation::Replace(prev), PatchOperation::Replace(new)) => {
+            composed[i] = PatchOperation::Replace(ReplaceOperation {
+                path: prev.path.clone(),
+                value: new.value.clone(),
+            });
+            true
+        }
+        (PatchOperation::Replace(prev), PatchOperation::Add(new)) => {
+            composed[i] = PatchOperation::Replace(ReplaceOperation {
+                path: prev.path.clone(),
+                value: new.value.clone(),
+            });
+            true
+        }
+
+        (PatchOperation::Replace(prev), PatchOperation::Remove(_)) => {
+            composed[i] = PatchOperation::Remove(RemoveOperation {
+                path: prev.path.clone(),
+            });
+            true
+        }
+
+        // The member existed before the remove, so re-adding it is a replace
+        (PatchOperation::Remove(prev), PatchOperation::Add(new)) => {
+            composed[i] = PatchOperation::Replace(ReplaceOperation {
+                path: prev.path.clone(),
+                value: new.value.clone(),
+            });
+            true
+        }
+
+        // Remove-then-remove / remove-then-replace would not apply cleanly;
+        // preserve the sequence instead of papering over it
+        _ => false,
+    }
+}
+
 /// Compute a reverse patch that can undo the given forward patch
 /// Requires the original document state before the patch was applied
 pub fn compute_reverse_patch(original: &Value, forward_patch: &Patch) -> SyncResult<Patch> {
@@ -85,7 +248,14 @@ pub fn transform_patches(
             // Simple strategy: remote wins
             Ok((Patch(vec![]), remote.clone()))
         }
-        TransformStrategy::Operational => transform_operations(&local.0, &remote.0),
+        TransformStrategy::Operational => {
+            // Canonicalize both sides first: the pairwise transform below is
+            // O(local x remote), so folding redundant operations up front is
+            // what keeps a long offline queue tractable
+            let local = compose_patches(local);
+            let remote = compose_patches(remote);
+            transform_operations(&local.0, &remote.0)
+        }
     }
 }
 
@@ -115,13 +285,31 @@ fn transform_operations(
         return Ok((Patch(local_ops.to_vec()), Patch(vec![])));
     }
 
+    // Parse every path once up front - the pairwise loop below compares
+    // each local op against each remote op, so re-parsing per pair would
+    // dominate the cost for large patches. Unparseable paths (e.g. the
+    // root pointer) stay None and pass through unchanged.
+    let local_paths: Vec<Option<ParsedPath>> = local_ops
+        .iter()
+        .map(|op| parse_path(operation_path(op)).ok())
+        .collect();
+    let remote_paths: Vec<Option<ParsedPath>> = remote_ops
+        .iter()
+        .map(|op| parse_path(operation_path(op)).ok())
+        .collect();
+
     // Transform each pair of operations
     let mut transformed_local = Vec::new();
     let mut transformed_remote = Vec::new();
 
-    for local_op in local_ops {
-        for remote_op in remote_ops {
-            let (l_result, r_result) = transform_operation_pair(local_op, remote_op)?;
+    for (local_op, local_path) in local_ops.iter().zip(&local_paths) {
+        for (remote_op, remote_path) in remote_ops.iter().zip(&remote_paths) {
+            let (l_result, r_result) = transform_parsed_pair(
+                local_op,
+                local_path.as_ref(),
+                remote_op,
+                remote_path.as_ref(),
+            )?;
 
             if let Some(l_op) = l_result {
                 if !transformed_local.contains(&l_op) {
@@ -139,3 +327,131 @@ fn transform_operations(
 
     Ok((Patch(transformed_local), Patch(transformed_remote)))
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use json_patch::TestOperation;
+    use serde_json::json;
+
+    fn replace(path: &str, value: Value) -> PatchOperation {
+        PatchOperation::Replace(ReplaceOperation {
+            path: path.into(),
+            value,
+        })
+    }
+
+    fn add(path: &str, value: Value) -> PatchOperation {
+        PatchOperation::Add(AddOperation {
+            path: path.into(),
+            value,
+        })
+    }
+
+    fn remove(path: &str) -> PatchOperation {
+        PatchOperation::Remove(RemoveOperation { path: path.into() })
+    }
+
+    #[test]
+    fn test_compose_replace_replace_last_wins() {
+        let patch = Patch(vec![
+            replace("/title", json!("draft")),
+            replace("/status", json!("open")),
+            replace("/title", json!("final")),
+        ]);
+
+        let composed = compose_patches(&patch);
+        assert_eq!(composed.0.len(), 2);
+        assert_eq!(composed.0[0], replace("/title", json!("final")));
+        assert_eq!(composed.0[1], replace("/status", json!("open")));
+    }
+
+    #[test]
+    fn test_compose_add_remove_cancels() {
+        let patch = Patch(vec![add("/scratch", json!("tmp")), remove("/scratch")]);
+
+        let composed = compose_patches(&patch);
+        assert!(composed.0.is_empty());
+    }
+
+    #[test]
+    fn test_compose_remove_add_becomes_replace() {
+        let patch = Patch(vec![remove("/title"), add("/title", json!("restored"))]);
+
+        let composed = compose_patches(&patch);
+        assert_eq!(composed.0.len(), 1);
+        assert_eq!(composed.0[0], replace("/title", json!("restored")));
+    }
+
+    #[test]
+    fn test_compose_leaves_array_operations_alone() {
+        // Inserts at the same index are two distinct elements, not a rewrite
+        let patch = Patch(vec![
+            add("/items/0", json!("a")),
+            add("/items/0", json!("b")),
+        ]);
+
+        let composed = compose_patches(&patch);
+        assert_eq!(composed.0.len(), 2);
+    }
+
+    #[test]
+    fn test_compose_does_not_fold_across_parent_write() {
+        // The middle replace rewrites /a entirely, so the two /a/b writes
+        // must not be merged across it
+        let patch = Patch(vec![
+            add("/a/b", json!(1)),
+            replace("/a", json!({})),
+            replace("/a/b", json!(2)),
+        ]);
+
+        let composed = compose_patches(&patch);
+        assert_eq!(composed.0.len(), 3);
+    }
+
+    #[test]
+    fn test_compose_does_not_fold_across_test() {
+        let patch = Patch(vec![
+            replace("/title", json!("draft")),
+            PatchOperation::Test(TestOperation {
+                path: "/title".into(),
+                value: json!("draft"),
+            }),
+            replace("/title", json!("final")),
+        ]);
+
+        let composed = compose_patches(&patch);
+        assert_eq!(composed.0.len(), 3);
+    }
+
+    #[test]
+    fn test_transform_patches_composes_before_transform() {
+        // Twenty redundant writes on each side collapse to one conflict pair
+        let local = Patch(
+            (0..20)
+                .map(|i| replace("/title", json!(format!("local-{}", i))))
+                .collect(),
+        );
+        let remote = Patch(
+            (0..20)
+                .map(|i| replace("/title", json!(format!("remote-{}", i))))
+                .collect(),
+        );
+
+        let (l, r) = transform_patches(&local, &remote, TransformStrategy::Operational).unwrap();
+        assert_eq!(l.0.len(), 1);
+        assert_eq!(r.0.len(), 1);
+        assert_eq!(l.0[0], replace("/title", json!("local-19")));
+        assert_eq!(r.0[0], replace("/title", json!("remote-19")));
+    }
+
+    #[test]
+    fn test_transform_patches_still_adjusts_array_indices() {
+        let local = Patch(vec![add("/items/2", json!("local"))]);
+        let remote = Patch(vec![add("/items/5", json!("remote"))]);
+
+        let (l, r) = transform_patches(&local, &remote, TransformStrategy::Operational).unwrap();
+        assert_eq!(l.0[0], add("/items/2", json!("local")));
+        assert_eq!(r.0[0], add("/items/6", json!("remote")));
+    }
+}
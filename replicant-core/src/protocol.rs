@@ -1,8 +1,67 @@
+use crate::checksums::ChecksumAlgorithm;
 use crate::models::{Document, DocumentPatch};
+use crate::SyncResult;
 use serde::{Deserialize, Serialize};
 use strum::{Display, EnumString};
 use uuid::Uuid;
 
+/// Wire encodings a peer can speak, negotiated during authentication
+///
+/// The client advertises the binary encodings it understands in
+/// `Authenticate`; the server picks one and echoes it in `AuthSuccess`.
+/// Frames stay self-describing regardless: text frames are always JSON
+/// and binary frames are always MessagePack, so a peer that never
+/// negotiates (or an old peer that ignores the fields) keeps working on
+/// JSON alone.
+#[derive(Debug, Clone, Copy, PartialEq, Serialize, Deserialize, Display, EnumString)]
+#[serde(rename_all = "snake_case")]
+#[strum(serialize_all = "snake_case")]
+pub enum WireEncoding {
+    Json,
+    MessagePack,
+}
+
+/// An encoded protocol frame ready for the transport layer
+#[derive(Debug, Clone)]
+pub enum WireFrame {
+    /// JSON, sent as a text frame
+    Text(String),
+    /// MessagePack, sent as a binary frame
+    Binary(Vec<u8>),
+}
+
+/// Encode a protocol message for the given wire encoding
+///
+/// Binary frames over the compression threshold are zstd-compressed;
+/// the zstd magic number keeps them distinguishable from raw MessagePack
+/// (whose top-level map markers can never collide with it).
+pub fn encode_message<T: Serialize>(message: &T, encoding: WireEncoding) -> SyncResult<WireFrame> {
+    match encoding {
+        WireEncoding::Json => Ok(WireFrame::Text(serde_json::to_string(message)?)),
+        // to_vec_named keeps struct fields as maps, which the tagged enum
+        // representation (and optional fields) require
+        WireEncoding::MessagePack => {
+            let bytes = rmp_serde::to_vec_named(message).map_err(|e| {
+                crate::errors::SyncError::InvalidOperation(format!(
+                    "MessagePack encode failed: {}",
+                    e
+                ))
+            })?;
+            Ok(WireFrame::Binary(crate::compression::maybe_compress(
+                bytes,
+            )?))
+        }
+    }
+}
+
+/// Decode a binary (MessagePack, optionally zstd-compressed) protocol frame
+pub fn decode_binary_message<T: serde::de::DeserializeOwned>(bytes: &[u8]) -> SyncResult<T> {
+    let bytes = crate::compression::maybe_decompress(bytes)?;
+    rmp_serde::from_slice(&bytes).map_err(|e| {
+        crate::errors::SyncError::InvalidOperation(format!("MessagePack decode failed: {}", e))
+    })
+}
+
 #[derive(Debug, Clone, Serialize, Deserialize)]
 #[serde(tag = "type", rename_all = "snake_case")]
 pub enum ClientMessage {
@@ -16,6 +75,29 @@ pub enum ClientMessage {
         signature: Option<String>,
         #[serde(skip_serializing_if = "Option::is_none")]
         timestamp: Option<i64>,
+        /// Binary encodings this client can receive, in preference order.
+        /// Absent or empty means JSON only (pre-negotiation peers).
+        #[serde(default, skip_serializing_if = "Option::is_none")]
+        encodings: Option<Vec<WireEncoding>>,
+        /// Checksum algorithms this client can produce, in preference
+        /// order. Absent or empty means SHA-256 only.
+        #[serde(default, skip_serializing_if = "Option::is_none")]
+        checksums: Option<Vec<ChecksumAlgorithm>>,
+    },
+
+    /// Resume a previously authenticated session in one round trip: the
+    /// server validates the token from `AuthSuccess` and immediately
+    /// replays the change stream after `last_sequence`, skipping the full
+    /// handshake and pending-document scan
+    ResumeSession {
+        session_id: Uuid,
+        client_id: Uuid,
+        /// Highest change-event sequence the client has already applied
+        last_sequence: u64,
+        #[serde(default, skip_serializing_if = "Option::is_none")]
+        encodings: Option<Vec<WireEncoding>>,
+        #[serde(default, skip_serializing_if = "Option::is_none")]
+        checksums: Option<Vec<ChecksumAlgorithm>>,
     },
 
     // Document operations
@@ -55,6 +137,14 @@ pub enum ServerMessage {
     AuthSuccess {
         session_id: Uuid,
         client_id: Uuid,
+        /// Encoding the server will use for subsequent frames and accepts
+        /// from the client (absent means JSON)
+        #[serde(default, skip_serializing_if = "Option::is_none")]
+        encoding: Option<WireEncoding>,
+        /// Checksum algorithm the server picked from the client's offer
+        /// (absent means SHA-256)
+        #[serde(default, skip_serializing_if = "Option::is_none")]
+        checksum: Option<ChecksumAlgorithm>,
     },
     AuthError {
         reason: String,
@@ -93,6 +183,14 @@ pub enum ServerMessage {
     SyncDocument {
         document: Document,
     },
+    /// A size-bounded slice of a full sync: lets the client overlap
+    /// network receive with batched multi-row writes instead of applying
+    /// one document transaction at a time
+    SyncBatch {
+        documents: Vec<Document>,
+        batch_index: u32,
+        total_batches: u32,
+    },
     SyncComplete {
         synced_count: usize,
     },
@@ -109,6 +207,13 @@ pub enum ServerMessage {
         latest_sequence: u64,
         has_more: bool, // True if there are more changes beyond the limit
     },
+    /// Answer to a change request from before the compaction horizon:
+    /// the per-edit events are gone, so the current documents stand in
+    /// for the replay and the client fast-forwards to latest_sequence
+    Snapshot {
+        documents: Vec<Document>,
+        latest_sequence: u64,
+    },
     ChangesAcknowledged {
         sequence: u64,
     },
@@ -155,6 +260,11 @@ pub struct ChangeEvent {
     pub event_type: ChangeEventType,
     pub forward_patch: Option<serde_json::Value>,
     pub reverse_patch: Option<serde_json::Value>, // patch to undo this change
+    /// Client that produced this change (absent for events recorded
+    /// before the column existed); a resuming client uses it to skip
+    /// replaying its own uploads
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub origin_client_id: Option<Uuid>,
     pub created_at: chrono::DateTime<chrono::Utc>,
 }
 
@@ -166,3 +276,74 @@ pub enum ChangeEventType {
     Update,
     Delete,
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::models::DocumentPatch;
+    use serde_json::json;
+
+    #[test]
+    fn test_messagepack_round_trip() {
+        let message = ClientMessage::UpdateDocument {
+            patch: DocumentPatch {
+                document_id: Uuid::new_v4(),
+                patch: serde_json::from_value(
+                    json!([{"op": "replace", "path": "/title", "value": "hello"}]),
+                )
+                .unwrap(),
+                content_hash: "abc123".to_string(),
+            },
+        };
+
+        let frame = encode_message(&message, WireEncoding::MessagePack).unwrap();
+        let bytes = match frame {
+            WireFrame::Binary(bytes) => bytes,
+            WireFrame::Text(_) => panic!("MessagePack should produce a binary frame"),
+        };
+
+        let decoded: ClientMessage = decode_binary_message(&bytes).unwrap();
+        match (message, decoded) {
+            (
+                ClientMessage::UpdateDocument { patch: original },
+                ClientMessage::UpdateDocument { patch: decoded },
+            ) => {
+                assert_eq!(original.document_id, decoded.document_id);
+                assert_eq!(original.patch, decoded.patch);
+                assert_eq!(original.content_hash, decoded.content_hash);
+            }
+            _ => panic!("Round trip changed message variant"),
+        }
+    }
+
+    #[test]
+    fn test_json_auth_fields_stay_backward_compatible() {
+        // A pre-negotiation peer omits the encoding fields entirely
+        let legacy = r#"{"type": "authenticate", "email": "a@b.c",
+                         "client_id": "6a3a9f1e-25b2-4e5c-9c65-0e2f43f4d8aa"}"#;
+        let parsed: ClientMessage = serde_json::from_str(legacy).unwrap();
+        match parsed {
+            ClientMessage::Authenticate {
+                encodings,
+                checksums,
+                ..
+            } => {
+                assert!(encodings.is_none());
+                assert!(checksums.is_none());
+            }
+            other => panic!("expected Authenticate, got {:?}", other),
+        }
+
+        // And we omit them on the wire when unset, so old servers see
+        // exactly the old shape
+        let auth = ServerMessage::AuthSuccess {
+            session_id: Uuid::new_v4(),
+            client_id: Uuid::new_v4(),
+            encoding: None,
+            checksum: None,
+        };
+        let json = serde_json::to_string(&auth).unwrap();
+        assert!(!json.contains("encoding"));
+        assert!(!json.contains("checksum"));
+    }
+}
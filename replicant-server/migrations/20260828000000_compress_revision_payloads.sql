@@ -0,0 +1,6 @@
+-- Store revision payloads zstd-compressed. The JSONB columns stay for
+-- existing rows (readers fall back to them); new rows write only the
+-- compressed bytea columns.
+ALTER TABLE document_revisions ALTER COLUMN content DROP NOT NULL;
+ALTER TABLE document_revisions ADD COLUMN content_zstd BYTEA;
+ALTER TABLE document_revisions ADD COLUMN patch_zstd BYTEA;
@@ -0,0 +1,8 @@
+-- Per-user compaction horizon for the change-event log. Events at or
+-- below checkpoint_sequence have been pruned; clients whose cursor is
+-- older receive a document snapshot instead of an event replay.
+CREATE TABLE IF NOT EXISTS change_checkpoints (
+    user_id UUID PRIMARY KEY REFERENCES users(id) ON DELETE CASCADE,
+    checkpoint_sequence BIGINT NOT NULL,
+    created_at TIMESTAMPTZ NOT NULL DEFAULT NOW()
+);
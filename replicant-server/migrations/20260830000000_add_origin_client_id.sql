@@ -0,0 +1,5 @@
+-- Record which client produced each change event so a resuming client
+-- can skip replaying its own uploads instead of applying them twice.
+-- NULL for events from before this column existed and for server-side
+-- bookkeeping (e.g. conflict losers) with no single originating client.
+ALTER TABLE change_events ADD COLUMN origin_client_id UUID;
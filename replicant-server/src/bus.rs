@@ -0,0 +1,241 @@
+//! Inter-node change-stream bus over Postgres LISTEN/NOTIFY
+//!
+//! Every server node already shares the same Postgres instance, so the
+//! database doubles as the pub-sub fabric: broadcasts are published with
+//! `pg_notify` and each node runs a listener that re-delivers them to its
+//! own sockets. This makes the server horizontally scalable behind a load
+//! balancer without introducing a separate broker.
+
+use crate::{broadcast_frame_to_user, AppState, BroadcastFrame};
+use replicant_core::protocol::ServerMessage;
+use replicant_core::SyncResult;
+use serde::{Deserialize, Serialize};
+use sqlx::postgres::PgListener;
+use std::sync::Arc;
+use uuid::Uuid;
+
+/// Channel all nodes publish and listen on
+pub const NOTIFY_CHANNEL: &str = "replicant_changes";
+
+/// Postgres caps NOTIFY payloads at 8000 bytes; leave headroom for quoting
+const MAX_NOTIFY_PAYLOAD_BYTES: usize = 7800;
+
+/// One broadcast as it travels between nodes
+#[derive(Debug, Serialize, Deserialize)]
+struct BusEnvelope {
+    /// Node that published the event; the publisher ignores its own
+    /// notifications since it already delivered to local sockets
+    origin: Uuid,
+    user_id: Uuid,
+    exclude_client_id: Option<Uuid>,
+    payload: BusPayload,
+}
+
+#[derive(Debug, Serialize, Deserialize)]
+#[serde(rename_all = "snake_case")]
+enum BusPayload {
+    /// Full message inline - the common case, when it fits the NOTIFY limit
+    Message(ServerMessage),
+    /// Compact reference used when the inline form would exceed the NOTIFY
+    /// limit; the receiving node refetches the document from the shared
+    /// database and rebuilds the broadcast before local delivery
+    DocumentRef {
+        document_id: Uuid,
+        kind: DocumentEventKind,
+        sync_revision: i64,
+    },
+}
+
+/// Which content-bearing broadcast a `DocumentRef` stands in for
+#[derive(Debug, Clone, Copy, Serialize, Deserialize)]
+#[serde(rename_all = "snake_case")]
+enum DocumentEventKind {
+    Created,
+    Synced,
+}
+
+/// Compact reference form of a document broadcast, if it has one
+fn compact_ref(message: &ServerMessage) -> Option<BusPayload> {
+    match message {
+        ServerMessage::DocumentCreated { document } => Some(BusPayload::DocumentRef {
+            document_id: document.id,
+            kind: DocumentEventKind::Created,
+            sync_revision: document.sync_revision,
+        }),
+        ServerMessage::SyncDocument { document } => Some(BusPayload::DocumentRef {
+            document_id: document.id,
+            kind: DocumentEventKind::Synced,
+            sync_revision: document.sync_revision,
+        }),
+        _ => None,
+    }
+}
+
+/// Publish a broadcast so subscribers on other nodes receive it
+///
+/// Broadcasts that embed a full document fall back to a compact
+/// reference when the inline envelope would exceed the NOTIFY limit, so
+/// large documents still sync between nodes. Only oversized messages with
+/// no compact form are dropped (with a warning) rather than failing the
+/// originating request.
+pub async fn publish(
+    state: &AppState,
+    user_id: Uuid,
+    exclude_client_id: Option<Uuid>,
+    message: ServerMessage,
+) -> SyncResult<()> {
+    let reference = compact_ref(&message);
+    let mut envelope = BusEnvelope {
+        origin: state.node_id,
+        user_id,
+        exclude_client_id,
+        payload: BusPayload::Message(message),
+    };
+    let mut payload = serde_json::to_string(&envelope)?;
+
+    if payload.len() > MAX_NOTIFY_PAYLOAD_BYTES {
+        match reference {
+            Some(reference) => {
+                envelope.payload = reference;
+                payload = serde_json::to_string(&envelope)?;
+            }
+            None => {
+                tracing::warn!(
+                    "Bus payload for user {} is {} bytes (limit {}) with no compact form, \
+                     dropping inter-node broadcast",
+                    user_id,
+                    payload.len(),
+                    MAX_NOTIFY_PAYLOAD_BYTES
+                );
+                return Ok(());
+            }
+        }
+    }
+
+    sqlx::query("SELECT pg_notify($1, $2)")
+        .bind(NOTIFY_CHANNEL)
+        .bind(payload)
+        .execute(&state.db.pool)
+        .await?;
+
+    Ok(())
+}
+
+/// Spawn the listener task that bridges other nodes' broadcasts onto this
+/// node's local sockets, reconnecting with backoff on failure
+pub fn spawn_listener(state: Arc<AppState>) {
+    tokio::spawn(async move {
+        loop {
+            if let Err(e) = run_listener(&state).await {
+                tracing::error!("Change-stream bus listener failed: {}", e);
+            }
+            tokio::time::sleep(std::time::Duration::from_secs(5)).await;
+        }
+    });
+}
+
+async fn run_listener(state: &Arc<AppState>) -> SyncResult<()> {
+    let mut listener = PgListener::connect_with(&state.db.pool).await?;
+    listener.listen(NOTIFY_CHANNEL).await?;
+    tracing::info!(
+        "Change-stream bus listening on '{}' as node {}",
+        NOTIFY_CHANNEL,
+        state.node_id
+    );
+
+    loop {
+        let notification = listener.recv().await?;
+        let envelope: BusEnvelope = match serde_json::from_str(notification.payload()) {
+            Ok(envelope) => envelope,
+            Err(e) => {
+                tracing::warn!("Ignoring malformed bus payload: {}", e);
+                continue;
+            }
+        };
+
+        if envelope.origin == state.node_id {
+            continue; // delivered to local sockets at publish time
+        }
+
+        let message = match envelope.payload {
+            BusPayload::Message(message) => message,
+            BusPayload::DocumentRef {
+                document_id,
+                kind,
+                sync_revision,
+            } => {
+                let document = match state.db.get_document(&document_id).await {
+                    Ok(document) => document,
+                    Err(e) => {
+                        // The document may already be deleted again; the
+                        // deletion broadcast travels inline on its own
+                        tracing::warn!(
+                            "Failed to fetch document {} referenced on the bus: {}",
+                            document_id,
+                            e
+                        );
+                        continue;
+                    }
+                };
+                if document.sync_revision != sync_revision {
+                    // A later update landed between publish and fetch;
+                    // broadcasting the newer state still converges
+                    tracing::debug!(
+                        "Bus reference for document {} was revision {}, delivering {}",
+                        document_id,
+                        sync_revision,
+                        document.sync_revision
+                    );
+                }
+                match kind {
+                    DocumentEventKind::Created => ServerMessage::DocumentCreated { document },
+                    DocumentEventKind::Synced => ServerMessage::SyncDocument { document },
+                }
+            }
+        };
+
+        let frame = match BroadcastFrame::encode(&message) {
+            Ok(frame) => frame,
+            Err(e) => {
+                tracing::warn!("Failed to encode bus broadcast: {}", e);
+                continue;
+            }
+        };
+        broadcast_frame_to_user(state, envelope.user_id, envelope.exclude_client_id, &frame).await;
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use chrono::Utc;
+    use replicant_core::models::Document;
+
+    #[test]
+    fn test_oversized_document_broadcast_has_compact_ref() {
+        let document = Document {
+            id: Uuid::new_v4(),
+            user_id: Uuid::new_v4(),
+            content: serde_json::json!({ "body": "x".repeat(20_000) }),
+            sync_revision: 7,
+            content_hash: None,
+            title: None,
+            created_at: Utc::now(),
+            updated_at: Utc::now(),
+            deleted_at: None,
+        };
+        let message = ServerMessage::SyncDocument { document };
+
+        let envelope = BusEnvelope {
+            origin: Uuid::new_v4(),
+            user_id: Uuid::new_v4(),
+            exclude_client_id: Some(Uuid::new_v4()),
+            payload: compact_ref(&message).expect("document broadcasts have a compact form"),
+        };
+        let payload = serde_json::to_string(&envelope).unwrap();
+        assert!(payload.len() <= MAX_NOTIFY_PAYLOAD_BYTES);
+
+        // Messages without embedded content never need (or get) one
+        assert!(compact_ref(&ServerMessage::Pong).is_none());
+    }
+}
@@ -1,5 +1,6 @@
 use crate::queries::document_to_params;
 use json_patch::Patch;
+use replicant_core::compression;
 use replicant_core::models::Document;
 use replicant_core::protocol::{ChangeEvent, ChangeEventType};
 use replicant_core::{SyncError, SyncResult};
@@ -7,6 +8,14 @@ use sqlx::{postgres::PgPoolOptions, PgPool};
 use tracing::instrument;
 use uuid::Uuid;
 
+/// A stored document revision, decompressed for the caller
+pub struct DocumentRevision {
+    pub content: serde_json::Value,
+    pub patch: Option<Patch>,
+    pub sync_revision: i64,
+    pub created_at: chrono::DateTime<chrono::Utc>,
+}
+
 pub struct ChangeEventParams<'a> {
     pub document_id: &'a Uuid,
     pub user_id: &'a Uuid,
@@ -14,6 +23,8 @@ pub struct ChangeEventParams<'a> {
     pub forward_patch: Option<&'a serde_json::Value>,
     pub reverse_patch: Option<&'a serde_json::Value>,
     pub applied: bool,
+    /// Client that produced the change, when there is one
+    pub origin_client_id: Option<Uuid>,
 }
 
 pub struct ServerDatabase {
@@ -97,6 +108,16 @@ impl ServerDatabase {
     }
 
     pub async fn create_document(&self, doc: &Document) -> SyncResult<()> {
+        self.create_document_with_origin(doc, None).await
+    }
+
+    /// Create a document, recording which client originated the change
+    /// in the event log so that client can skip it during resume replay
+    pub async fn create_document_with_origin(
+        &self,
+        doc: &Document,
+        origin_client_id: Option<Uuid>,
+    ) -> SyncResult<()> {
         // Start a transaction to ensure atomicity
         let mut tx = self.pool.begin().await?;
         let params = document_to_params(doc);
@@ -135,6 +156,7 @@ impl ServerDatabase {
                 forward_patch: Some(&doc_json),
                 reverse_patch: None,
                 applied: true,
+                origin_client_id,
             },
         )
         .await?;
@@ -169,9 +191,20 @@ impl ServerDatabase {
     }
 
     pub async fn update_document(&self, doc: &Document, patch: Option<&Patch>) -> SyncResult<()> {
+        self.update_document_with_origin(doc, patch, None).await
+    }
+
+    /// Update a document, recording the originating client in the event log
+    pub async fn update_document_with_origin(
+        &self,
+        doc: &Document,
+        patch: Option<&Patch>,
+        origin_client_id: Option<Uuid>,
+    ) -> SyncResult<()> {
         // Start a transaction to ensure atomicity
         let mut tx = self.pool.begin().await?;
-        self.update_document_in_tx(&mut tx, doc, patch).await?;
+        self.update_document_in_tx(&mut tx, doc, patch, origin_client_id)
+            .await?;
         tx.commit().await?;
         Ok(())
     }
@@ -182,6 +215,7 @@ impl ServerDatabase {
         tx: &mut sqlx::Transaction<'_, sqlx::Postgres>,
         doc: &Document,
         patch: Option<&Patch>,
+        origin_client_id: Option<Uuid>,
     ) -> SyncResult<()> {
         // CRITICAL: Read the original document INSIDE the transaction with row lock
         // This prevents race conditions in computing reverse patches
@@ -266,6 +300,7 @@ impl ServerDatabase {
                 forward_patch: forward_patch_json.as_ref(),
                 reverse_patch: reverse_patch_json.as_ref(),
                 applied: true,
+                origin_client_id,
             },
         )
         .await?;
@@ -274,6 +309,18 @@ impl ServerDatabase {
     }
 
     pub async fn delete_document(&self, document_id: &Uuid, user_id: &Uuid) -> SyncResult<()> {
+        self.delete_document_with_origin(document_id, user_id, None)
+            .await
+    }
+
+    /// Soft-delete a document, recording the originating client in the
+    /// event log
+    pub async fn delete_document_with_origin(
+        &self,
+        document_id: &Uuid,
+        user_id: &Uuid,
+        origin_client_id: Option<Uuid>,
+    ) -> SyncResult<()> {
         // Start a transaction to ensure atomicity
         let mut tx = self.pool.begin().await?;
 
@@ -302,6 +349,7 @@ impl ServerDatabase {
                 forward_patch: None,
                 reverse_patch: Some(&doc_json),
                 applied: true,
+                origin_client_id,
             },
         )
         .await?;
@@ -341,27 +389,87 @@ impl ServerDatabase {
     }
 
     pub async fn create_revision(&self, doc: &Document, patch: Option<&Patch>) -> SyncResult<()> {
-        let patch_json = patch.map(|p| serde_json::to_value(p).unwrap());
-        let content_json = serde_json::to_value(&doc.content).unwrap();
-
-        sqlx::query!(
+        // Revision payloads are write-once and highly compressible JSON,
+        // so they are stored zstd-compressed (runtime query: the compressed
+        // columns are bytea, added by the compress_revision_payloads
+        // migration)
+        let content_zstd = compression::compress(&serde_json::to_vec(&doc.content)?)?;
+        let patch_zstd = patch
+            .map(|p| serde_json::to_vec(p))
+            .transpose()?
+            .map(|bytes| compression::compress(&bytes))
+            .transpose()?;
+
+        sqlx::query(
             r#"
             INSERT INTO document_revisions (
-                document_id, content, patch, sync_revision, created_by
+                document_id, content_zstd, patch_zstd, sync_revision, created_by
             ) VALUES ($1, $2, $3, $4, $5)
         "#,
-            doc.id,
-            content_json as _,
-            patch_json as _,
-            doc.sync_revision,
-            doc.user_id
         )
+        .bind(doc.id)
+        .bind(content_zstd)
+        .bind(patch_zstd)
+        .bind(doc.sync_revision)
+        .bind(doc.user_id)
         .execute(&self.pool)
         .await?;
 
         Ok(())
     }
 
+    /// Fetch a document's revision history, newest first
+    ///
+    /// Transparently decompresses zstd-stored payloads and falls back to
+    /// the legacy JSONB columns for rows written before compression.
+    pub async fn get_document_revisions(
+        &self,
+        document_id: &Uuid,
+        limit: i64,
+    ) -> SyncResult<Vec<DocumentRevision>> {
+        use sqlx::Row;
+
+        let rows = sqlx::query(
+            r#"
+            SELECT content, patch, content_zstd, patch_zstd, sync_revision, created_at
+            FROM document_revisions
+            WHERE document_id = $1
+            ORDER BY sync_revision DESC
+            LIMIT $2
+        "#,
+        )
+        .bind(document_id)
+        .bind(limit)
+        .fetch_all(&self.pool)
+        .await?;
+
+        let mut revisions = Vec::with_capacity(rows.len());
+        for row in rows {
+            let content = match row.try_get::<Option<Vec<u8>>, _>("content_zstd")? {
+                Some(bytes) => serde_json::from_slice(&compression::decompress(&bytes)?)?,
+                None => row
+                    .try_get::<Option<serde_json::Value>, _>("content")?
+                    .unwrap_or(serde_json::Value::Null),
+            };
+            let patch = match row.try_get::<Option<Vec<u8>>, _>("patch_zstd")? {
+                Some(bytes) => Some(serde_json::from_slice(&compression::decompress(&bytes)?)?),
+                None => row
+                    .try_get::<Option<serde_json::Value>, _>("patch")?
+                    .map(serde_json::from_value)
+                    .transpose()?,
+            };
+
+            revisions.push(DocumentRevision {
+                content,
+                patch,
+                sync_revision: row.try_get("sync_revision")?,
+                created_at: row.try_get("created_at")?,
+            });
+        }
+
+        Ok(revisions)
+    }
+
     pub async fn add_active_connection(
         &self,
         user_id: &Uuid,
@@ -403,18 +511,19 @@ impl ServerDatabase {
         params: ChangeEventParams<'_>,
     ) -> SyncResult<()> {
         let event_type_str = params.event_type.to_string();
-        sqlx::query!(
+        sqlx::query(
             r#"
-            INSERT INTO change_events (user_id, document_id, event_type, forward_patch, reverse_patch, applied)
-            VALUES ($1, $2, $3, $4, $5, $6)
+            INSERT INTO change_events (user_id, document_id, event_type, forward_patch, reverse_patch, applied, origin_client_id)
+            VALUES ($1, $2, $3, $4, $5, $6, $7)
             "#,
-            params.user_id,
-            params.document_id,
-            event_type_str,
-            params.forward_patch as _,
-            params.reverse_patch as _,
-            params.applied
         )
+        .bind(params.user_id)
+        .bind(params.document_id)
+        .bind(event_type_str)
+        .bind(params.forward_patch)
+        .bind(params.reverse_patch)
+        .bind(params.applied)
+        .bind(params.origin_client_id)
         .execute(&mut **tx)
         .await?;
 
@@ -428,40 +537,44 @@ impl ServerDatabase {
         last_sequence: u64,
         limit: Option<u32>,
     ) -> SyncResult<Vec<ChangeEvent>> {
+        use sqlx::Row;
+
         let limit = limit.unwrap_or(100).min(1000); // Cap at 1000 for safety
         let last_seq_i64 = last_sequence as i64;
         let limit_i64 = limit as i64;
 
-        let rows = sqlx::query!(
+        let rows = sqlx::query(
             r#"
-            SELECT sequence, document_id, user_id, event_type, forward_patch, reverse_patch, created_at
+            SELECT sequence, document_id, user_id, event_type, forward_patch, reverse_patch, origin_client_id, created_at
             FROM change_events
             WHERE user_id = $1 AND sequence > $2
             ORDER BY sequence ASC
             LIMIT $3
             "#,
-            user_id,
-            last_seq_i64,
-            limit_i64
         )
+        .bind(user_id)
+        .bind(last_seq_i64)
+        .bind(limit_i64)
         .fetch_all(&self.pool)
         .await?;
 
         let mut events = Vec::new();
         for row in rows {
-            let event_type = match row.event_type.parse::<ChangeEventType>() {
+            let event_type_str: String = row.try_get("event_type")?;
+            let event_type = match event_type_str.parse::<ChangeEventType>() {
                 Ok(et) => et,
                 Err(_) => continue, // Skip unknown event types
             };
 
             events.push(ChangeEvent {
-                sequence: row.sequence as u64,
-                document_id: row.document_id,
-                user_id: row.user_id,
+                sequence: row.try_get::<i64, _>("sequence")? as u64,
+                document_id: row.try_get("document_id")?,
+                user_id: row.try_get("user_id")?,
                 event_type,
-                forward_patch: row.forward_patch,
-                reverse_patch: row.reverse_patch,
-                created_at: row.created_at,
+                forward_patch: row.try_get("forward_patch")?,
+                reverse_patch: row.try_get("reverse_patch")?,
+                origin_client_id: row.try_get("origin_client_id")?,
+                created_at: row.try_get("created_at")?,
             });
         }
 
@@ -483,36 +596,112 @@ impl ServerDatabase {
 
         Ok(latest_sequence as u64)
     }
+
+    /// A user's compaction horizon: the highest sequence whose events have
+    /// been pruned from the change log (0 when never compacted)
+    pub async fn get_checkpoint_sequence(&self, user_id: &Uuid) -> SyncResult<u64> {
+        use sqlx::Row;
+
+        let row = sqlx::query(
+            "SELECT checkpoint_sequence FROM change_checkpoints WHERE user_id = $1",
+        )
+        .bind(user_id)
+        .fetch_optional(&self.pool)
+        .await?;
+
+        Ok(row
+            .map(|r| r.try_get::<i64, _>("checkpoint_sequence"))
+            .transpose()?
+            .unwrap_or(0) as u64)
+    }
+
+    /// Compact the change-event log: advance each user's checkpoint past
+    /// every event older than `cutoff`, then prune those events
+    ///
+    /// Clients whose cursor falls below the checkpoint get a document
+    /// snapshot instead of a replay (see `GetChangesSince` handling), so
+    /// pruning never loses data - the documents table is always current.
+    /// Returns the number of events removed.
+    pub async fn compact_change_log(
+        &self,
+        cutoff: chrono::DateTime<chrono::Utc>,
+    ) -> SyncResult<u64> {
+        let mut tx = self.pool.begin().await?;
+
+        // Record the horizon before deleting anything so a crash between
+        // the two statements can only leave extra events, never a gap
+        sqlx::query(
+            r#"
+            INSERT INTO change_checkpoints (user_id, checkpoint_sequence, created_at)
+            SELECT user_id, MAX(sequence), NOW()
+            FROM change_events
+            WHERE created_at < $1
+            GROUP BY user_id
+            ON CONFLICT (user_id) DO UPDATE
+            SET checkpoint_sequence = GREATEST(
+                    change_checkpoints.checkpoint_sequence,
+                    EXCLUDED.checkpoint_sequence
+                ),
+                created_at = NOW()
+        "#,
+        )
+        .bind(cutoff)
+        .execute(&mut *tx)
+        .await?;
+
+        let pruned = sqlx::query("DELETE FROM change_events WHERE created_at < $1")
+            .bind(cutoff)
+            .execute(&mut *tx)
+            .await?
+            .rows_affected();
+
+        tx.commit().await?;
+
+        if pruned > 0 {
+            tracing::info!(
+                "Compacted change log: pruned {} events older than {}",
+                pruned,
+                cutoff
+            );
+        }
+
+        Ok(pruned)
+    }
+
     // Get unapplied changes for a document (conflict losers)
     pub async fn get_unapplied_changes(&self, document_id: &Uuid) -> SyncResult<Vec<ChangeEvent>> {
-        let rows = sqlx::query!(
+        use sqlx::Row;
+
+        let rows = sqlx::query(
             r#"
             SELECT sequence, document_id, user_id, event_type,
-                   forward_patch, reverse_patch, created_at
+                   forward_patch, reverse_patch, origin_client_id, created_at
             FROM change_events
             WHERE document_id = $1 AND applied = false
             ORDER BY sequence DESC
             "#,
-            document_id
         )
+        .bind(document_id)
         .fetch_all(&self.pool)
         .await?;
 
         let mut events = Vec::new();
         for row in rows {
-            let event_type = match row.event_type.parse::<ChangeEventType>() {
+            let event_type_str: String = row.try_get("event_type")?;
+            let event_type = match event_type_str.parse::<ChangeEventType>() {
                 Ok(et) => et,
                 Err(_) => continue,
             };
 
             events.push(ChangeEvent {
-                sequence: row.sequence as u64,
-                document_id: row.document_id,
-                user_id: row.user_id,
+                sequence: row.try_get::<i64, _>("sequence")? as u64,
+                document_id: row.try_get("document_id")?,
+                user_id: row.try_get("user_id")?,
                 event_type,
-                forward_patch: row.forward_patch,
-                reverse_patch: row.reverse_patch,
-                created_at: row.created_at,
+                forward_patch: row.try_get("forward_patch")?,
+                reverse_patch: row.try_get("reverse_patch")?,
+                origin_client_id: row.try_get("origin_client_id")?,
+                created_at: row.try_get("created_at")?,
             });
         }
 
@@ -0,0 +1,141 @@
+//! Grouped-commit pipeline for document updates
+//!
+//! Under write bursts (many clients reconnecting and flushing offline
+//! queues) per-update transactions are fsync-bound: every update pays a
+//! full WAL flush. The writer task here accumulates independent updates
+//! across connections for a few milliseconds and commits them in one
+//! transaction, so a burst of N updates costs one fsync instead of N.
+//! Each caller is acknowledged after the group commit, trading a small
+//! bounded latency for several-fold throughput.
+
+use crate::database::ServerDatabase;
+use json_patch::Patch;
+use replicant_core::models::Document;
+use replicant_core::{errors::ServerError, SyncResult};
+use std::sync::Arc;
+use tokio::sync::{mpsc, oneshot};
+use uuid::Uuid;
+
+/// How long the writer waits for more updates to join a group
+const GROUP_WINDOW: std::time::Duration = std::time::Duration::from_millis(5);
+
+/// Upper bound on updates per group so one transaction stays short
+const MAX_GROUP_SIZE: usize = 64;
+
+/// Depth of the submission queue across all connections
+const QUEUE_DEPTH: usize = 1024;
+
+struct WriteJob {
+    doc: Document,
+    patch: Option<Patch>,
+    origin_client_id: Option<Uuid>,
+    reply: oneshot::Sender<SyncResult<()>>,
+}
+
+/// Handle for submitting document updates to the grouped-commit writer
+#[derive(Clone)]
+pub struct GroupCommitWriter {
+    tx: mpsc::Sender<WriteJob>,
+}
+
+impl GroupCommitWriter {
+    /// Spawn the writer task and return a handle shared by all connections
+    pub fn spawn(db: Arc<ServerDatabase>) -> Self {
+        let (tx, rx) = mpsc::channel(QUEUE_DEPTH);
+        tokio::spawn(run_writer(db, rx));
+        Self { tx }
+    }
+
+    /// Submit one update and wait for its group to commit
+    ///
+    /// Returns the same results as `ServerDatabase::update_document`,
+    /// including `VersionMismatch` for optimistic-lock conflicts.
+    pub async fn submit(
+        &self,
+        doc: Document,
+        patch: Option<Patch>,
+        origin_client_id: Option<Uuid>,
+    ) -> SyncResult<()> {
+        let (reply_tx, reply_rx) = oneshot::channel();
+        self.tx
+            .send(WriteJob {
+                doc,
+                patch,
+                origin_client_id,
+                reply: reply_tx,
+            })
+            .await
+            .map_err(|_| ServerError::ServerSync("Write pipeline is shut down".to_string()))?;
+        reply_rx
+            .await
+            .map_err(|_| ServerError::ServerSync("Write pipeline dropped the job".to_string()))?
+    }
+}
+
+async fn run_writer(db: Arc<ServerDatabase>, mut rx: mpsc::Receiver<WriteJob>) {
+    while let Some(first) = rx.recv().await {
+        let mut jobs = vec![first];
+
+        // Let concurrent updates pile into the same group for a short
+        // window; an idle queue commits the lone job after the window
+        let deadline = tokio::time::Instant::now() + GROUP_WINDOW;
+        while jobs.len() < MAX_GROUP_SIZE {
+            match tokio::time::timeout_at(deadline, rx.recv()).await {
+                Ok(Some(job)) => jobs.push(job),
+                Ok(None) | Err(_) => break,
+            }
+        }
+
+        commit_group(&db, jobs).await;
+    }
+    tracing::warn!("Grouped-commit writer task terminated");
+}
+
+async fn commit_group(db: &Arc<ServerDatabase>, jobs: Vec<WriteJob>) {
+    // A single-job group gains nothing from the batch path
+    if jobs.len() == 1 {
+        let job = jobs.into_iter().next().unwrap();
+        let result = db
+            .update_document_with_origin(&job.doc, job.patch.as_ref(), job.origin_client_id)
+            .await;
+        let _ = job.reply.send(result);
+        return;
+    }
+
+    let group_size = jobs.len();
+    match try_commit_batch(db, &jobs).await {
+        Ok(()) => {
+            tracing::debug!("Group-committed {} updates in one transaction", group_size);
+            for job in jobs {
+                let _ = job.reply.send(Ok(()));
+            }
+        }
+        Err(e) => {
+            // Postgres aborts the whole transaction on the first failed
+            // statement, so fall back to per-job transactions: each job
+            // gets its own result and one conflicting update (e.g. a
+            // version mismatch) can't nack the rest of the group
+            tracing::debug!(
+                "Group commit of {} updates failed ({}), retrying individually",
+                group_size,
+                e
+            );
+            for job in jobs {
+                let result = db
+                    .update_document_with_origin(&job.doc, job.patch.as_ref(), job.origin_client_id)
+                    .await;
+                let _ = job.reply.send(result);
+            }
+        }
+    }
+}
+
+async fn try_commit_batch(db: &Arc<ServerDatabase>, jobs: &[WriteJob]) -> SyncResult<()> {
+    let mut tx = db.pool.begin().await?;
+    for job in jobs {
+        db.update_document_in_tx(&mut tx, &job.doc, job.patch.as_ref(), job.origin_client_id)
+            .await?;
+    }
+    tx.commit().await?;
+    Ok(())
+}
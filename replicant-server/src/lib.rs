@@ -1,30 +1,192 @@
 pub mod api;
 pub mod auth;
+pub mod bus;
 pub mod database;
+pub mod group_commit;
+pub mod metrics;
 pub mod monitoring;
 pub mod queries;
 pub mod sync_handler;
 pub mod websocket;
 
 use dashmap::DashMap;
-use replicant_core::protocol::ServerMessage;
+use replicant_core::protocol::{encode_message, ServerMessage, WireEncoding, WireFrame};
+use replicant_core::{errors::ServerError, SyncResult};
 use std::collections::HashSet;
 use std::sync::Arc;
 use uuid::Uuid;
 
+/// A message bound for one connection's socket
+///
+/// Direct replies carry the message itself and are encoded by the
+/// connection's sender task; broadcasts carry a frame that was
+/// serialized once and is shared by every subscriber.
+#[derive(Debug)]
+pub enum Outbound {
+    Message(ServerMessage),
+    Frame(BroadcastFrame),
+}
+
+/// A pre-serialized broadcast payload, encoded once per fan-out
+///
+/// Both encodings are kept so each connection can pick the one it
+/// negotiated; cloning shares the buffers instead of re-serializing.
+#[derive(Debug, Clone)]
+pub struct BroadcastFrame {
+    pub json: Arc<String>,
+    pub msgpack: Arc<Vec<u8>>,
+}
+
+impl BroadcastFrame {
+    pub fn encode(message: &ServerMessage) -> SyncResult<Self> {
+        let json = match encode_message(message, WireEncoding::Json)? {
+            WireFrame::Text(text) => text,
+            WireFrame::Binary(_) => unreachable!("JSON encoding always yields a text frame"),
+        };
+        let msgpack = match encode_message(message, WireEncoding::MessagePack)? {
+            WireFrame::Binary(bytes) => bytes,
+            WireFrame::Text(_) => unreachable!("MessagePack encoding always yields a binary frame"),
+        };
+
+        Ok(Self {
+            json: Arc::new(json),
+            msgpack: Arc::new(msgpack),
+        })
+    }
+}
+
+/// Ergonomic sends of plain messages over an `Outbound` channel
+#[allow(async_fn_in_trait)]
+pub trait OutboundSender {
+    async fn send_msg(&self, message: ServerMessage) -> SyncResult<()>;
+}
+
+impl OutboundSender for tokio::sync::mpsc::Sender<Outbound> {
+    async fn send_msg(&self, message: ServerMessage) -> SyncResult<()> {
+        self.send(Outbound::Message(message))
+            .await
+            .map_err(|e| ServerError::ServerSync(format!("Channel send failed: {}", e)).into())
+    }
+}
+
 // Registry of connected clients: (user_id, client_id) -> channel
-pub type ClientRegistry = Arc<DashMap<(Uuid, Uuid), tokio::sync::mpsc::Sender<ServerMessage>>>;
+pub type ClientRegistry = Arc<DashMap<(Uuid, Uuid), tokio::sync::mpsc::Sender<Outbound>>>;
 
 // Auxiliary mapping to track which clients belong to which user
 pub type UserClients = Arc<DashMap<Uuid, HashSet<Uuid>>>;
 
+// Resumable sessions: the token issued in AuthSuccess -> session state.
+// Entries outlive the connection so flaky clients can skip re-auth.
+pub type SessionRegistry = Arc<DashMap<Uuid, SessionEntry>>;
+
+/// How long a session token stays resumable after it was issued
+pub const SESSION_TTL: std::time::Duration = std::time::Duration::from_secs(24 * 60 * 60);
+
+pub struct SessionEntry {
+    pub user_id: Uuid,
+    pub client_id: Uuid,
+    /// Highest change-event sequence the client has acknowledged
+    pub last_acked_sequence: u64,
+    pub issued_at: std::time::Instant,
+}
+
 #[derive(Clone)]
 pub struct AppState {
     pub db: Arc<database::ServerDatabase>,
     pub auth: auth::AuthState,
     pub monitoring: Option<monitoring::MonitoringLayer>,
+    /// Always-on counters and histograms, exported at `/metrics`
+    pub metrics: Arc<metrics::ServerMetrics>,
     pub clients: ClientRegistry,
     pub user_clients: UserClients,
+    pub sessions: SessionRegistry,
+    /// Identity of this server process on the inter-node change-stream bus
+    pub node_id: Uuid,
+    /// Grouped-commit pipeline shared by all connections' document updates
+    pub write_group: group_commit::GroupCommitWriter,
+}
+
+/// Deliver a pre-serialized broadcast frame to every local socket of a user
+///
+/// Used both by the sync handler (for broadcasts originating on this node)
+/// and by the change-stream bus listener (for broadcasts from other nodes).
+/// Sends with `try_send` so one slow consumer's full queue can't stall the
+/// fan-out; dead channels are pruned from the registries. Returns the
+/// number of successful sends.
+pub async fn broadcast_frame_to_user(
+    state: &AppState,
+    user_id: Uuid,
+    exclude_client_id: Option<Uuid>,
+    frame: &BroadcastFrame,
+) -> usize {
+    let mut successful_sends = 0;
+
+    if let Some(client_ids) = state.user_clients.get(&user_id) {
+        let mut dead_clients = Vec::new();
+
+        for client_id in client_ids.iter() {
+            if exclude_client_id == Some(*client_id) {
+                continue;
+            }
+
+            if let Some(client_tx) = state.clients.get(&(user_id, *client_id)) {
+                match client_tx.try_send(Outbound::Frame(frame.clone())) {
+                    Ok(()) => {
+                        successful_sends += 1;
+                    }
+                    Err(tokio::sync::mpsc::error::TrySendError::Full(_)) => {
+                        // A dropped frame is recovered by the client's next
+                        // resume or full sync
+                        tracing::warn!(
+                            "Send queue full for client {} of user {}, dropping broadcast",
+                            client_id,
+                            user_id
+                        );
+                    }
+                    Err(tokio::sync::mpsc::error::TrySendError::Closed(_)) => {
+                        dead_clients.push(*client_id);
+                        tracing::warn!(
+                            "Failed to send to client {} for user {}",
+                            client_id,
+                            user_id
+                        );
+                    }
+                }
+            } else {
+                // Client not found in registry - this shouldn't happen
+                dead_clients.push(*client_id);
+                tracing::warn!(
+                    "Client {} not found in registry for user {}",
+                    client_id,
+                    user_id
+                );
+            }
+        }
+
+        state.metrics.broadcast_frames_sent.fetch_add(
+            successful_sends as u64,
+            std::sync::atomic::Ordering::Relaxed,
+        );
+
+        // Remove dead clients
+        if !dead_clients.is_empty() {
+            drop(client_ids); // Release the read lock
+            if let Some(mut client_ids_mut) = state.user_clients.get_mut(&user_id) {
+                for dead_client_id in &dead_clients {
+                    client_ids_mut.remove(dead_client_id);
+                    state.clients.remove(&(user_id, *dead_client_id));
+                }
+
+                // Remove user entry if no clients left
+                if client_ids_mut.is_empty() {
+                    drop(client_ids_mut);
+                    state.user_clients.remove(&user_id);
+                }
+            }
+        }
+    }
+
+    successful_sends
 }
 
 #[cfg(test)]
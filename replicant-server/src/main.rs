@@ -152,22 +152,56 @@ async fn run_server() -> replicant_core::SyncResult<()> {
         return Ok(());
     }
 
-    // Set up monitoring if enabled
+    // Set up the sampled activity display if enabled; aggregate metrics
+    // are always on and exported at /metrics regardless
     let monitoring_layer = if monitoring_enabled {
+        let sample_every: u64 = std::env::var("MONITORING_SAMPLE_EVERY")
+            .ok()
+            .and_then(|v| v.parse().ok())
+            .unwrap_or(100);
         let (tx, rx) = tokio::sync::mpsc::channel(1000);
-        monitoring::spawn_monitoring_display(rx).await;
-        Some(MonitoringLayer::new(tx))
+        monitoring::spawn_monitoring_display(rx, sample_every).await;
+        Some(MonitoringLayer::new(tx, sample_every))
     } else {
         None
     };
 
+    // Grouped-commit writer: all connections' document updates flow
+    // through one task that batches them into shared transactions
+    let write_group = replicant_server::group_commit::GroupCommitWriter::spawn(db.clone());
+
     // Application state
     let app_state = Arc::new(AppState {
         db: db.clone(),
         auth: AuthState::new(db),
         monitoring: monitoring_layer,
+        metrics: Arc::new(replicant_server::metrics::ServerMetrics::new()),
         clients: Arc::new(DashMap::new()),
         user_clients: Arc::new(DashMap::new()),
+        sessions: Arc::new(DashMap::new()),
+        node_id: uuid::Uuid::new_v4(),
+        write_group,
+    });
+
+    // Bridge broadcasts from other server nodes onto this node's sockets
+    replicant_server::bus::spawn_listener(app_state.clone());
+
+    // Background change-log compaction: checkpoint and prune events older
+    // than the retention window so the table stops growing unboundedly
+    let retention_days: i64 = std::env::var("CHANGE_LOG_RETENTION_DAYS")
+        .ok()
+        .and_then(|v| v.parse().ok())
+        .unwrap_or(30);
+    let compaction_db = app_state.db.clone();
+    tokio::spawn(async move {
+        let mut interval = tokio::time::interval(std::time::Duration::from_secs(60 * 60));
+        loop {
+            interval.tick().await;
+            let cutoff = chrono::Utc::now() - chrono::Duration::days(retention_days);
+            if let Err(e) = compaction_db.compact_change_log(cutoff).await {
+                tracing::error!("Change-log compaction failed: {}", e);
+            }
+        }
     });
 
     // Build router
@@ -176,6 +210,8 @@ async fn run_server() -> replicant_core::SyncResult<()> {
         .route("/ws", get(websocket_handler))
         // Health check
         .route("/health", get(|| async { "OK" }))
+        // Prometheus-style metrics export
+        .route("/metrics", get(metrics_handler))
         .route("/test/reset", post(reset_server_state))
         .layer(CorsLayer::permissive())
         .layer(TraceLayer::new_for_http())
@@ -236,6 +272,31 @@ async fn websocket_handler(ws: WebSocketUpgrade, State(state): State<Arc<AppStat
     ws.on_upgrade(move |socket| handle_websocket(socket, state))
 }
 
+/// Export counters and histograms in Prometheus text format
+///
+/// Per-connection send-queue depth is a point-in-time gauge sampled here
+/// from the live client registry rather than accumulated in the registry.
+async fn metrics_handler(State(state): State<Arc<AppState>>) -> String {
+    let mut out = state.metrics.render_prometheus();
+
+    out.push_str(
+        "# HELP replicant_outbound_queue_depth Messages waiting in a connection's send queue\n",
+    );
+    out.push_str("# TYPE replicant_outbound_queue_depth gauge\n");
+    for entry in state.clients.iter() {
+        let (user_id, client_id) = entry.key();
+        let tx = entry.value();
+        out.push_str(&format!(
+            "replicant_outbound_queue_depth{{user_id=\"{}\",client_id=\"{}\"}} {}\n",
+            user_id,
+            client_id,
+            tx.max_capacity() - tx.capacity()
+        ));
+    }
+
+    out
+}
+
 async fn reset_server_state(State(state): State<Arc<AppState>>) -> &'static str {
     // Clear all in-memory state for testing
     tracing::info!("Resetting server state for testing");
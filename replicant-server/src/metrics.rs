@@ -0,0 +1,314 @@
+//! Always-on server metrics registry
+//!
+//! The monitor used to format and forward a `LogMessage` through a
+//! channel for every message received, sent and patch applied - at peak
+//! load the monitor itself became a hot path and had to be disabled,
+//! losing all visibility. This registry replaces that with aggregation
+//! at the source: recording a sample is a few relaxed atomic operations
+//! inline in the hot path, and the accumulated counters and latency
+//! histograms are exported in Prometheus text format from the `/metrics`
+//! endpoint. The per-message display in `crate::monitoring` survives as
+//! an opt-in sampled mode for interactive debugging.
+
+use replicant_core::protocol::{ClientMessage, ServerMessage};
+use std::fmt::Write;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::time::Duration;
+
+/// Message type labels, in the same order as the per-type counter slots
+pub const CLIENT_MESSAGE_TYPES: [&str; 10] = [
+    "authenticate",
+    "resume_session",
+    "create_document",
+    "update_document",
+    "delete_document",
+    "request_sync",
+    "request_full_sync",
+    "get_changes_since",
+    "ack_changes",
+    "ping",
+];
+
+pub fn client_message_type(message: &ClientMessage) -> &'static str {
+    CLIENT_MESSAGE_TYPES[client_message_index(message)]
+}
+
+fn client_message_index(message: &ClientMessage) -> usize {
+    match message {
+        ClientMessage::Authenticate { .. } => 0,
+        ClientMessage::ResumeSession { .. } => 1,
+        ClientMessage::CreateDocument { .. } => 2,
+        ClientMessage::UpdateDocument { .. } => 3,
+        ClientMessage::DeleteDocument { .. } => 4,
+        ClientMessage::RequestSync { .. } => 5,
+        ClientMessage::RequestFullSync => 6,
+        ClientMessage::GetChangesSince { .. } => 7,
+        ClientMessage::AckChanges { .. } => 8,
+        ClientMessage::Ping => 9,
+    }
+}
+
+pub const SERVER_MESSAGE_TYPES: [&str; 17] = [
+    "auth_success",
+    "auth_error",
+    "document_created",
+    "document_updated",
+    "document_deleted",
+    "document_created_response",
+    "document_updated_response",
+    "document_deleted_response",
+    "sync_document",
+    "sync_batch",
+    "sync_complete",
+    "conflict_detected",
+    "changes",
+    "snapshot",
+    "changes_acknowledged",
+    "error",
+    "pong",
+];
+
+pub fn server_message_type(message: &ServerMessage) -> &'static str {
+    SERVER_MESSAGE_TYPES[server_message_index(message)]
+}
+
+fn server_message_index(message: &ServerMessage) -> usize {
+    match message {
+        ServerMessage::AuthSuccess { .. } => 0,
+        ServerMessage::AuthError { .. } => 1,
+        ServerMessage::DocumentCreated { .. } => 2,
+        ServerMessage::DocumentUpdated { .. } => 3,
+        ServerMessage::DocumentDeleted { .. } => 4,
+        ServerMessage::DocumentCreatedResponse { .. } => 5,
+        ServerMessage::DocumentUpdatedResponse { .. } => 6,
+        ServerMessage::DocumentDeletedResponse { .. } => 7,
+        ServerMessage::SyncDocument { .. } => 8,
+        ServerMessage::SyncBatch { .. } => 9,
+        ServerMessage::SyncComplete { .. } => 10,
+        ServerMessage::ConflictDetected { .. } => 11,
+        ServerMessage::Changes { .. } => 12,
+        ServerMessage::Snapshot { .. } => 13,
+        ServerMessage::ChangesAcknowledged { .. } => 14,
+        ServerMessage::Error { .. } => 15,
+        ServerMessage::Pong => 16,
+    }
+}
+
+/// Histogram bucket upper bounds in microseconds (plus an implicit +Inf)
+const BUCKET_BOUNDS_US: [u64; 11] = [
+    100, 250, 500, 1_000, 2_500, 5_000, 10_000, 25_000, 50_000, 100_000, 500_000,
+];
+
+/// Fixed-bucket latency histogram, recordable from any thread
+///
+/// Buckets are exported cumulatively in seconds, matching the Prometheus
+/// `_bucket`/`_sum`/`_count` convention.
+#[derive(Debug, Default)]
+pub struct Histogram {
+    buckets: [AtomicU64; BUCKET_BOUNDS_US.len()],
+    count: AtomicU64,
+    sum_us: AtomicU64,
+}
+
+impl Histogram {
+    pub fn record(&self, elapsed: Duration) {
+        let us = elapsed.as_micros() as u64;
+        self.count.fetch_add(1, Ordering::Relaxed);
+        self.sum_us.fetch_add(us, Ordering::Relaxed);
+        for (i, bound) in BUCKET_BOUNDS_US.iter().enumerate() {
+            if us <= *bound {
+                self.buckets[i].fetch_add(1, Ordering::Relaxed);
+                break;
+            }
+        }
+    }
+
+    pub fn count(&self) -> u64 {
+        self.count.load(Ordering::Relaxed)
+    }
+
+    fn render(&self, name: &str, help: &str, out: &mut String) {
+        let _ = writeln!(out, "# HELP {} {}", name, help);
+        let _ = writeln!(out, "# TYPE {} histogram", name);
+        let mut cumulative = 0;
+        for (i, bound) in BUCKET_BOUNDS_US.iter().enumerate() {
+            cumulative += self.buckets[i].load(Ordering::Relaxed);
+            let _ = writeln!(
+                out,
+                "{}_bucket{{le=\"{}\"}} {}",
+                name,
+                *bound as f64 / 1_000_000.0,
+                cumulative
+            );
+        }
+        let count = self.count.load(Ordering::Relaxed);
+        let _ = writeln!(out, "{}_bucket{{le=\"+Inf\"}} {}", name, count);
+        let _ = writeln!(
+            out,
+            "{}_sum {}",
+            name,
+            self.sum_us.load(Ordering::Relaxed) as f64 / 1_000_000.0
+        );
+        let _ = writeln!(out, "{}_count {}", name, count);
+    }
+}
+
+/// The registry itself. One instance lives in `AppState`; the websocket
+/// loops and the sync handler record into it inline.
+#[derive(Debug, Default)]
+pub struct ServerMetrics {
+    received: [AtomicU64; CLIENT_MESSAGE_TYPES.len()],
+    sent: [AtomicU64; SERVER_MESSAGE_TYPES.len()],
+    /// Pre-serialized broadcast frames delivered to local sockets
+    pub broadcast_frames_sent: AtomicU64,
+    pub patches_applied: AtomicU64,
+    pub conflicts_detected: AtomicU64,
+    pub connections_opened: AtomicU64,
+    pub connections_closed: AtomicU64,
+    /// json-patch application against the in-memory document
+    pub patch_apply: Histogram,
+    /// Encoding a broadcast plus fanning it out to every local subscriber
+    pub broadcast_fanout: Histogram,
+}
+
+impl ServerMetrics {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    pub fn record_received(&self, message: &ClientMessage) {
+        self.received[client_message_index(message)].fetch_add(1, Ordering::Relaxed);
+    }
+
+    pub fn record_sent(&self, message: &ServerMessage) {
+        self.sent[server_message_index(message)].fetch_add(1, Ordering::Relaxed);
+    }
+
+    /// Render every counter and histogram in Prometheus text format.
+    /// Point-in-time gauges (per-connection queue depth) are appended by
+    /// the endpoint handler, which has access to the live registries.
+    pub fn render_prometheus(&self) -> String {
+        let mut out = String::with_capacity(4096);
+
+        let _ = writeln!(
+            out,
+            "# HELP replicant_messages_received_total Client messages received, by type"
+        );
+        let _ = writeln!(out, "# TYPE replicant_messages_received_total counter");
+        for (i, name) in CLIENT_MESSAGE_TYPES.iter().enumerate() {
+            let _ = writeln!(
+                out,
+                "replicant_messages_received_total{{type=\"{}\"}} {}",
+                name,
+                self.received[i].load(Ordering::Relaxed)
+            );
+        }
+
+        let _ = writeln!(
+            out,
+            "# HELP replicant_messages_sent_total Direct server messages sent, by type"
+        );
+        let _ = writeln!(out, "# TYPE replicant_messages_sent_total counter");
+        for (i, name) in SERVER_MESSAGE_TYPES.iter().enumerate() {
+            let _ = writeln!(
+                out,
+                "replicant_messages_sent_total{{type=\"{}\"}} {}",
+                name,
+                self.sent[i].load(Ordering::Relaxed)
+            );
+        }
+
+        for (name, help, value) in [
+            (
+                "replicant_broadcast_frames_sent_total",
+                "Pre-serialized broadcast frames delivered to local sockets",
+                &self.broadcast_frames_sent,
+            ),
+            (
+                "replicant_patches_applied_total",
+                "Document patches applied",
+                &self.patches_applied,
+            ),
+            (
+                "replicant_conflicts_detected_total",
+                "Version conflicts detected on update",
+                &self.conflicts_detected,
+            ),
+            (
+                "replicant_connections_opened_total",
+                "WebSocket connections opened",
+                &self.connections_opened,
+            ),
+            (
+                "replicant_connections_closed_total",
+                "WebSocket connections closed",
+                &self.connections_closed,
+            ),
+        ] {
+            let _ = writeln!(out, "# HELP {} {}", name, help);
+            let _ = writeln!(out, "# TYPE {} counter", name);
+            let _ = writeln!(out, "{} {}", name, value.load(Ordering::Relaxed));
+        }
+
+        self.patch_apply.render(
+            "replicant_patch_apply_seconds",
+            "Time to apply a patch to the in-memory document",
+            &mut out,
+        );
+        self.broadcast_fanout.render(
+            "replicant_broadcast_fanout_seconds",
+            "Time to encode a broadcast and fan it out to local subscribers",
+            &mut out,
+        );
+
+        out
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_histogram_buckets_are_cumulative() {
+        let histogram = Histogram::default();
+        histogram.record(Duration::from_micros(50));
+        histogram.record(Duration::from_micros(800));
+        histogram.record(Duration::from_secs(2)); // beyond the last bound
+
+        let mut out = String::new();
+        histogram.render("test_seconds", "help", &mut out);
+
+        assert!(out.contains("test_seconds_bucket{le=\"0.0001\"} 1"));
+        assert!(out.contains("test_seconds_bucket{le=\"0.001\"} 2"));
+        assert!(out.contains("test_seconds_bucket{le=\"0.5\"} 2"));
+        assert!(out.contains("test_seconds_bucket{le=\"+Inf\"} 3"));
+        assert!(out.contains("test_seconds_count 3"));
+    }
+
+    #[test]
+    fn test_message_counters_label_by_type() {
+        let metrics = ServerMetrics::new();
+        metrics.record_received(&ClientMessage::Ping);
+        metrics.record_received(&ClientMessage::Ping);
+        metrics.record_sent(&ServerMessage::Pong);
+
+        let out = metrics.render_prometheus();
+        assert!(out.contains("replicant_messages_received_total{type=\"ping\"} 2"));
+        assert!(out.contains("replicant_messages_sent_total{type=\"pong\"} 1"));
+        assert!(out.contains("replicant_messages_received_total{type=\"update_document\"} 0"));
+    }
+
+    #[test]
+    fn test_type_names_cover_every_variant() {
+        // The index functions and name tables must stay in sync
+        assert_eq!(
+            client_message_type(&ClientMessage::RequestFullSync),
+            "request_full_sync"
+        );
+        assert_eq!(
+            server_message_type(&ServerMessage::Pong),
+            SERVER_MESSAGE_TYPES[SERVER_MESSAGE_TYPES.len() - 1]
+        );
+    }
+}
@@ -1,6 +1,21 @@
+//! Opt-in sampled activity display
+//!
+//! Formats a human-readable activity log for interactive debugging. This
+//! used to forward (and pretty-print) every message received, sent and
+//! patch applied, which made the monitor itself a hot path at load;
+//! aggregate visibility now comes from the always-on registry in
+//! `crate::metrics`, and this display only sees every Nth high-volume
+//! event (`MONITORING_SAMPLE_EVERY`). Sampling is decided with one atomic
+//! increment before anything is cloned or serialized, and events are
+//! forwarded with `try_send` so a slow display can never backpressure the
+//! message loops. Connection, conflict and error events are rare and
+//! always shown.
+
 use chrono::Local;
 use colored::*;
 use replicant_core::protocol::{ClientMessage, ServerMessage};
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::Arc;
 use tokio::sync::mpsc;
 use tracing::info;
 
@@ -14,11 +29,11 @@ pub enum LogMessage {
     },
     MessageReceived {
         client_id: String,
-        message: ClientMessage,
+        message_type: &'static str,
     },
     MessageSent {
         client_id: String,
-        message: ServerMessage,
+        message_type: &'static str,
     },
     PatchApplied {
         document_id: String,
@@ -35,80 +50,97 @@ pub enum LogMessage {
 #[derive(Clone)]
 pub struct MonitoringLayer {
     tx: mpsc::Sender<LogMessage>,
+    /// Show every Nth high-volume event (messages, patches); 1 shows all
+    sample_every: u64,
+    /// Shared across connection clones so sampling is global, not per-socket
+    sampled: Arc<AtomicU64>,
 }
 
 impl MonitoringLayer {
-    pub fn new(tx: mpsc::Sender<LogMessage>) -> Self {
-        Self { tx }
+    pub fn new(tx: mpsc::Sender<LogMessage>, sample_every: u64) -> Self {
+        Self {
+            tx,
+            sample_every: sample_every.max(1),
+            sampled: Arc::new(AtomicU64::new(0)),
+        }
+    }
+
+    /// One atomic increment; true for every Nth high-volume event
+    fn should_sample(&self) -> bool {
+        self.sampled.fetch_add(1, Ordering::Relaxed) % self.sample_every == 0
+    }
+
+    fn forward(&self, log: LogMessage) {
+        // A full display queue drops the event rather than stalling the
+        // caller - this is a debugging aid, not a durable log
+        let _ = self.tx.try_send(log);
     }
 
-    pub async fn log_client_connected(&self, client_id: &str) {
-        let _ = self
-            .tx
-            .send(LogMessage::ClientConnected {
-                client_id: client_id.to_string(),
-            })
-            .await;
+    pub fn log_client_connected(&self, client_id: &str) {
+        self.forward(LogMessage::ClientConnected {
+            client_id: client_id.to_string(),
+        });
     }
 
-    pub async fn log_client_disconnected(&self, client_id: &str) {
-        let _ = self
-            .tx
-            .send(LogMessage::ClientDisconnected {
-                client_id: client_id.to_string(),
-            })
-            .await;
+    pub fn log_client_disconnected(&self, client_id: &str) {
+        self.forward(LogMessage::ClientDisconnected {
+            client_id: client_id.to_string(),
+        });
     }
 
-    pub async fn log_message_received(&self, client_id: &str, message: ClientMessage) {
-        let _ = self
-            .tx
-            .send(LogMessage::MessageReceived {
-                client_id: client_id.to_string(),
-                message,
-            })
-            .await;
+    pub fn log_message_received(&self, client_id: &str, message: &ClientMessage) {
+        if !self.should_sample() {
+            return;
+        }
+        self.forward(LogMessage::MessageReceived {
+            client_id: client_id.to_string(),
+            message_type: crate::metrics::client_message_type(message),
+        });
     }
 
-    pub async fn log_message_sent(&self, client_id: &str, message: ServerMessage) {
-        let _ = self
-            .tx
-            .send(LogMessage::MessageSent {
-                client_id: client_id.to_string(),
-                message,
-            })
-            .await;
+    pub fn log_message_sent(&self, client_id: &str, message: &ServerMessage) {
+        if !self.should_sample() {
+            return;
+        }
+        self.forward(LogMessage::MessageSent {
+            client_id: client_id.to_string(),
+            message_type: crate::metrics::server_message_type(message),
+        });
     }
 
-    pub async fn log_patch_applied(&self, document_id: &str, patch: &serde_json::Value) {
+    pub fn log_patch_applied(&self, document_id: &str, patch: &impl serde::Serialize) {
+        if !self.should_sample() {
+            return;
+        }
+        // Pretty-printing happens only for the sampled fraction
         let patch_json = serde_json::to_string_pretty(patch).unwrap_or_default();
-        let _ = self
-            .tx
-            .send(LogMessage::PatchApplied {
-                document_id: document_id.to_string(),
-                patch: patch_json,
-            })
-            .await;
+        self.forward(LogMessage::PatchApplied {
+            document_id: document_id.to_string(),
+            patch: patch_json,
+        });
     }
 
-    pub async fn log_conflict_detected(&self, document_id: &str) {
-        let _ = self
-            .tx
-            .send(LogMessage::ConflictDetected {
-                document_id: document_id.to_string(),
-            })
-            .await;
+    pub fn log_conflict_detected(&self, document_id: &str) {
+        self.forward(LogMessage::ConflictDetected {
+            document_id: document_id.to_string(),
+        });
     }
 
-    pub async fn log_error(&self, message: String) {
-        let _ = self.tx.send(LogMessage::Error { message }).await;
+    pub fn log_error(&self, message: String) {
+        self.forward(LogMessage::Error { message });
     }
 }
 
-pub async fn spawn_monitoring_display(mut rx: mpsc::Receiver<LogMessage>) {
+pub async fn spawn_monitoring_display(mut rx: mpsc::Receiver<LogMessage>, sample_every: u64) {
     tokio::spawn(async move {
         info!("");
         info!("{}", "📋 Activity Log:".bold());
+        if sample_every > 1 {
+            info!(
+                "{}",
+                format!("   (showing every {}th message)", sample_every).dimmed()
+            );
+        }
         info!("{}", "─".repeat(80).dimmed());
 
         while let Some(log) = rx.recv().await {
@@ -131,49 +163,27 @@ pub async fn spawn_monitoring_display(mut rx: mpsc::Receiver<LogMessage>) {
                         client_id.yellow()
                     );
                 }
-                LogMessage::MessageReceived { client_id, message } => {
-                    let msg_type = match message {
-                        ClientMessage::Authenticate { .. } => "Authenticate",
-                        ClientMessage::CreateDocument { .. } => "CreateDocument",
-                        ClientMessage::UpdateDocument { .. } => "UpdateDocument",
-                        ClientMessage::DeleteDocument { .. } => "DeleteDocument",
-                        ClientMessage::RequestSync { .. } => "RequestSync",
-                        ClientMessage::RequestFullSync => "RequestFullSync",
-                        ClientMessage::Ping => "Ping",
-                        ClientMessage::GetChangesSince { .. } => "GetChangesSince",
-                        ClientMessage::AckChanges { .. } => "AckChanges",
-                    };
+                LogMessage::MessageReceived {
+                    client_id,
+                    message_type,
+                } => {
                     info!(
                         "{} {} {} from {}",
                         timestamp.to_string().dimmed(),
                         "↓".blue(),
-                        msg_type.white().bold(),
+                        message_type.white().bold(),
                         client_id.yellow()
                     );
                 }
-                LogMessage::MessageSent { client_id, message } => {
-                    let msg_type = match message {
-                        ServerMessage::AuthSuccess { .. } => "AuthSuccess",
-                        ServerMessage::AuthError { .. } => "AuthError",
-                        ServerMessage::DocumentCreated { .. } => "DocumentCreated",
-                        ServerMessage::DocumentUpdated { .. } => "DocumentUpdated",
-                        ServerMessage::DocumentDeleted { .. } => "DocumentDeleted",
-                        ServerMessage::DocumentCreatedResponse { .. } => "DocumentCreatedResponse",
-                        ServerMessage::DocumentUpdatedResponse { .. } => "DocumentUpdatedResponse",
-                        ServerMessage::DocumentDeletedResponse { .. } => "DocumentDeletedResponse",
-                        ServerMessage::SyncDocument { .. } => "SyncDocument",
-                        ServerMessage::SyncComplete { .. } => "SyncComplete",
-                        ServerMessage::ConflictDetected { .. } => "ConflictDetected",
-                        ServerMessage::Error { .. } => "Error",
-                        ServerMessage::Pong => "Pong",
-                        ServerMessage::Changes { .. } => "Changes",
-                        ServerMessage::ChangesAcknowledged { .. } => "ChangesAcknowledged",
-                    };
+                LogMessage::MessageSent {
+                    client_id,
+                    message_type,
+                } => {
                     info!(
                         "{} {} {} to {}",
                         timestamp.to_string().dimmed(),
                         "↑".green(),
-                        msg_type.white().bold(),
+                        message_type.white().bold(),
                         client_id.yellow()
                     );
                 }
@@ -206,3 +216,41 @@ pub async fn spawn_monitoring_display(mut rx: mpsc::Receiver<LogMessage>) {
         }
     });
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_high_volume_events_are_sampled() {
+        let (tx, mut rx) = mpsc::channel(100);
+        let layer = MonitoringLayer::new(tx, 10);
+
+        for _ in 0..25 {
+            layer.log_message_received("client", &ClientMessage::Ping);
+        }
+
+        // Events 1, 11 and 21 pass the sampler
+        let mut forwarded = 0;
+        while rx.try_recv().is_ok() {
+            forwarded += 1;
+        }
+        assert_eq!(forwarded, 3);
+    }
+
+    #[test]
+    fn test_rare_events_are_never_sampled() {
+        let (tx, mut rx) = mpsc::channel(100);
+        let layer = MonitoringLayer::new(tx, 1000);
+
+        layer.log_client_connected("a");
+        layer.log_conflict_detected("doc");
+        layer.log_error("boom".to_string());
+
+        let mut forwarded = 0;
+        while rx.try_recv().is_ok() {
+            forwarded += 1;
+        }
+        assert_eq!(forwarded, 3);
+    }
+}
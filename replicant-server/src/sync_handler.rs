@@ -1,5 +1,9 @@
-use crate::{database::ServerDatabase, monitoring::MonitoringLayer, AppState};
+use crate::{
+    database::ServerDatabase, monitoring::MonitoringLayer, AppState, BroadcastFrame, Outbound,
+    OutboundSender,
+};
 use replicant_core::{
+    checksums::{update_checksum, verify_checksum},
     errors::ServerError,
     patches::{apply_patch, calculate_checksum},
     protocol::{ClientMessage, ErrorCode, ServerMessage},
@@ -23,9 +27,10 @@ fn is_duplicate_key_error(e: &SyncError) -> bool {
 
 pub struct SyncHandler {
     db: Arc<ServerDatabase>,
-    tx: mpsc::Sender<ServerMessage>,
+    tx: mpsc::Sender<Outbound>,
     user_id: Option<Uuid>,
     client_id: Option<Uuid>,
+    session_id: Option<Uuid>,
     monitoring: Option<MonitoringLayer>,
     app_state: Arc<AppState>,
 }
@@ -33,7 +38,7 @@ pub struct SyncHandler {
 impl SyncHandler {
     pub fn new(
         db: Arc<ServerDatabase>,
-        tx: mpsc::Sender<ServerMessage>,
+        tx: mpsc::Sender<Outbound>,
         monitoring: Option<MonitoringLayer>,
         app_state: Arc<AppState>,
     ) -> Self {
@@ -42,6 +47,7 @@ impl SyncHandler {
             tx,
             user_id: None,
             client_id: None,
+            session_id: None,
             monitoring,
             app_state,
         }
@@ -55,6 +61,10 @@ impl SyncHandler {
         self.client_id = Some(client_id);
     }
 
+    pub fn set_session_id(&mut self, session_id: Uuid) {
+        self.session_id = Some(session_id);
+    }
+
     pub async fn handle_message(&mut self, msg: ClientMessage) -> SyncResult<()> {
         let user_id = self.user_id.ok_or(ServerError::ServerSync(
             "Unauthorized: user_id not found".to_string(),
@@ -101,13 +111,13 @@ impl SyncHandler {
 
                 // CRITICAL: Verify content hash for data integrity
                 // This must happen BEFORE any data is written to prevent corruption
+                // (the algorithm is detected from the hash itself, so SHA-256
+                // and xxHash3 clients are both accepted)
                 if let Some(ref hash) = document.content_hash {
-                    let calculated_hash = calculate_checksum(&document.content);
-                    if calculated_hash != *hash {
+                    if !verify_checksum(&document.content, hash) {
                         tracing::warn!(
-                            "Content hash mismatch for document {}: expected {}, got {}",
+                            "Content hash mismatch for document {}: claimed {}",
                             document.id,
-                            calculated_hash,
                             hash
                         );
                         self.send_error(
@@ -163,6 +173,9 @@ impl SyncHandler {
                                             forward_patch: Some(&server_content_json),
                                             reverse_patch: None,
                                             applied: false,
+                                            // The losing version is the
+                                            // server's, not any one client's
+                                            origin_client_id: None,
                                         },
                                     )
                                     .await
@@ -175,7 +188,7 @@ impl SyncHandler {
 
                                 // Update document to client version IN SAME TRANSACTION
                                 self.db
-                                    .update_document_in_tx(&mut tx, &document, None)
+                                    .update_document_in_tx(&mut tx, &document, None, self.client_id)
                                     .await
                                     .map_err(|e| format!("Failed to update document: {}", e))?;
 
@@ -196,7 +209,7 @@ impl SyncHandler {
 
                                 // Send confirmation to the sender
                                 self.tx
-                                    .send(ServerMessage::DocumentCreatedResponse {
+                                    .send_msg(ServerMessage::DocumentCreatedResponse {
                                         document_id: document.id,
                                         success: true,
                                         error: None,
@@ -216,7 +229,7 @@ impl SyncHandler {
                             Err(e) => {
                                 tracing::error!("❌ Failed to apply conflict resolution: {}", e);
                                 self.tx
-                                    .send(ServerMessage::DocumentCreatedResponse {
+                                    .send_msg(ServerMessage::DocumentCreatedResponse {
                                         document_id: document.id,
                                         success: false,
                                         error: Some(e),
@@ -229,11 +242,15 @@ impl SyncHandler {
                         // Document doesn't exist - this is a true create operation
                         tracing::info!("📝 Creating new document {} ", document.id);
 
-                        match self.db.create_document(&document).await {
+                        match self
+                            .db
+                            .create_document_with_origin(&document, self.client_id)
+                            .await
+                        {
                             Ok(_) => {
                                 // Send confirmation to the sender
                                 self.tx
-                                    .send(ServerMessage::DocumentCreatedResponse {
+                                    .send_msg(ServerMessage::DocumentCreatedResponse {
                                         document_id: document.id,
                                         success: true,
                                         error: None,
@@ -260,7 +277,7 @@ impl SyncHandler {
                                     // Document was created by a concurrent/retry request
                                     // Return success since the document exists (which is what the client wanted)
                                     self.tx
-                                        .send(ServerMessage::DocumentCreatedResponse {
+                                        .send_msg(ServerMessage::DocumentCreatedResponse {
                                             document_id: document.id,
                                             success: true,
                                             error: None,
@@ -277,7 +294,7 @@ impl SyncHandler {
                                 } else {
                                     // Other database error - send error response
                                     self.tx
-                                        .send(ServerMessage::DocumentCreatedResponse {
+                                        .send_msg(ServerMessage::DocumentCreatedResponse {
                                             document_id: document.id,
                                             success: false,
                                             error: Some(e.to_string()),
@@ -323,40 +340,64 @@ impl SyncHandler {
 
                 // CRITICAL: Verify content hash BEFORE applying patch
                 // This prevents corrupted data from being written to database
-                let calculated_hash = calculate_checksum(&doc.content);
-                if calculated_hash != patch.content_hash {
+                if !verify_checksum(&doc.content, &patch.content_hash) {
                     self.send_error(ErrorCode::InvalidPatch, "Content hash mismatch")
                         .await?;
                     return Ok(());
                 }
 
                 // Apply the client's patch
+                let old_content = doc.content.clone();
+                let apply_started = std::time::Instant::now();
                 apply_patch(&mut doc.content, &patch.patch)?;
-
-                // Update metadata (version will be incremented atomically by database)
-                doc.content_hash = Some(calculate_checksum(&doc.content));
+                self.app_state
+                    .metrics
+                    .patch_apply
+                    .record(apply_started.elapsed());
+                self.app_state
+                    .metrics
+                    .patches_applied
+                    .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+
+                // Update metadata (version will be incremented atomically by
+                // database). The hash just verified above covers the old
+                // content, so an xxHash3 client lets us update it from the
+                // patch instead of re-hashing the whole document.
+                doc.content_hash = update_checksum(
+                    &patch.content_hash,
+                    &old_content,
+                    &doc.content,
+                    &patch.patch,
+                )
+                .or_else(|| Some(calculate_checksum(&doc.content)));
                 // Note: updated_at is set by database with NOW()
 
-                // Log patch applied if monitoring is enabled
+                // Show in the sampled display if monitoring is enabled;
+                // serialization happens inside, only for sampled events
                 if let Some(ref monitoring) = self.monitoring {
-                    let patch_json = serde_json::to_value(&patch.patch).unwrap_or_default();
-                    monitoring
-                        .log_patch_applied(&doc.id.to_string(), &patch_json)
-                        .await;
+                    monitoring.log_patch_applied(&doc.id.to_string(), &patch.patch);
                 }
 
-                // Save to database with atomic version increment
-                match self.db.update_document(&doc, Some(&patch.patch)).await {
+                // Save to database with atomic version increment; the write
+                // goes through the grouped-commit pipeline so concurrent
+                // updates share one transaction and one WAL flush
+                let doc_id = doc.id;
+                match self
+                    .app_state
+                    .write_group
+                    .submit(doc, Some(patch.patch.clone()), self.client_id)
+                    .await
+                {
                     Ok(_) => {
                         // CRITICAL: Fetch the updated document with incremented version from database
-                        let updated_doc = self.db.get_document(&doc.id).await?;
+                        let updated_doc = self.db.get_document(&doc_id).await?;
 
                         tracing::info!("   Content after update: {:?}", updated_doc.content);
                         tracing::info!("   Version after update: {}", updated_doc.sync_revision);
 
                         // Send confirmation to the sender
                         self.tx
-                            .send(ServerMessage::DocumentUpdatedResponse {
+                            .send_msg(ServerMessage::DocumentUpdatedResponse {
                                 document_id: updated_doc.id,
                                 success: true,
                                 error: None,
@@ -379,6 +420,10 @@ impl SyncHandler {
                     Err(e) => {
                         // Handle version mismatch errors specially
                         if let SyncError::VersionMismatch { expected, actual } = &e {
+                            self.app_state
+                                .metrics
+                                .conflicts_detected
+                                .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
                             tracing::warn!(
                                 "Version mismatch for document {}: expected {}, client sent {}. Another client updated first.",
                                 patch.document_id, expected, actual
@@ -392,7 +437,7 @@ impl SyncHandler {
 
                                 // Send to the client that had the conflict
                                 self.tx
-                                    .send(ServerMessage::SyncDocument {
+                                    .send_msg(ServerMessage::SyncDocument {
                                         document: current_doc.clone(),
                                     })
                                     .await?;
@@ -412,7 +457,7 @@ impl SyncHandler {
 
                         // Send error response to the sender
                         self.tx
-                            .send(ServerMessage::DocumentUpdatedResponse {
+                            .send_msg(ServerMessage::DocumentUpdatedResponse {
                                 document_id: patch.document_id,
                                 success: false,
                                 error: Some(e.to_string()),
@@ -436,11 +481,15 @@ impl SyncHandler {
                 }
 
                 // Soft delete
-                match self.db.delete_document(&document_id, &user_id).await {
+                match self
+                    .db
+                    .delete_document_with_origin(&document_id, &user_id, self.client_id)
+                    .await
+                {
                     Ok(_) => {
                         // Send confirmation to the sender
                         self.tx
-                            .send(ServerMessage::DocumentDeletedResponse {
+                            .send_msg(ServerMessage::DocumentDeletedResponse {
                                 document_id,
                                 success: true,
                                 error: None,
@@ -458,7 +507,7 @@ impl SyncHandler {
                     Err(e) => {
                         // Send error response to the sender
                         self.tx
-                            .send(ServerMessage::DocumentDeletedResponse {
+                            .send_msg(ServerMessage::DocumentDeletedResponse {
                                 document_id,
                                 success: false,
                                 error: Some(e.to_string()),
@@ -474,14 +523,14 @@ impl SyncHandler {
                     if let Ok(doc) = self.db.get_document(&doc_id).await {
                         if doc.user_id == user_id {
                             self.tx
-                                .send(ServerMessage::SyncDocument { document: doc })
+                                .send_msg(ServerMessage::SyncDocument { document: doc })
                                 .await?;
                         }
                     }
                 }
 
                 self.tx
-                    .send(ServerMessage::SyncComplete {
+                    .send_msg(ServerMessage::SyncComplete {
                         synced_count: count,
                     })
                     .await?;
@@ -490,39 +539,67 @@ impl SyncHandler {
             ClientMessage::RequestFullSync => {
                 tracing::debug!("Received RequestFullSync from user {}", user_id);
                 let documents = self.db.get_user_documents(&user_id).await?;
-                tracing::debug!("Found {} documents for user {}", documents.len(), user_id);
+                let total_count = documents.len();
+                tracing::debug!("Found {} documents for user {}", total_count, user_id);
+
+                // Partition into size-bounded batches so the client can
+                // pipeline: each SyncBatch lands in one multi-row write
+                // while the next batch is still in flight
+                const MAX_BATCH_BYTES: usize = 256 * 1024;
+                const MAX_BATCH_DOCS: usize = 500;
+
+                let mut batches: Vec<Vec<replicant_core::models::Document>> = Vec::new();
+                let mut current: Vec<replicant_core::models::Document> = Vec::new();
+                let mut current_bytes = 0usize;
+
+                for doc in documents {
+                    let doc_bytes = doc.content.to_string().len();
+                    if !current.is_empty()
+                        && (current_bytes + doc_bytes > MAX_BATCH_BYTES
+                            || current.len() >= MAX_BATCH_DOCS)
+                    {
+                        batches.push(std::mem::take(&mut current));
+                        current_bytes = 0;
+                    }
+                    current_bytes += doc_bytes;
+                    current.push(doc);
+                }
+                if !current.is_empty() {
+                    batches.push(current);
+                }
 
-                for doc in &documents {
-                    tracing::debug!("Sending SyncDocument for doc {}", doc.id);
+                let total_batches = batches.len() as u32;
+                for (batch_index, batch) in batches.into_iter().enumerate() {
                     tracing::info!(
-                        "📤 SENDING SyncDocument: {} | Title: {} | Version: {}",
-                        doc.id,
-                        doc.content
-                            .get("title")
-                            .and_then(|v| v.as_str())
-                            .unwrap_or("N/A"),
-                        doc.sync_revision
+                        "📤 SENDING SyncBatch {}/{} ({} documents) to user {}",
+                        batch_index + 1,
+                        total_batches,
+                        batch.len(),
+                        user_id
                     );
                     self.tx
-                        .send(ServerMessage::SyncDocument {
-                            document: doc.clone(),
+                        .send_msg(ServerMessage::SyncBatch {
+                            documents: batch,
+                            batch_index: batch_index as u32,
+                            total_batches,
                         })
                         .await?;
                 }
 
                 self.tx
-                    .send(ServerMessage::SyncComplete {
-                        synced_count: documents.len(),
+                    .send_msg(ServerMessage::SyncComplete {
+                        synced_count: total_count,
                     })
                     .await?;
             }
 
             ClientMessage::Ping => {
-                self.tx.send(ServerMessage::Pong).await?;
+                self.tx.send_msg(ServerMessage::Pong).await?;
             }
 
-            ClientMessage::Authenticate { .. } => {
-                // Authentication is handled in the websocket handler
+            ClientMessage::Authenticate { .. } | ClientMessage::ResumeSession { .. } => {
+                // Authentication and session resume are handled in the
+                // websocket handler
                 self.send_error(
                     ErrorCode::InvalidAuth,
                     "Authentication should be handled before this point",
@@ -530,22 +607,74 @@ impl SyncHandler {
                 .await?;
             }
 
-            ClientMessage::GetChangesSince { .. } => {
-                // TODO: Implement sequence-based sync
-                self.send_error(
-                    ErrorCode::ServerError,
-                    "Sequence-based sync not yet implemented",
-                )
-                .await?;
+            ClientMessage::GetChangesSince {
+                last_sequence,
+                limit,
+            } => {
+                // Cursors from before the compaction horizon cannot be
+                // replayed - those events are pruned. Send the current
+                // documents as a snapshot and fast-forward the client.
+                let checkpoint = self.db.get_checkpoint_sequence(&user_id).await?;
+                if last_sequence < checkpoint {
+                    let latest_sequence = self.db.get_latest_sequence(&user_id).await?;
+                    let documents = self.db.get_user_documents(&user_id).await?;
+                    tracing::info!(
+                        "User {} cursor {} is behind checkpoint {}: sending snapshot of {} documents",
+                        user_id,
+                        last_sequence,
+                        checkpoint,
+                        documents.len()
+                    );
+                    self.tx
+                        .send_msg(ServerMessage::Snapshot {
+                            documents,
+                            latest_sequence,
+                        })
+                        .await?;
+                    return Ok(());
+                }
+
+                let events = self
+                    .db
+                    .get_changes_since(&user_id, last_sequence, limit)
+                    .await?;
+                let latest_sequence = self.db.get_latest_sequence(&user_id).await?;
+                let has_more = events
+                    .last()
+                    .map(|e| e.sequence < latest_sequence)
+                    .unwrap_or(false);
+
+                tracing::info!(
+                    "User {} requested changes since {}: {} events (latest {})",
+                    user_id,
+                    last_sequence,
+                    events.len(),
+                    latest_sequence
+                );
+
+                self.tx
+                    .send_msg(ServerMessage::Changes {
+                        events,
+                        latest_sequence,
+                        has_more,
+                    })
+                    .await?;
             }
 
-            ClientMessage::AckChanges { .. } => {
-                // TODO: Implement change acknowledgment
-                self.send_error(
-                    ErrorCode::ServerError,
-                    "Change acknowledgment not yet implemented",
-                )
-                .await?;
+            ClientMessage::AckChanges { up_to_sequence } => {
+                // Record the high-water mark on the session so a later
+                // resume replays only what the client has not yet seen
+                if let Some(session_id) = self.session_id {
+                    if let Some(mut entry) = self.app_state.sessions.get_mut(&session_id) {
+                        entry.last_acked_sequence = entry.last_acked_sequence.max(up_to_sequence);
+                    }
+                }
+
+                self.tx
+                    .send_msg(ServerMessage::ChangesAcknowledged {
+                        sequence: up_to_sequence,
+                    })
+                    .await?;
             }
         }
 
@@ -554,7 +683,7 @@ impl SyncHandler {
 
     async fn send_error(&self, code: ErrorCode, message: &str) -> SyncResult<()> {
         self.tx
-            .send(ServerMessage::Error {
+            .send_msg(ServerMessage::Error {
                 code,
                 message: message.to_string(),
             })
@@ -572,88 +701,33 @@ impl SyncHandler {
         exclude_client_id: Option<Uuid>,
         message: ServerMessage,
     ) -> SyncResult<()> {
-        // Get all connected client IDs for this user
-        if let Some(client_ids) = self.app_state.user_clients.get(&user_id) {
-            let total_clients = client_ids.len();
-            let excluded = if exclude_client_id.is_some() { 1 } else { 0 };
-            tracing::info!(
-                "Broadcasting message to {}/{} clients for user {}",
-                total_clients - excluded,
-                total_clients,
-                user_id
-            );
-
-            let mut dead_clients = Vec::new();
-            let mut successful_sends = 0;
-            let mut skipped = 0;
-
-            // Send message to all clients for this user except the excluded one
-            for client_id in client_ids.iter() {
-                // Skip if this is the client to exclude
-                if let Some(exclude_id) = exclude_client_id {
-                    if *client_id == exclude_id {
-                        skipped += 1;
-                        tracing::info!(
-                            "Skipping broadcast to sender client {} for user {}",
-                            client_id,
-                            user_id
-                        );
-                        continue;
-                    }
-                }
-
-                if let Some(client_tx) = self.app_state.clients.get(&(user_id, *client_id)) {
-                    if client_tx.send(message.clone()).await.is_err() {
-                        // Client disconnected, mark for removal
-                        dead_clients.push(*client_id);
-                        tracing::warn!(
-                            "Failed to send to client {} for user {}",
-                            client_id,
-                            user_id
-                        );
-                    } else {
-                        successful_sends += 1;
-                        tracing::debug!(
-                            "Successfully sent message to client {} for user {}",
-                            client_id,
-                            user_id
-                        );
-                    }
-                } else {
-                    // Client not found in registry - this shouldn't happen
-                    dead_clients.push(*client_id);
-                    tracing::warn!(
-                        "Client {} not found in registry for user {}",
-                        client_id,
-                        user_id
-                    );
-                }
-            }
-
-            tracing::info!(
-                "Successfully sent to {}/{} clients for user {} (skipped {})",
-                successful_sends,
-                total_clients - skipped,
+        // Serialize once; every local subscriber shares the same buffers
+        let fanout_started = std::time::Instant::now();
+        let frame = BroadcastFrame::encode(&message)?;
+        let successful_sends =
+            crate::broadcast_frame_to_user(&self.app_state, user_id, exclude_client_id, &frame)
+                .await;
+        self.app_state
+            .metrics
+            .broadcast_fanout
+            .record(fanout_started.elapsed());
+        tracing::info!(
+            "Broadcast delivered to {} local clients for user {}",
+            successful_sends,
+            user_id
+        );
+
+        // Publish on the inter-node bus so subscribers connected to other
+        // nodes see the change too; a bus failure shouldn't fail the
+        // originating request
+        if let Err(e) = crate::bus::publish(&self.app_state, user_id, exclude_client_id, message)
+            .await
+        {
+            tracing::warn!(
+                "Failed to publish broadcast for user {} on change-stream bus: {}",
                 user_id,
-                skipped
+                e
             );
-
-            // Remove dead clients
-            if !dead_clients.is_empty() {
-                drop(client_ids); // Release the read lock
-                if let Some(mut client_ids_mut) = self.app_state.user_clients.get_mut(&user_id) {
-                    for dead_client_id in &dead_clients {
-                        client_ids_mut.remove(dead_client_id);
-                        self.app_state.clients.remove(&(user_id, *dead_client_id));
-                    }
-
-                    // Remove user entry if no clients left
-                    if client_ids_mut.is_empty() {
-                        drop(client_ids_mut);
-                        self.app_state.user_clients.remove(&user_id);
-                    }
-                }
-            }
         }
 
         Ok(())
@@ -1,45 +1,96 @@
-use crate::{sync_handler::SyncHandler, AppState};
+use crate::{
+    sync_handler::SyncHandler, AppState, Outbound, OutboundSender, SessionEntry, SESSION_TTL,
+};
 use axum::extract::ws::{Message, WebSocket};
 use futures_util::{SinkExt, StreamExt};
-use replicant_core::protocol::{ClientMessage, ServerMessage};
+use replicant_core::checksums::ChecksumAlgorithm;
+use replicant_core::protocol::{
+    decode_binary_message, encode_message, ClientMessage, ServerMessage, WireEncoding, WireFrame,
+};
 use std::collections::HashSet;
+use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::Arc;
 use uuid::Uuid;
 
 pub async fn handle_websocket(socket: WebSocket, state: Arc<AppState>) {
     let connection_id = Uuid::new_v4().to_string();
 
+    state
+        .metrics
+        .connections_opened
+        .fetch_add(1, Ordering::Relaxed);
+
     // Log connection if monitoring is enabled
     if let Some(ref monitoring) = state.monitoring {
-        monitoring.log_client_connected(&connection_id).await;
+        monitoring.log_client_connected(&connection_id);
     }
 
     let (mut sender, mut receiver) = socket.split();
-    let (tx, mut rx) = tokio::sync::mpsc::channel::<ServerMessage>(100);
+    let (tx, mut rx) = tokio::sync::mpsc::channel::<Outbound>(100);
+
+    // Flipped to MessagePack once the client advertises it during auth;
+    // until then (and for clients that never do) everything stays JSON
+    let use_msgpack = Arc::new(AtomicBool::new(false));
 
     // Spawn task to forward messages to WebSocket
     let monitoring_clone = state.monitoring.clone();
+    let metrics = state.metrics.clone();
     let connection_id_clone = connection_id.clone();
+    let use_msgpack_sender = use_msgpack.clone();
     tokio::spawn(async move {
         tracing::info!(
             "SERVER: WebSocket sender task started for connection {}",
             connection_id_clone
         );
-        while let Some(msg) = rx.recv().await {
-            // Log outgoing message if monitoring is enabled
-            if let Some(ref monitoring) = monitoring_clone {
-                monitoring
-                    .log_message_sent(&connection_id_clone, msg.clone())
-                    .await;
-            }
+        while let Some(out) = rx.recv().await {
+            let encoding = if use_msgpack_sender.load(Ordering::Relaxed) {
+                WireEncoding::MessagePack
+            } else {
+                WireEncoding::Json
+            };
+            let frame = match out {
+                Outbound::Message(msg) => {
+                    metrics.record_sent(&msg);
+
+                    // Show in the sampled display if monitoring is enabled
+                    if let Some(ref monitoring) = monitoring_clone {
+                        monitoring.log_message_sent(&connection_id_clone, &msg);
+                    }
 
-            tracing::info!(
-                "SERVER: Sending message to connection {}: {:?}",
-                connection_id_clone,
-                std::mem::discriminant(&msg)
-            );
-            let json = serde_json::to_string(&msg).unwrap();
-            if sender.send(Message::Text(json)).await.is_err() {
+                    tracing::info!(
+                        "SERVER: Sending message to connection {}: {:?}",
+                        connection_id_clone,
+                        std::mem::discriminant(&msg)
+                    );
+                    match encode_message(&msg, encoding) {
+                        Ok(WireFrame::Text(json)) => Message::Text(json),
+                        Ok(WireFrame::Binary(bytes)) => Message::Binary(bytes),
+                        Err(e) => {
+                            tracing::error!(
+                                "SERVER: Failed to encode message for connection {}: {}",
+                                connection_id_clone,
+                                e
+                            );
+                            continue;
+                        }
+                    }
+                }
+                // Pre-serialized broadcast: the payload is already encoded, just
+                // pick the buffer matching this connection's negotiated encoding.
+                // (Monitoring is skipped here; it operates on ServerMessage values
+                // and broadcasts are logged where they originate.)
+                Outbound::Frame(frame) => {
+                    tracing::debug!(
+                        "SERVER: Sending pre-serialized broadcast to connection {}",
+                        connection_id_clone
+                    );
+                    match encoding {
+                        WireEncoding::Json => Message::Text(frame.json.as_ref().clone()),
+                        WireEncoding::MessagePack => Message::Binary(frame.msgpack.as_ref().clone()),
+                    }
+                }
+            };
+            if sender.send(frame).await.is_err() {
                 tracing::error!(
                     "SERVER: Failed to send WebSocket message to connection {}",
                     connection_id_clone
@@ -69,14 +120,22 @@ pub async fn handle_websocket(socket: WebSocket, state: Arc<AppState>) {
 
     // Handle incoming messages
     while let Some(msg) = receiver.next().await {
-        if let Ok(Message::Text(text)) = msg {
-            match serde_json::from_str::<ClientMessage>(&text) {
+        if let Ok(msg) = msg {
+            // Frames are self-describing: text is JSON, binary is MessagePack
+            let parsed = match msg {
+                Message::Text(text) => serde_json::from_str::<ClientMessage>(&text)
+                    .map_err(|e| format!("Invalid JSON: {}", e)),
+                Message::Binary(bytes) => decode_binary_message::<ClientMessage>(&bytes)
+                    .map_err(|e| format!("Invalid MessagePack: {}", e)),
+                _ => continue,
+            };
+            match parsed {
                 Ok(client_msg) => {
-                    // Log incoming message if monitoring is enabled
+                    state.metrics.record_received(&client_msg);
+
+                    // Show in the sampled display if monitoring is enabled
                     if let Some(ref monitoring) = state.monitoring {
-                        monitoring
-                            .log_message_received(&connection_id, client_msg.clone())
-                            .await;
+                        monitoring.log_message_received(&connection_id, &client_msg);
                     }
 
                     match client_msg {
@@ -86,13 +145,15 @@ pub async fn handle_websocket(socket: WebSocket, state: Arc<AppState>) {
                             api_key,
                             signature,
                             timestamp,
+                            encodings,
+                            checksums,
                         } => {
                             // All HMAC fields required
                             let (Some(api_key), Some(signature), Some(timestamp)) =
                                 (api_key, signature, timestamp)
                             else {
                                 let _ = tx
-                                    .send(ServerMessage::AuthError {
+                                    .send_msg(ServerMessage::AuthError {
                                         reason: "Missing required authentication fields"
                                             .to_string(),
                                     })
@@ -110,7 +171,7 @@ pub async fn handle_websocket(socket: WebSocket, state: Arc<AppState>) {
                                 Err(e) => {
                                     tracing::error!("HMAC verification database error: {}", e);
                                     let _ = tx
-                                        .send(ServerMessage::AuthError {
+                                        .send_msg(ServerMessage::AuthError {
                                             reason:
                                                 "Authentication service temporarily unavailable"
                                                     .to_string(),
@@ -122,7 +183,7 @@ pub async fn handle_websocket(socket: WebSocket, state: Arc<AppState>) {
 
                             if !auth_success {
                                 let _ = tx
-                                    .send(ServerMessage::AuthError {
+                                    .send_msg(ServerMessage::AuthError {
                                         reason: "Invalid credentials".to_string(),
                                     })
                                     .await;
@@ -137,7 +198,7 @@ pub async fn handle_websocket(socket: WebSocket, state: Arc<AppState>) {
                                     Err(e) => {
                                         tracing::error!("Failed to create user: {}", e);
                                         let _ = tx
-                                            .send(ServerMessage::AuthError {
+                                            .send_msg(ServerMessage::AuthError {
                                                 reason: "Failed to create user".to_string(),
                                             })
                                             .await;
@@ -147,7 +208,7 @@ pub async fn handle_websocket(socket: WebSocket, state: Arc<AppState>) {
                                 Err(e) => {
                                     tracing::error!("Failed to query user: {}", e);
                                     let _ = tx
-                                        .send(ServerMessage::AuthError {
+                                        .send_msg(ServerMessage::AuthError {
                                             reason: "Database error".to_string(),
                                         })
                                         .await;
@@ -189,18 +250,223 @@ pub async fn handle_websocket(socket: WebSocket, state: Arc<AppState>) {
                                 client_count
                             );
 
+                            // Switch to MessagePack only if the client
+                            // advertised it; the flag flips before AuthSuccess
+                            // is queued, so the confirmation itself goes out
+                            // in the negotiated encoding
+                            let encoding = encodings
+                                .unwrap_or_default()
+                                .contains(&WireEncoding::MessagePack)
+                                .then_some(WireEncoding::MessagePack);
+                            if encoding.is_some() {
+                                use_msgpack.store(true, Ordering::Relaxed);
+                                tracing::info!(
+                                    "Connection {} negotiated MessagePack wire encoding",
+                                    connection_id
+                                );
+                            }
+
+                            // Accept fast checksums only if the client can
+                            // produce them; verification is prefix-dispatched
+                            // either way, so this just tells the client it is
+                            // safe to send them
+                            let checksum = checksums
+                                .unwrap_or_default()
+                                .contains(&ChecksumAlgorithm::Xxh3)
+                                .then_some(ChecksumAlgorithm::Xxh3);
+
+                            // Issue a resumable session token; expired
+                            // entries are pruned here so the registry cannot
+                            // grow without bound
+                            let session_id = Uuid::new_v4();
+                            state
+                                .sessions
+                                .retain(|_, entry| entry.issued_at.elapsed() < SESSION_TTL);
+                            state.sessions.insert(
+                                session_id,
+                                SessionEntry {
+                                    user_id,
+                                    client_id,
+                                    last_acked_sequence: 0,
+                                    issued_at: std::time::Instant::now(),
+                                },
+                            );
+                            handler.set_session_id(session_id);
+
+                            let _ = tx
+                                .send_msg(ServerMessage::AuthSuccess {
+                                    session_id,
+                                    client_id,
+                                    encoding,
+                                    checksum,
+                                })
+                                .await;
+                        }
+                        ClientMessage::ResumeSession {
+                            session_id,
+                            client_id,
+                            last_sequence,
+                            encodings,
+                            checksums,
+                        } => {
+                            // Validate the token issued in a previous
+                            // AuthSuccess; an expired or unknown token sends
+                            // the client back through the full handshake
+                            let resumed = state.sessions.get(&session_id).and_then(|entry| {
+                                (entry.client_id == client_id
+                                    && entry.issued_at.elapsed() < SESSION_TTL)
+                                    .then_some((entry.user_id, entry.last_acked_sequence))
+                            });
+
+                            let Some((user_id, acked_sequence)) = resumed else {
+                                let _ = tx
+                                    .send_msg(ServerMessage::AuthError {
+                                        reason: "Unknown or expired session".to_string(),
+                                    })
+                                    .await;
+                                break;
+                            };
+
+                            authenticated_user_id = Some(user_id);
+                            authenticated_client_id = Some(client_id);
+                            handler.set_user_id(user_id);
+                            handler.set_client_id(client_id);
+                            handler.set_session_id(session_id);
+
+                            // Re-register the client exactly as a fresh auth would
+                            state.clients.insert((user_id, client_id), tx.clone());
+                            state
+                                .user_clients
+                                .entry(user_id)
+                                .and_modify(|clients| {
+                                    clients.insert(client_id);
+                                })
+                                .or_insert_with(|| {
+                                    let mut set = HashSet::new();
+                                    set.insert(client_id);
+                                    set
+                                });
+
+                            let encoding = encodings
+                                .unwrap_or_default()
+                                .contains(&WireEncoding::MessagePack)
+                                .then_some(WireEncoding::MessagePack);
+                            if encoding.is_some() {
+                                use_msgpack.store(true, Ordering::Relaxed);
+                            }
+
+                            let checksum = checksums
+                                .unwrap_or_default()
+                                .contains(&ChecksumAlgorithm::Xxh3)
+                                .then_some(ChecksumAlgorithm::Xxh3);
+
                             let _ = tx
-                                .send(ServerMessage::AuthSuccess {
-                                    session_id: Uuid::new_v4(),
+                                .send_msg(ServerMessage::AuthSuccess {
+                                    session_id,
                                     client_id,
+                                    encoding,
+                                    checksum,
                                 })
                                 .await;
+
+                            // Replay the change stream immediately so sync
+                            // resumes in this same round trip. A cursor from
+                            // before the compaction horizon gets a snapshot
+                            // of the current documents instead.
+                            let since = last_sequence.max(acked_sequence);
+                            let checkpoint = state
+                                .db
+                                .get_checkpoint_sequence(&user_id)
+                                .await
+                                .unwrap_or(0);
+                            if since < checkpoint {
+                                let latest_sequence = state
+                                    .db
+                                    .get_latest_sequence(&user_id)
+                                    .await
+                                    .unwrap_or(since);
+                                match state.db.get_user_documents(&user_id).await {
+                                    Ok(documents) => {
+                                        tracing::info!(
+                                            "Resumed session {} is behind checkpoint {}: sending snapshot of {} documents",
+                                            session_id,
+                                            checkpoint,
+                                            documents.len()
+                                        );
+                                        let _ = tx
+                                            .send_msg(ServerMessage::Snapshot {
+                                                documents,
+                                                latest_sequence,
+                                            })
+                                            .await;
+                                    }
+                                    Err(e) => {
+                                        tracing::error!(
+                                            "Failed to snapshot documents for resumed session {}: {}",
+                                            session_id,
+                                            e
+                                        );
+                                    }
+                                }
+                                continue;
+                            }
+                            // Page through the backlog: each fetch is capped
+                            // (default 100 events), so keep sending batches
+                            // until the cursor catches up with the log head
+                            let mut cursor = since;
+                            loop {
+                                match state.db.get_changes_since(&user_id, cursor, None).await {
+                                    Ok(events) => {
+                                        let latest_sequence = state
+                                            .db
+                                            .get_latest_sequence(&user_id)
+                                            .await
+                                            .unwrap_or(cursor);
+                                        let last_sequence = events.last().map(|e| e.sequence);
+                                        let has_more = last_sequence
+                                            .map(|s| s < latest_sequence)
+                                            .unwrap_or(false);
+                                        tracing::info!(
+                                            "Connection {} resumed session {} for user {}: {} changes since {}{}",
+                                            connection_id,
+                                            session_id,
+                                            user_id,
+                                            events.len(),
+                                            cursor,
+                                            if has_more { " (more to follow)" } else { "" }
+                                        );
+                                        if tx
+                                            .send_msg(ServerMessage::Changes {
+                                                events,
+                                                latest_sequence,
+                                                has_more,
+                                            })
+                                            .await
+                                            .is_err()
+                                        {
+                                            break;
+                                        }
+                                        match last_sequence {
+                                            Some(s) if has_more => cursor = s,
+                                            _ => break,
+                                        }
+                                    }
+                                    Err(e) => {
+                                        tracing::error!(
+                                            "Failed to replay changes for resumed session {}: {}",
+                                            session_id,
+                                            e
+                                        );
+                                        break;
+                                    }
+                                }
+                            }
                         }
                         _ => {
                             // Require authentication first
                             if authenticated_user_id.is_none() {
                                 let _ = tx
-                                    .send(ServerMessage::AuthError {
+                                    .send_msg(ServerMessage::AuthError {
                                         reason: "Not authenticated".to_string(),
                                     })
                                     .await;
@@ -211,15 +477,13 @@ pub async fn handle_websocket(socket: WebSocket, state: Arc<AppState>) {
                             if let Err(e) = handler.handle_message(client_msg).await {
                                 tracing::error!("Error handling message: {}", e);
                                 let _ = tx
-                                    .send(ServerMessage::Error {
+                                    .send_msg(ServerMessage::Error {
                                         code: replicant_core::protocol::ErrorCode::ServerError,
                                         message: format!("Failed to process message: {}", e),
                                     })
                                     .await;
                                 if let Some(ref monitoring) = state.monitoring {
-                                    monitoring
-                                        .log_error(format!("Error handling message: {}", e))
-                                        .await;
+                                    monitoring.log_error(format!("Error handling message: {}", e));
                                 }
                             }
                         }
@@ -228,9 +492,9 @@ pub async fn handle_websocket(socket: WebSocket, state: Arc<AppState>) {
                 Err(e) => {
                     tracing::error!("Failed to parse client message: {}", e);
                     let _ = tx
-                        .send(ServerMessage::Error {
+                        .send_msg(ServerMessage::Error {
                             code: replicant_core::protocol::ErrorCode::InvalidMessage,
-                            message: format!("Invalid JSON: {}", e),
+                            message: e,
                         })
                         .await;
                 }
@@ -260,8 +524,13 @@ pub async fn handle_websocket(socket: WebSocket, state: Arc<AppState>) {
         }
     }
 
+    state
+        .metrics
+        .connections_closed
+        .fetch_add(1, Ordering::Relaxed);
+
     // Log disconnection if monitoring is enabled
     if let Some(ref monitoring) = state.monitoring {
-        monitoring.log_client_disconnected(&connection_id).await;
+        monitoring.log_client_disconnected(&connection_id);
     }
 }
@@ -280,6 +280,8 @@ impl TestContext {
             api_key: Some(api_key.clone()),
             signature: Some(signature),
             timestamp: Some(now),
+            encodings: None,
+            checksums: None,
         };
         let json_msg = serde_json::to_string(&auth_msg).unwrap();
         ws.send(Message::Text(json_msg)).await.unwrap();
@@ -85,6 +85,8 @@ crate::integration_test!(
             api_key: Some(api_key.clone()),
             signature: Some(signature),
             timestamp: Some(now),
+            encodings: None,
+            checksums: None,
         };
         let json_msg = serde_json::to_string(&auth_msg).unwrap();
         ws.send(Message::Text(json_msg)).await.unwrap();
@@ -100,6 +102,8 @@ crate::integration_test!(
                 ServerMessage::AuthSuccess {
                     session_id,
                     client_id: _,
+                    encoding: _,
+                    checksum: _,
                 } => {
                     assert!(!session_id.is_nil());
                 }
@@ -122,6 +126,8 @@ crate::integration_test!(
             api_key: Some(api_key.clone()),
             signature: Some(signature),
             timestamp: Some(now),
+            encodings: None,
+            checksums: None,
         };
         ws.send(Message::Text(serde_json::to_string(&bad_auth_msg).unwrap()))
             .await
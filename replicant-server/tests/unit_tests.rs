@@ -372,6 +372,7 @@ mod database_tests {
                 forward_patch: Some(&server_content_json),
                 reverse_patch: None,
                 applied: false,
+                origin_client_id: None,
             },
         )
         .await
@@ -477,6 +478,7 @@ mod database_tests {
                 forward_patch: Some(&server_content_json),
                 reverse_patch: None,
                 applied: false,
+                origin_client_id: None,
             },
         )
         .await
@@ -570,6 +572,7 @@ mod database_tests {
                     forward_patch: Some(&conflict_json),
                     reverse_patch: None,
                     applied: false,
+                    origin_client_id: None,
                 },
             )
             .await
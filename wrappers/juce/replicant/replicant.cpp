@@ -20,12 +20,21 @@ Replicant::Replicant(const std::string& databaseUrl,
     client.register_document_callback(documentCallback, this);
     client.register_connection_callback(connectionCallback, this);
     client.register_error_callback(errorCallback, this);
-    startTimerHz(10);
+
+    // Wake-on-event delivery: the engine pings eventNotifier whenever the
+    // event queue becomes non-empty, and we drain on the next message-loop
+    // hop - no polling when idle, no fixed timer latency.
+    client.set_event_notifier(eventNotifier, this);
+
+    // Drain anything queued between construction and notifier installation
+    triggerAsyncUpdate();
 }
 
 Replicant::~Replicant()
 {
-    stopTimer();
+    // Stop the engine waking us, then drop any update already scheduled
+    client.set_event_notifier(nullptr, nullptr);
+    cancelPendingUpdate();
 
     // Clear callbacks to prevent any queued events from calling into dead lambdas
     onDocumentCreated = nullptr;
@@ -36,11 +45,18 @@ Replicant::~Replicant()
 }
 
 //==============================================================================
-void Replicant::timerCallback()
+void Replicant::handleAsyncUpdate()
 {
     client.process_events();
 }
 
+void Replicant::eventNotifier(void* context)
+{
+    // Called from the engine's sync threads; triggerAsyncUpdate is
+    // thread-safe and coalesces repeated wake-ups into one update
+    static_cast<Replicant*>(context)->triggerAsyncUpdate();
+}
+
 //==============================================================================
 void Replicant::documentCallback(EventType eventType, const char* docId,
                                  const char* title, const char* content, void* context)
@@ -47,8 +47,10 @@ namespace replicant
     A sync client that provides offline-first document synchronization.
 
     This class wraps the replicant library and integrates with JUCE's
-    event system via Timer. Events are processed on the message thread
-    at 10Hz, making it safe to update UI directly from callbacks.
+    event system via AsyncUpdater. The engine signals when events become
+    available and they are drained on the next message-loop hop, making
+    it safe to update UI directly from callbacks - with no polling cost
+    when idle and no fixed timer latency.
 
     Example usage:
     @code
@@ -64,7 +66,7 @@ namespace replicant
     };
     @endcode
 */
-class Replicant : private juce::Timer
+class Replicant : private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -178,8 +180,9 @@ public:
     std::function<void(const std::string& message)> onSyncError;
 
 private:
-    void timerCallback() override;
+    void handleAsyncUpdate() override;
 
+    static void eventNotifier(void* context);
     static void documentCallback(EventType eventType, const char* docId,
                                   const char* title, const char* content, void* context);
     static void connectionCallback(EventType eventType, bool isConnected,